@@ -108,6 +108,106 @@ tt_void_t demo_circular_buffer_write_cover(tt_void_t)
 	tt_circular_buffer_exit(&s_cb);
 }
 
+tt_void_t demo_circular_buffer_zero_copy(tt_void_t)
+{
+	tt_circular_buffer_region_t regions[2];
+	tt_size_t i = 0, n = 0;
+
+	memset(buffer, 0, sizeof(buffer));
+
+	tt_circular_buffer_init(&s_cb, buffer, sizeof(buffer));
+	tt_circular_buffer_writ(&s_cb, in, 6);
+	tt_circular_buffer_read(&s_cb, out, 6);
+
+	/// serialize into the ring directly, it is split into two regions at the end
+	n = tt_circular_buffer_writ_reserve(&s_cb, 5, regions);
+	for (i = 0; i < n; i++) memset(regions[i].data, 'a' + (tt_int_t)i, regions[i].size);
+	tt_circular_buffer_writ_commit(&s_cb, 5);
+
+	/// parse in place
+	n = tt_circular_buffer_read_peek(&s_cb, sizeof(buffer), regions);
+	for (i = 0; i < n; i++) tt_trace_d("region[%lu]: %.*s", i, (tt_int_t)regions[i].size, regions[i].data);
+	tt_circular_buffer_read_consume(&s_cb, 5);
+
+	tt_circular_buffer_exit(&s_cb);
+}
+
+tt_void_t demo_circular_buffer_mirror(tt_void_t)
+{
+	tt_circular_buffer_t        cb;
+	tt_circular_buffer_region_t regions[2];
+	tt_size_t                   n = 0;
+	tt_size_t                   size = tt_vmem_page_size();
+
+	if (!tt_circular_buffer_init_mirror(&cb, size)) return;
+
+	/// the record straddles the end of the buffer
+	tt_circular_buffer_writ(&cb, in, 6);
+	tt_circular_buffer_read(&cb, out, 6);
+	cb.w_idx = cb.r_idx = size - 3;
+	tt_circular_buffer_writ(&cb, in, 6);
+
+	/// it is still one region
+	n = tt_circular_buffer_read_peek(&cb, 6, regions);
+	tt_trace_d("mirror: %s, regions: %lu, %.*s", cb.mode == TT_CIRCULAR_BUFFER_MODE_MIRROR ? "yes" : "no", n, (tt_int_t)regions[0].size, regions[0].data);
+	tt_circular_buffer_read_consume(&cb, 6);
+
+	tt_circular_buffer_exit(&cb);
+
+	/// the size is not aligned by the page size, fall back to the split ring
+	if (!tt_circular_buffer_init_mirror(&cb, 100)) return;
+	tt_trace_d("mirror: %s", cb.mode == TT_CIRCULAR_BUFFER_MODE_MIRROR ? "yes" : "no");
+	tt_circular_buffer_exit(&cb);
+}
+
+#define SPSC_FRAME_SIZE  64
+#define SPSC_FRAME_COUNT 1000000
+
+static tt_circular_buffer_spsc_t s_spsc;
+
+static tt_int_t demo_circular_buffer_spsc_producer(tt_cpointer_t priv)
+{
+	tt_byte_t frame[SPSC_FRAME_SIZE] = {0};
+	tt_size_t i = 0;
+	for (i = 0; i < SPSC_FRAME_COUNT; i++)
+	{
+		/// the sequence of this frame
+		memcpy(frame, &i, sizeof(i));
+		tt_circular_buffer_spsc_writ_wait(&s_spsc, frame, sizeof(frame), -1);
+	}
+	return 0;
+}
+
+tt_void_t demo_circular_buffer_spsc(tt_void_t)
+{
+	tt_byte_t frame[SPSC_FRAME_SIZE];
+	tt_size_t i = 0, seq = 0, errors = 0;
+	tt_hong_t t = tt_mclock();
+
+	tt_circular_buffer_spsc_init_mirror(&s_spsc, SPSC_FRAME_SIZE * 256);
+
+	/// wait the empty buffer with the timeout
+	tt_uint64_t read_size = tt_circular_buffer_spsc_read_wait(&s_spsc, frame, sizeof(frame), 10);
+	tt_trace_d("spsc: read wait %llu bytes, %lld ms", read_size, tt_mclock() - t);
+
+	t = tt_mclock();
+	tt_thread_ref_t thread = tt_thread_init("producer", demo_circular_buffer_spsc_producer, tt_null, 0);
+	tt_assert_and_check_return(thread);
+
+	/// the frames are written as a whole, so they are read as a whole too
+	for (i = 0; i < SPSC_FRAME_COUNT; i++)
+	{
+		tt_circular_buffer_spsc_read_wait(&s_spsc, frame, sizeof(frame), -1);
+		memcpy(&seq, frame, sizeof(seq));
+		if (seq != i) errors++;
+	}
+	tt_trace_d("spsc: %lu frames, errors: %lu, %lld ms", i, errors, tt_mclock() - t);
+
+	tt_thread_wait(thread, -1, tt_null);
+	tt_thread_exit(thread);
+	tt_circular_buffer_spsc_exit(&s_spsc);
+}
+
 tt_void_t tt_demo_circular_buffer_main(tt_void_t)
 {
 	// print title
@@ -118,5 +218,8 @@ tt_void_t tt_demo_circular_buffer_main(tt_void_t)
 	demo_circular_buffer_writ_slow();
 	demo_circular_buffer_read_slow();
 	demo_circular_buffer_write_cover();
+	demo_circular_buffer_zero_copy();
+	demo_circular_buffer_mirror();
+	demo_circular_buffer_spsc();
 
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_RECORD_RING"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the message count
+#define TT_DEMO_RECORD_RING_COUNT           (1000000)
+
+// the batch count
+#define TT_DEMO_RECORD_RING_BATCH           (32)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo context type
+typedef struct __tt_demo_record_ring_t
+{
+    // the ring
+    tt_record_ring_t    ring;
+
+    // the next sequence of the consumer
+    tt_size_t           seq;
+
+    // the error count
+    tt_size_t           errors;
+
+}tt_demo_record_ring_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// the message is 32 - 256 bytes, the first bytes are the sequence
+static tt_size_t tt_demo_record_ring_make(tt_byte_t* data, tt_size_t seq)
+{
+    tt_size_t size = 32 + (seq * 7) % 225;
+    tt_memset(data, (tt_byte_t)seq, size);
+    tt_memcpy(data, &seq, sizeof(seq));
+    return size;
+}
+
+static tt_void_t tt_demo_record_ring_check(tt_byte_t const* data, tt_size_t size, tt_cpointer_t priv)
+{
+    tt_demo_record_ring_t* demo = (tt_demo_record_ring_t*)priv;
+
+    tt_size_t seq = 0;
+    tt_memcpy(&seq, data, sizeof(seq));
+    if (seq != demo->seq || size != 32 + (seq * 7) % 225 || data[size - 1] != (tt_byte_t)seq) demo->errors++;
+    demo->seq++;
+}
+
+static tt_int_t tt_demo_record_ring_producer(tt_cpointer_t priv)
+{
+    tt_demo_record_ring_t* demo = (tt_demo_record_ring_t*)priv;
+
+    tt_byte_t        messages[TT_DEMO_RECORD_RING_BATCH][256];
+    tt_byte_t const* datas[TT_DEMO_RECORD_RING_BATCH];
+    tt_size_t        sizes[TT_DEMO_RECORD_RING_BATCH];
+    tt_size_t        seq = 0;
+    tt_size_t        i = 0;
+    while (seq < TT_DEMO_RECORD_RING_COUNT)
+    {
+        // make a batch
+        tt_size_t n = tt_min(TT_DEMO_RECORD_RING_BATCH, TT_DEMO_RECORD_RING_COUNT - seq);
+        for (i = 0; i < n; i++)
+        {
+            sizes[i] = tt_demo_record_ring_make(messages[i], seq + i);
+            datas[i] = messages[i];
+        }
+
+        // push the batch
+        for (i = 0; i < n; )
+        {
+            tt_size_t pushed = tt_record_ring_push_n(&demo->ring, datas + i, sizes + i, n - i);
+            if (!pushed) tt_usleep(0);
+            i += pushed;
+        }
+        seq += n;
+    }
+    return 0;
+}
+
+static tt_void_t tt_demo_record_ring_perf(tt_size_t size)
+{
+    tt_demo_record_ring_t demo = {0};
+    if (!tt_record_ring_init(&demo.ring, size)) return;
+
+    tt_hong_t       t = tt_mclock();
+    tt_thread_ref_t thread = tt_thread_init("producer", tt_demo_record_ring_producer, &demo, 0);
+    if (thread)
+    {
+        while (demo.seq < TT_DEMO_RECORD_RING_COUNT)
+        {
+            if (!tt_record_ring_pop_n(&demo.ring, tt_demo_record_ring_check, &demo, TT_DEMO_RECORD_RING_BATCH)) tt_usleep(0);
+        }
+        tt_thread_wait(thread, -1, tt_null);
+        tt_thread_exit(thread);
+    }
+    tt_trace_d("size: %lu, mirror: %d, messages: %lu, errors: %lu, %lld ms"
+                , size, demo.ring.buff.mode == TT_CIRCULAR_BUFFER_MODE_MIRROR, demo.seq, demo.errors, tt_mclock() - t);
+
+    tt_record_ring_exit(&demo.ring);
+}
+
+static tt_void_t tt_demo_record_ring_base(tt_void_t)
+{
+    tt_record_ring_t ring;
+    tt_byte_t        data[64];
+    tt_size_t        i = 0;
+    if (!tt_record_ring_init(&ring, 64)) return;
+
+    // the record is written at the head after the padding record
+    tt_size_t size = 0;
+    for (i = 0; i < 4; i++)
+    {
+        tt_record_ring_push(&ring, (tt_byte_t const*)"hello record ring", 18);
+        tt_long_t ok = tt_record_ring_pop(&ring, data, sizeof(data), &size);
+        tt_trace_d("pop: %ld, %lu, %s", ok, size, ok > 0? (tt_char_t const*)data : "");
+    }
+
+    // the buffer is too small, the record is kept
+    tt_record_ring_push(&ring, (tt_byte_t const*)"hello record ring", 18);
+    tt_long_t ok = tt_record_ring_pop(&ring, data, 4, &size);
+    tt_trace_d("pop: %ld, required: %lu", ok, size);
+    ok = tt_record_ring_pop(&ring, data, size, &size);
+    tt_trace_d("pop: %ld, %lu, %s", ok, size, ok > 0? (tt_char_t const*)data : "");
+
+    // the empty payload and the empty ring
+    tt_record_ring_push(&ring, tt_null, 0);
+    ok = tt_record_ring_pop(&ring, data, sizeof(data), &size);
+    tt_trace_d("pop: %ld, %lu", ok, size);
+    ok = tt_record_ring_pop(&ring, data, sizeof(data), &size);
+    tt_trace_d("pop: %ld", ok);
+
+    tt_record_ring_exit(&ring);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_record_ring_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo record ring");
+
+    tt_demo_record_ring_base();
+    tt_demo_record_ring_perf(10000);
+    tt_demo_record_ring_perf(65536);
+
+    return 0;
+}
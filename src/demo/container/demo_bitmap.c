@@ -0,0 +1,96 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_BITMAP"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_bitmap_base(tt_void_t)
+{
+    tt_bitmap_ref_t bitmap = tt_bitmap_init(200);
+    tt_bitmap_ref_t other = tt_bitmap_init(200);
+    tt_assert_and_check_return(bitmap && other);
+
+    tt_bitmap_set(bitmap, 3);
+    tt_bitmap_set_range(bitmap, 60, 80);
+    tt_trace_d("test 3: %d, test 4: %d, test [60, 140): %d, test [59, 140): %d", tt_bitmap_test(bitmap, 3), tt_bitmap_test(bitmap, 4), tt_bitmap_test_range(bitmap, 60, 80), tt_bitmap_test_range(bitmap, 59, 81));
+    tt_trace_d("count: %lu, count [100, 200): %lu", tt_bitmap_count(bitmap), tt_bitmap_count_range(bitmap, 100, 100));
+    tt_trace_d("find set from 4: %lu, find reset from 60: %lu", tt_bitmap_find_set(bitmap, 4), tt_bitmap_find_reset(bitmap, 60));
+
+    // [60, 140) & ~[100, 200)
+    tt_bitmap_set_range(other, 100, 100);
+    tt_bitmap_andnot(bitmap, other);
+    tt_trace_d("andnot: count: %lu, find reset from 60: %lu", tt_bitmap_count(bitmap), tt_bitmap_find_reset(bitmap, 60));
+
+    // [100, 200) ^ [0, 200)
+    tt_bitmap_clear(bitmap);
+    tt_bitmap_set_range(bitmap, 0, 200);
+    tt_bitmap_xor(bitmap, other);
+    tt_trace_d("xor: count: %lu, find reset: %lu", tt_bitmap_count(bitmap), tt_bitmap_find_reset(bitmap, 0));
+
+    // grow
+    tt_bitmap_resize(bitmap, 1000);
+    tt_trace_d("resize: size: %lu, count: %lu, find reset from 100: %lu", tt_bitmap_size(bitmap), tt_bitmap_count(bitmap), tt_bitmap_find_reset(bitmap, 100));
+
+    tt_bitmap_exit(other);
+    tt_bitmap_exit(bitmap);
+}
+
+static tt_void_t tt_demo_bitmap_perf(tt_size_t n)
+{
+    tt_bitmap_ref_t bitmap = tt_bitmap_init(n);
+    tt_bitmap_ref_t other = tt_bitmap_init(n);
+    tt_assert_and_check_return(bitmap && other);
+
+    // allocate all slots
+    tt_size_t i = 0;
+    tt_size_t pos = 0;
+    tt_hong_t t = tt_mclock();
+    for (i = 0; i < n; i++)
+    {
+        pos = tt_bitmap_find_reset(bitmap, pos);
+        if (pos == TT_BITMAP_NONE) break;
+        tt_bitmap_set(bitmap, pos);
+    }
+    tt_hong_t ta = tt_mclock() - t;
+
+    // free the slots sparsely and count them
+    for (i = 0; i < n; i += 7) tt_bitmap_reset(bitmap, i);
+    t = tt_mclock();
+    tt_size_t count = tt_bitmap_count(bitmap);
+    tt_hong_t tc = tt_mclock() - t;
+
+    // and the membership
+    tt_bitmap_set_range(other, n / 4, n / 2);
+    t = tt_mclock();
+    tt_bitmap_and(bitmap, other);
+    tt_hong_t tn = tt_mclock() - t;
+
+    tt_trace_d("n: %lu, count: %lu, and: %lu", n, count, tt_bitmap_count(bitmap));
+    tt_trace_d("alloc: %lld ms, count: %lld ms, and: %lld ms", ta, tc, tn);
+
+    tt_bitmap_exit(other);
+    tt_bitmap_exit(bitmap);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_bitmap_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo bitmap");
+
+    tt_demo_bitmap_base();
+    tt_demo_bitmap_perf(10000000);
+
+    return 0;
+}
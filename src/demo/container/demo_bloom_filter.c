@@ -0,0 +1,69 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_BLOOM_FILTER"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the key count
+#define TT_DEMO_BLOOM_FILTER_MAXN       (100000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_bloom_filter_probability(tt_size_t probability)
+{
+    // init keys
+    tt_char_t*      keys = (tt_char_t*)tt_malloc0(TT_DEMO_BLOOM_FILTER_MAXN * 16);
+    tt_cpointer_t*  datas = (tt_cpointer_t*)tt_nalloc0(sizeof(tt_cpointer_t), TT_DEMO_BLOOM_FILTER_MAXN);
+    tt_bool_t*      results = (tt_bool_t*)tt_nalloc0(sizeof(tt_bool_t), TT_DEMO_BLOOM_FILTER_MAXN);
+    tt_bloom_filter_ref_t filter = tt_bloom_filter_init(probability, TT_DEMO_BLOOM_FILTER_MAXN, tt_element_str(tt_true));
+    if (keys && datas && results && filter)
+    {
+        // add the present keys
+        tt_size_t i = 0;
+        for (i = 0; i < TT_DEMO_BLOOM_FILTER_MAXN; i++)
+        {
+            snprintf(keys + i * 16, 16, "key_%lu", i);
+            datas[i] = keys + i * 16;
+        }
+        tt_hong_t t = tt_mclock();
+        tt_size_t added = tt_bloom_filter_nadd(filter, datas, TT_DEMO_BLOOM_FILTER_MAXN);
+        t = tt_mclock() - t;
+
+        // test the absent keys
+        for (i = 0; i < TT_DEMO_BLOOM_FILTER_MAXN; i++) snprintf(keys + i * 16, 16, "absent_%lu", i);
+        tt_size_t positive = tt_bloom_filter_ntest(filter, datas, TT_DEMO_BLOOM_FILTER_MAXN, results);
+
+        tt_trace_d("p: 1/2^%lu, bits: %lu, added: %lu, false positive: %lu / %lu, add time: %lld ms", probability, tt_bloom_filter_maxn(filter), added, positive, (tt_size_t)TT_DEMO_BLOOM_FILTER_MAXN, t);
+    }
+
+    if (filter) tt_bloom_filter_exit(filter);
+    if (results) tt_free(results);
+    if (datas) tt_free(datas);
+    if (keys) tt_free(keys);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_bloom_filter_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo bloom filter");
+
+    tt_demo_bloom_filter_probability(TT_BLOOM_FILTER_PROBABILITY_0_1);
+    tt_demo_bloom_filter_probability(TT_BLOOM_FILTER_PROBABILITY_0_01);
+    tt_demo_bloom_filter_probability(TT_BLOOM_FILTER_PROBABILITY_0_001);
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_BPLUS_TREE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_bplus_tree_str(tt_void_t)
+{
+    tt_bplus_tree_ref_t tree = tt_bplus_tree_init(TT_BPLUS_TREE_NODE_SIZE_SMALL, tt_element_str(tt_true), tt_element_str(tt_true));
+    tt_assert_and_check_return(tree);
+
+    tt_bplus_tree_insert(tree, "dog", "wang");
+    tt_bplus_tree_insert(tree, "cat", "miao");
+    tt_bplus_tree_insert(tree, "cow", "mou");
+    tt_bplus_tree_insert(tree, "duck", "ga");
+    tt_bplus_tree_insert(tree, "bird", "ji");
+    tt_bplus_tree_insert(tree, "cat", "meow");
+    tt_trace_d("get cat: %s", tt_bplus_tree_get(tree, "cat"));
+
+    // walk all items in the key order
+    tt_for_all(tt_bplus_tree_item_ref_t, item, tree)
+    {
+        tt_trace_d("%s => %s", item->key, item->data);
+    }
+
+    // walk the range [c, d) reversely
+    tt_size_t head = tt_bplus_tree_lower_bound(tree, "c");
+    tt_size_t itor = tt_bplus_tree_lower_bound(tree, "d");
+    while (itor != head)
+    {
+        itor = tt_iterator_prev(tree, itor);
+        tt_bplus_tree_item_ref_t item = (tt_bplus_tree_item_ref_t)tt_iterator_item(tree, itor);
+        tt_trace_d("range: %s => %s", item->key, item->data);
+    }
+
+    tt_bplus_tree_remove(tree, "cow");
+    tt_trace_d("size: %lu, height: %lu", tt_bplus_tree_size(tree), tt_bplus_tree_height(tree));
+
+    tt_bplus_tree_exit(tree);
+}
+
+static tt_void_t tt_demo_bplus_tree_perf(tt_size_t n)
+{
+    tt_bplus_tree_ref_t tree = tt_bplus_tree_init(TT_BPLUS_TREE_NODE_SIZE_DEFAULT, tt_element_str(tt_true), tt_element_uint8());
+    tt_assert_and_check_return(tree);
+
+    // insert the keys randomly
+    tt_char_t name[32];
+    tt_size_t i = 0;
+    tt_hong_t t = tt_mclock();
+    for (i = 0; i < n; i++)
+    {
+        snprintf(name, sizeof(name), "key_%08lu", (i * 2654435761u) % n);
+        tt_bplus_tree_insert(tree, name, tt_u2p(i & 0xff));
+    }
+    tt_hong_t ti = tt_mclock() - t;
+
+    // find the keys
+    tt_size_t found = 0;
+    t = tt_mclock();
+    for (i = 0; i < n; i++)
+    {
+        snprintf(name, sizeof(name), "key_%08lu", i);
+        if (tt_bplus_tree_find(tree, name) != tt_iterator_tail(tree)) found++;
+    }
+    tt_hong_t tf = tt_mclock() - t;
+
+    // walk the keys, they are in order
+    tt_size_t        count = 0;
+    tt_size_t        errors = 0;
+    tt_char_t const* prev = tt_null;
+    t = tt_mclock();
+    tt_for_all(tt_bplus_tree_item_ref_t, item, tree)
+    {
+        if (prev && tt_strcmp(prev, (tt_char_t const*)item->key) >= 0) errors++;
+        prev = (tt_char_t const*)item->key;
+        count++;
+    }
+    tt_hong_t tw = tt_mclock() - t;
+
+    tt_trace_d("n: %lu, size: %lu, height: %lu, found: %lu, walked: %lu, errors: %lu", n, tt_bplus_tree_size(tree), tt_bplus_tree_height(tree), found, count, errors);
+    tt_trace_d("insert: %lld ms, find: %lld ms, walk: %lld ms", ti, tf, tw);
+
+    tt_bplus_tree_exit(tree);
+}
+
+static tt_void_t tt_demo_bplus_tree_load(tt_size_t n)
+{
+    tt_bplus_tree_ref_t tree = tt_bplus_tree_init(TT_BPLUS_TREE_NODE_SIZE_PAGE, tt_element_str(tt_true), tt_element_uint8());
+    tt_cpointer_t* keys = (tt_cpointer_t*)tt_nalloc0(sizeof(tt_cpointer_t), n);
+    tt_cpointer_t* datas = (tt_cpointer_t*)tt_nalloc0(sizeof(tt_cpointer_t), n);
+    tt_char_t*     names = (tt_char_t*)tt_nalloc0(32, n);
+    do
+    {
+        tt_assert_and_check_break(tree && keys && datas && names);
+
+        // the sorted input
+        tt_size_t i = 0;
+        for (i = 0; i < n; i++)
+        {
+            snprintf(names + i * 32, 32, "key_%08lu", i);
+            keys[i]  = names + i * 32;
+            datas[i] = tt_u2p(i & 0xff);
+        }
+
+        tt_hong_t t = tt_mclock();
+        tt_bool_t ok = tt_bplus_tree_load(tree, keys, datas, n);
+        t = tt_mclock() - t;
+        tt_trace_d("load: %s, n: %lu, size: %lu, height: %lu, time: %lld ms", ok ? "ok" : "failed", n, tt_bplus_tree_size(tree), tt_bplus_tree_height(tree), t);
+
+        // walk the range [key_00000100, key_00000105]
+        tt_size_t itor = tt_bplus_tree_lower_bound(tree, "key_00000100");
+        tt_size_t tail = tt_bplus_tree_upper_bound(tree, "key_00000105");
+        for (; itor != tail; itor = tt_iterator_next(tree, itor))
+        {
+            tt_bplus_tree_item_ref_t item = (tt_bplus_tree_item_ref_t)tt_iterator_item(tree, itor);
+            tt_trace_d("range: %s => %u", item->key, tt_p2u8(item->data));
+        }
+
+    } while (0);
+
+    if (tree) tt_bplus_tree_exit(tree);
+    if (keys) tt_free(keys);
+    if (datas) tt_free(datas);
+    if (names) tt_free(names);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_bplus_tree_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo bplus tree");
+
+    tt_demo_bplus_tree_str();
+    tt_demo_bplus_tree_perf(1000000);
+    tt_demo_bplus_tree_load(1000000);
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_DEQUE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_deque_str(tt_void_t)
+{
+    tt_deque_ref_t deque = tt_deque_init(0, tt_element_str(tt_true));
+    tt_assert_and_check_return(deque);
+
+    // insert
+    tt_deque_insert_tail(deque, "two");
+    tt_deque_insert_tail(deque, "three");
+    tt_deque_insert_head(deque, "one");
+    tt_deque_insert_head(deque, "zero");
+
+    // walk
+    tt_for_all(tt_char_t const*, item, deque)
+    {
+        tt_trace_d("%s", item);
+    }
+
+    // remove
+    tt_deque_remove_head(deque);
+    tt_deque_remove_last(deque);
+    tt_trace_d("size: %lu, head: %s, last: %s, item[1]: %s", tt_deque_size(deque), tt_deque_head(deque), tt_deque_last(deque), tt_iterator_item(deque, 1));
+
+    tt_deque_exit(deque);
+}
+
+static tt_void_t tt_demo_deque_perf(tt_size_t n)
+{
+    tt_deque_ref_t  deque = tt_deque_init(0, tt_element_uint8());
+    tt_vector_ref_t vector = tt_vector_init(0, tt_element_uint8());
+    if (deque && vector)
+    {
+        // insert head and remove head by the deque
+        tt_size_t i = 0;
+        tt_hong_t t = tt_mclock();
+        for (i = 0; i < n; i++) tt_deque_insert_head(deque, tt_u2p(i));
+        for (i = 0; i < n; i++) tt_deque_remove_head(deque);
+        t = tt_mclock() - t;
+        tt_trace_d("deque:  insert and remove head: %lu, time: %lld ms, maxn: %lu", n, t, tt_deque_maxn(deque));
+
+        // insert head and remove head by the vector
+        t = tt_mclock();
+        for (i = 0; i < n; i++) tt_vector_insert_head(vector, tt_u2p(i));
+        for (i = 0; i < n; i++) tt_vector_remove_head(vector);
+        t = tt_mclock() - t;
+        tt_trace_d("vector: insert and remove head: %lu, time: %lld ms", n, t);
+    }
+
+    if (deque) tt_deque_exit(deque);
+    if (vector) tt_vector_exit(vector);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_deque_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo deque");
+
+    tt_demo_deque_str();
+    tt_demo_deque_perf(50000);
+
+    return 0;
+}
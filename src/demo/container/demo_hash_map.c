@@ -0,0 +1,92 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_HASH_MAP"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_hash_map_str(tt_void_t)
+{
+    tt_hash_map_ref_t hash_map = tt_hash_map_init(8, tt_element_str(tt_true), tt_element_uint8());
+    tt_assert_and_check_return(hash_map);
+
+    // insert
+    tt_hash_map_insert(hash_map, "one", tt_u2p(1));
+    tt_hash_map_insert(hash_map, "two", tt_u2p(2));
+    tt_hash_map_insert(hash_map, "three", tt_u2p(3));
+    tt_hash_map_insert(hash_map, "two", tt_u2p(22));
+
+    // get
+    tt_trace_d("one: %u, two: %u, four: %p", tt_p2u8(tt_hash_map_get(hash_map, "one")), tt_p2u8(tt_hash_map_get(hash_map, "two")), tt_hash_map_get(hash_map, "four"));
+
+    // walk
+    tt_for_all(tt_hash_map_item_ref_t, item, hash_map)
+    {
+        tt_trace_d("%s: %u", (tt_char_t const*)item->name, tt_p2u8(item->data));
+    }
+
+    // remove
+    tt_hash_map_remove(hash_map, "one");
+    tt_trace_d("size: %lu, one: %lu, tail: %lu", tt_hash_map_size(hash_map), tt_hash_map_find(hash_map, "one"), tt_iterator_tail(hash_map));
+
+    tt_hash_map_exit(hash_map);
+}
+
+static tt_void_t tt_demo_hash_map_perf(tt_void_t)
+{
+    tt_hash_map_ref_t hash_map = tt_hash_map_init(0, tt_element_str(tt_true), tt_element_uint8());
+    tt_assert_and_check_return(hash_map);
+
+    // insert
+    tt_char_t name[32];
+    tt_size_t i = 0;
+    tt_size_t n = 100000;
+    tt_hong_t t = tt_mclock();
+    for (i = 0; i < n; i++)
+    {
+        snprintf(name, sizeof(name), "key_%lu", i);
+        tt_hash_map_insert(hash_map, name, tt_u2p(i));
+    }
+
+    // find
+    tt_size_t found = 0;
+    for (i = 0; i < n; i++)
+    {
+        snprintf(name, sizeof(name), "key_%lu", i);
+        if (tt_hash_map_find(hash_map, name) != tt_iterator_tail(hash_map)) found++;
+    }
+
+    // remove the half
+    for (i = 0; i < n; i += 2)
+    {
+        snprintf(name, sizeof(name), "key_%lu", i);
+        tt_hash_map_remove(hash_map, name);
+    }
+    t = tt_mclock() - t;
+
+    tt_trace_d("found: %lu, size: %lu, maxn: %lu, time: %lld ms", found, tt_hash_map_size(hash_map), tt_hash_map_maxn(hash_map), t);
+
+    tt_hash_map_exit(hash_map);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_hash_map_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo hash map");
+
+    tt_demo_hash_map_str();
+    tt_demo_hash_map_perf();
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_HEAP"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_heap_str(tt_void_t)
+{
+    tt_heap_ref_t heap = tt_heap_init(0, TT_HEAP_ARITY_QUATERNARY, tt_element_str(tt_true));
+    tt_assert_and_check_return(heap);
+
+    // push the tasks by deadline
+    tt_heap_push(heap, "09:00 backup");
+    tt_size_t report = tt_heap_push(heap, "17:00 report");
+    tt_heap_push(heap, "12:00 lunch");
+    tt_size_t deploy = tt_heap_push(heap, "15:00 deploy");
+
+    // decrease-key: the report is due earlier, the deploy is cancelled
+    tt_heap_replace(heap, report, "08:00 report");
+    tt_heap_remove(heap, deploy);
+
+    // pop by deadline
+    while (tt_heap_size(heap))
+    {
+        tt_trace_d("%s", tt_heap_top(heap));
+        tt_heap_pop(heap);
+    }
+
+    tt_heap_exit(heap);
+}
+
+static tt_void_t tt_demo_heap_heapify(tt_void_t)
+{
+    tt_vector_ref_t vector = tt_vector_init(0, tt_element_uint8());
+    tt_heap_ref_t   heap = tt_heap_init(0, 0, tt_element_uint8());
+    if (vector && heap)
+    {
+        tt_size_t i = 0;
+        for (i = 0; i < 10; i++) tt_vector_insert_tail(vector, tt_u2p((i * 7) % 10));
+
+        // build heap from the vector in O(n)
+        tt_heap_heapify(heap, vector);
+        while (tt_heap_size(heap))
+        {
+            tt_trace_d("heapify: %u", tt_p2u8(tt_heap_top(heap)));
+            tt_heap_pop(heap);
+        }
+    }
+
+    if (vector) tt_vector_exit(vector);
+    if (heap) tt_heap_exit(heap);
+}
+
+static tt_void_t tt_demo_heap_perf(tt_size_t arity, tt_size_t n)
+{
+    tt_heap_ref_t heap = tt_heap_init(0, arity, tt_element_uint8());
+    tt_assert_and_check_return(heap);
+
+    tt_size_t i = 0;
+    tt_hong_t t = tt_mclock();
+    for (i = 0; i < n; i++) tt_heap_push(heap, tt_u2p((i * 2654435761u) >> 24));
+    for (i = 0; i < n; i++) tt_heap_pop(heap);
+    t = tt_mclock() - t;
+    tt_trace_d("arity: %lu, push and pop: %lu, time: %lld ms", arity, n, t);
+
+    tt_heap_exit(heap);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_heap_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo heap");
+
+    tt_demo_heap_str();
+    tt_demo_heap_heapify();
+    tt_demo_heap_perf(TT_HEAP_ARITY_BINARY, 1000000);
+    tt_demo_heap_perf(TT_HEAP_ARITY_QUATERNARY, 1000000);
+
+    return 0;
+}
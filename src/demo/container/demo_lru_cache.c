@@ -0,0 +1,88 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_LRU_CACHE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_lru_cache_evict(tt_cpointer_t key, tt_cpointer_t data, tt_cpointer_t priv)
+{
+    tt_trace_d("evict: %s => %s", key, data);
+}
+
+static tt_void_t tt_demo_lru_cache_str(tt_void_t)
+{
+    // the capacity: 16 bytes
+    tt_lru_cache_ref_t cache = tt_lru_cache_init(16, tt_element_str(tt_true), tt_element_str(tt_true), tt_demo_lru_cache_evict, tt_null);
+    tt_assert_and_check_return(cache);
+
+    // put with the data size as the cost
+    tt_lru_cache_put(cache, "a", "apple", 5);
+    tt_lru_cache_put(cache, "b", "banana", 6);
+    tt_lru_cache_put(cache, "c", "cat", 3);
+
+    // a is the most recent now, and b will be evicted
+    tt_trace_d("get a: %s", tt_lru_cache_get(cache, "a"));
+    tt_lru_cache_put(cache, "d", "durian", 6);
+    tt_trace_d("get b: %s", tt_lru_cache_get(cache, "b"));
+
+    // walk from the most recent
+    tt_for_all(tt_lru_cache_item_ref_t, item, cache)
+    {
+        tt_trace_d("%s => %s", item->key, item->data);
+    }
+
+    tt_hize_t hits = 0;
+    tt_hize_t misses = 0;
+    tt_lru_cache_stat(cache, &hits, &misses);
+    tt_trace_d("size: %lu, cost: %lu, hits: %llu, misses: %llu", tt_lru_cache_size(cache), tt_lru_cache_cost(cache), hits, misses);
+
+    tt_lru_cache_exit(cache);
+}
+
+static tt_void_t tt_demo_lru_cache_perf(tt_size_t n)
+{
+    tt_lru_cache_ref_t cache = tt_lru_cache_init(n / 4, tt_element_str(tt_true), tt_element_uint8(), tt_null, tt_null);
+    tt_assert_and_check_return(cache);
+
+    // get or put the keys with a skewed distribution
+    tt_char_t name[32];
+    tt_size_t i = 0;
+    tt_hong_t t = tt_mclock();
+    for (i = 0; i < n; i++)
+    {
+        tt_size_t k = (i * 2654435761u) % ((i & 1) ? (n / 8) : n);
+        snprintf(name, sizeof(name), "key_%lu", k);
+        if (!tt_lru_cache_get(cache, name)) tt_lru_cache_put(cache, name, tt_u2p(k), 1);
+    }
+    t = tt_mclock() - t;
+
+    tt_hize_t hits = 0;
+    tt_hize_t misses = 0;
+    tt_lru_cache_stat(cache, &hits, &misses);
+    tt_trace_d("n: %lu, size: %lu, hits: %llu, misses: %llu, time: %lld ms", n, tt_lru_cache_size(cache), hits, misses, t);
+
+    tt_lru_cache_exit(cache);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_lru_cache_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo lru cache");
+
+    tt_demo_lru_cache_str();
+    tt_demo_lru_cache_perf(1000000);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_RADIX_TREE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_radix_tree_topic(tt_void_t)
+{
+    tt_radix_tree_ref_t tree = tt_radix_tree_init(tt_element_str(tt_true));
+    tt_assert_and_check_return(tree);
+
+    // the routes
+    tt_radix_tree_insert(tree, "topic/", "default");
+    tt_radix_tree_insert(tree, "topic/alarm", "alarm");
+    tt_radix_tree_insert(tree, "topic/alarm/fire", "fire");
+    tt_radix_tree_insert(tree, "topic/alarms", "alarms");
+    tt_radix_tree_insert(tree, "topic/bus", "bus");
+    tt_radix_tree_insert(tree, "status", "status");
+
+    // walk all routes in the key order
+    tt_for_all(tt_radix_tree_item_ref_t, item, tree)
+    {
+        tt_trace_d("%s => %s", item->key, item->data);
+    }
+
+    // route by the longest prefix
+    tt_char_t const* topics[] = { "topic/alarm/fire/1", "topic/alarm/smoke", "topic/bus/7", "topic/x", "other" };
+    tt_size_t i = 0;
+    for (i = 0; i < tt_arrayn(topics); i++)
+    {
+        tt_size_t itor = tt_radix_tree_match(tree, topics[i]);
+        if (itor != tt_iterator_tail(tree)) tt_trace_d("route %s: %s", topics[i], ((tt_radix_tree_item_ref_t)tt_iterator_item(tree, itor))->data);
+        else tt_trace_d("route %s: none", topics[i]);
+    }
+
+    // walk the routes with the prefix
+    tt_size_t tail = 0;
+    tt_size_t itor = tt_radix_tree_prefix(tree, "topic/alarm", &tail);
+    for (; itor != tail; itor = tt_iterator_next(tree, itor))
+    {
+        tt_trace_d("prefix: %s", ((tt_radix_tree_item_ref_t)tt_iterator_item(tree, itor))->key);
+    }
+
+    tt_radix_tree_remove(tree, "topic/alarm");
+    tt_trace_d("get topic/alarm/fire: %s, size: %lu", tt_radix_tree_get(tree, "topic/alarm/fire"), tt_radix_tree_size(tree));
+
+    tt_radix_tree_exit(tree);
+}
+
+static tt_void_t tt_demo_radix_tree_perf(tt_size_t n)
+{
+    tt_radix_tree_ref_t tree = tt_radix_tree_init(tt_element_uint8());
+    tt_assert_and_check_return(tree);
+
+    // insert the routes
+    tt_char_t name[64];
+    tt_size_t i = 0;
+    tt_hong_t t = tt_mclock();
+    for (i = 0; i < n; i++)
+    {
+        tt_size_t k = (i * 2654435761u) % n;
+        snprintf(name, sizeof(name), "device/%lu/sensor/%lu", k >> 4, k & 15);
+        tt_radix_tree_insert(tree, name, tt_u2p(i & 0xff));
+    }
+    tt_hong_t ti = tt_mclock() - t;
+
+    // match the topics
+    tt_size_t found = 0;
+    t = tt_mclock();
+    for (i = 0; i < n; i++)
+    {
+        snprintf(name, sizeof(name), "device/%lu/sensor/%lu/value", i >> 4, i & 15);
+        if (tt_radix_tree_match(tree, name) != tt_iterator_tail(tree)) found++;
+    }
+    tt_hong_t tm = tt_mclock() - t;
+
+    tt_trace_d("n: %lu, size: %lu, matched: %lu", n, tt_radix_tree_size(tree), found);
+    tt_trace_d("insert: %lld ms, match: %lld ms", ti, tm);
+
+    tt_radix_tree_exit(tree);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_radix_tree_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo radix tree");
+
+    tt_demo_radix_tree_topic();
+    tt_demo_radix_tree_perf(1000000);
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_SLOT_MAP"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_slot_map_base(tt_void_t)
+{
+    tt_slot_map_ref_t map = tt_slot_map_init(0, tt_element_str(tt_true));
+    tt_assert_and_check_return(map);
+
+    // insert
+    tt_slot_map_handle_t h0 = tt_slot_map_insert(map, "alice");
+    tt_slot_map_handle_t h1 = tt_slot_map_insert(map, "bob");
+    tt_slot_map_handle_t h2 = tt_slot_map_insert(map, "carol");
+    tt_trace_d("h0: %s, h1: %s, h2: %s, size: %lu", tt_slot_map_get(map, h0), tt_slot_map_get(map, h1), tt_slot_map_get(map, h2), tt_slot_map_size(map));
+
+    // remove h0, carol is moved to the hole and h2 is still valid
+    tt_slot_map_remove(map, h0);
+    tt_trace_d("h0: %p, h2: %s, size: %lu", tt_slot_map_get(map, h0), tt_slot_map_get(map, h2), tt_slot_map_size(map));
+
+    // the slot of h0 is reused with the new generation, h0 is still stale
+    tt_slot_map_handle_t h3 = tt_slot_map_insert(map, "dave");
+    tt_trace_d("h3: %s, slot: %u, generation: %u, h0: %p", tt_slot_map_get(map, h3), tt_slot_map_handle_index(h3), tt_slot_map_handle_generation(h3), tt_slot_map_get(map, h0));
+
+    // replace
+    tt_slot_map_replace(map, h1, "bobby");
+
+    // walk the dense items
+    tt_for_all(tt_char_t const*, name, map)
+    {
+        tt_trace_d("[%lu]: %s, handle: %llx", name_itor, name, tt_slot_map_handle(map, name_itor));
+    }
+
+    tt_slot_map_exit(map);
+}
+
+static tt_void_t tt_demo_slot_map_perf(tt_size_t n)
+{
+    tt_slot_map_ref_t map = tt_slot_map_init(n, tt_element_uint8());
+    tt_assert_and_check_return(map);
+
+    tt_slot_map_handle_t* handles = (tt_slot_map_handle_t*)tt_nalloc0(sizeof(tt_slot_map_handle_t), n);
+    tt_assert_and_check_return(handles);
+
+    // insert
+    tt_size_t i = 0;
+    tt_hong_t t = tt_mclock();
+    for (i = 0; i < n; i++) handles[i] = tt_slot_map_insert(map, tt_u2p(i & 0xff));
+    tt_hong_t ti = tt_mclock() - t;
+
+    // get
+    t = tt_mclock();
+    tt_size_t sum = 0;
+    for (i = 0; i < n; i++) sum += tt_p2u8(tt_slot_map_get(map, handles[i]));
+    tt_hong_t tg = tt_mclock() - t;
+
+    // walk
+    t = tt_mclock();
+    tt_for_all(tt_pointer_t, item, map) sum += tt_p2u8(item);
+    tt_hong_t tw = tt_mclock() - t;
+
+    // remove the half
+    t = tt_mclock();
+    for (i = 0; i < n; i += 2) tt_slot_map_remove(map, handles[i]);
+    tt_hong_t tr = tt_mclock() - t;
+
+    // the removed handles are stale
+    tt_size_t stale = 0;
+    for (i = 0; i < n; i++) if (!tt_slot_map_get(map, handles[i]) && !(i & 1)) stale++;
+
+    tt_trace_d("n: %lu, insert: %lld ms, get: %lld ms, walk: %lld ms, remove: %lld ms, stale: %lu, size: %lu, sum: %lu", n, ti, tg, tw, tr, stale, tt_slot_map_size(map), sum);
+
+    tt_free(handles);
+    tt_slot_map_exit(map);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_slot_map_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo slot map");
+
+    tt_demo_slot_map_base();
+    tt_demo_slot_map_perf(1000000);
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_STRING_POOL"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_string_pool_base(tt_void_t)
+{
+    tt_string_pool_ref_t pool = tt_string_pool_init(0);
+    tt_assert_and_check_return(pool);
+
+    // the equal strings have the same handle
+    tt_char_t name[32];
+    snprintf(name, sizeof(name), "hello %s", "world");
+    tt_char_t const* h0 = tt_string_pool_insert(pool, "hello world");
+    tt_char_t const* h1 = tt_string_pool_insert(pool, name);
+    tt_char_t const* h2 = tt_string_pool_insert(pool, "hello ttlib");
+    tt_trace_d("h0: %s, h1: %s, h0 == h1: %d, h0 == h2: %d, refn: %lu, size: %lu", h0, h1, h0 == h1, h0 == h2, tt_string_pool_refn(pool, h0), tt_string_pool_size(pool));
+
+    tt_string_pool_remove(pool, h0);
+    tt_string_pool_remove(pool, h1);
+    tt_trace_d("find: %p, size: %lu", tt_string_pool_find(pool, "hello world"), tt_string_pool_size(pool));
+
+    tt_string_pool_remove(pool, h2);
+    tt_string_pool_exit(pool);
+}
+
+static tt_void_t tt_demo_string_pool_perf(tt_element_t e, tt_char_t const* name, tt_size_t n)
+{
+    tt_vector_ref_t vector = tt_vector_init(n, e);
+    tt_assert_and_check_return(vector);
+
+    // insert the repeated strings
+    tt_char_t str[64];
+    tt_size_t i = 0;
+    tt_hong_t t = tt_mclock();
+    for (i = 0; i < n; i++)
+    {
+        snprintf(str, sizeof(str), "device/%lu/status", i % 1000);
+        tt_vector_insert_tail(vector, str);
+    }
+    tt_hong_t ti = tt_mclock() - t;
+
+    // find the last string
+    t = tt_mclock();
+    tt_size_t found = 0;
+    for (i = 0; i < 100; i++) if (tt_find_all(vector, "device/999/status") != tt_iterator_tail(vector)) found++;
+    tt_hong_t tf = tt_mclock() - t;
+
+    t = tt_mclock();
+    tt_vector_exit(vector);
+    tt_hong_t te = tt_mclock() - t;
+
+    tt_trace_d("%s: n: %lu, insert: %lld ms, find: %lld ms, exit: %lld ms", name, n, ti, tf, te);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_string_pool_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo string pool");
+
+    tt_demo_string_pool_base();
+
+    tt_string_pool_ref_t pool = tt_string_pool_init(0);
+    tt_demo_string_pool_perf(tt_element_str(tt_true), "str", 1000000);
+    tt_demo_string_pool_perf(tt_element_str_pooled(pool), "str pooled", 1000000);
+    tt_trace_d("pool size: %lu", tt_string_pool_size(pool));
+    tt_string_pool_exit(pool);
+
+    return 0;
+}
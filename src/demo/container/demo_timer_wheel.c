@@ -0,0 +1,116 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_TIMER_WHEEL"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+typedef struct __tt_demo_conn_t
+{
+    // the timeout timer
+    tt_timer_wheel_timer_t  timer;
+
+    // the conn id
+    tt_size_t               id;
+
+}tt_demo_conn_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_timer_wheel_timeout(tt_timer_wheel_timer_ref_t timer, tt_cpointer_t priv)
+{
+    tt_demo_conn_t* conn = (tt_demo_conn_t*)timer;
+    tt_trace_d("conn[%lu]: timeout", conn->id);
+}
+
+static tt_void_t tt_demo_timer_wheel_count(tt_timer_wheel_timer_ref_t timer, tt_cpointer_t priv)
+{
+    (*((tt_size_t*)priv))++;
+}
+
+static tt_void_t tt_demo_timer_wheel_base(tt_void_t)
+{
+    tt_timer_wheel_ref_t wheel = tt_timer_wheel_init(10, TT_TIMER_WHEEL_CLOCK_MCLOCK);
+    tt_assert_and_check_return(wheel);
+
+    tt_demo_conn_t conns[3];
+    tt_size_t i = 0;
+    for (i = 0; i < 3; i++)
+    {
+        conns[i].id = i;
+        tt_timer_wheel_timer_init(&conns[i].timer);
+        tt_timer_wheel_add(wheel, &conns[i].timer, 50 * (i + 1), tt_demo_timer_wheel_timeout, tt_null);
+    }
+
+    // conn1 is closed and conn2 is active again
+    tt_timer_wheel_cancel(wheel, &conns[1].timer);
+    tt_timer_wheel_add(wheel, &conns[2].timer, 200, tt_demo_timer_wheel_timeout, tt_null);
+
+    tt_hong_t t = tt_mclock();
+    while (tt_timer_wheel_size(wheel))
+    {
+        tt_msleep(10);
+        tt_size_t n = tt_timer_wheel_spak(wheel);
+        if (n) tt_trace_d("%lld ms: expired: %lu, pending: %lu", tt_mclock() - t, n, tt_timer_wheel_size(wheel));
+    }
+
+    tt_timer_wheel_exit(wheel);
+}
+
+static tt_void_t tt_demo_timer_wheel_perf(tt_size_t n)
+{
+    // the simulated clock, one tick per ms
+    tt_timer_wheel_ref_t wheel = tt_timer_wheel_init(1, TT_TIMER_WHEEL_CLOCK_MCLOCK);
+    tt_assert_and_check_return(wheel);
+
+    tt_timer_wheel_timer_t* timers = (tt_timer_wheel_timer_t*)tt_nalloc0(sizeof(tt_timer_wheel_timer_t), n);
+    tt_assert_and_check_return(timers);
+
+    tt_hong_t now = tt_mclock();
+    tt_size_t count = 0;
+
+    // add the timeouts in 60s
+    tt_size_t i = 0;
+    tt_hong_t t = tt_mclock();
+    for (i = 0; i < n; i++) tt_timer_wheel_add(wheel, &timers[i], (i * 7919) % 60000, tt_demo_timer_wheel_count, &count);
+    tt_hong_t ta = tt_mclock() - t;
+
+    // cancel the half
+    t = tt_mclock();
+    for (i = 0; i < n; i += 2) tt_timer_wheel_cancel(wheel, &timers[i]);
+    tt_hong_t tc = tt_mclock() - t;
+
+    // expire all in 60s
+    t = tt_mclock();
+    tt_size_t ticks = 0;
+    for (ticks = 0; ticks <= 60000; ticks++) tt_timer_wheel_spak_at(wheel, now + ticks);
+    tt_hong_t te = tt_mclock() - t;
+
+    tt_trace_d("n: %lu, add: %lld ms, cancel: %lld ms, expire %lu ticks: %lld ms, expired: %lu, pending: %lu", n, ta, tc, ticks, te, count, tt_timer_wheel_size(wheel));
+
+    tt_free(timers);
+    tt_timer_wheel_exit(wheel);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_timer_wheel_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo timer wheel");
+
+    tt_demo_timer_wheel_base();
+    tt_demo_timer_wheel_perf(1000000);
+
+    return 0;
+}
@@ -1 +1,114 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_VECTOR"
+#define TT_TRACE_MODULE_DEBUG         (1)
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_vector_insert_tail_perf(tt_size_t factor, tt_size_t n)
+{
+    tt_vector_ref_t vector = tt_vector_init(0, tt_element_uint8());
+    tt_assert_and_check_return(vector);
+
+    tt_vector_factor_set(vector, factor);
+
+    // insert tail, count the reallocs
+    tt_size_t i = 0;
+    tt_size_t grows = 0;
+    tt_size_t maxn = tt_vector_maxn(vector);
+    tt_hong_t t = tt_uclock();
+    for (i = 0; i < n; i++)
+    {
+        tt_vector_insert_tail(vector, tt_u2p(i));
+        if (tt_vector_maxn(vector) != maxn)
+        {
+            maxn = tt_vector_maxn(vector);
+            grows++;
+        }
+    }
+    t = tt_uclock() - t;
+
+    tt_trace_d("factor: %lu, size: %lu, maxn: %lu, grows: %lu, time: %lld us, %lld ns/item", factor, tt_vector_size(vector), tt_vector_maxn(vector), grows, t, t * 1000 / (tt_hong_t)n);
+
+    // shrink
+    tt_vector_shrink(vector);
+    tt_trace_d("shrink, maxn: %lu", tt_vector_maxn(vector));
+
+    tt_vector_exit(vector);
+}
+
+static tt_void_t tt_demo_vector_reserve(tt_void_t)
+{
+    tt_vector_ref_t vector = tt_vector_init(0, tt_element_uint8());
+    tt_assert_and_check_return(vector);
+
+    // reserve 1M items, no realloc for the following inserts
+    tt_vector_reserve(vector, 1 << 20);
+
+    tt_size_t i = 0;
+    for (i = 0; i < (1 << 20); i++) tt_vector_insert_tail(vector, tt_u2p(i));
+
+    tt_trace_d("reserve, size: %lu, maxn: %lu", tt_vector_size(vector), tt_vector_maxn(vector));
+
+    tt_vector_exit(vector);
+}
+
+static tt_void_t tt_demo_vector_ninsert_perf(tt_size_t n)
+{
+    tt_vector_ref_t vector = tt_vector_init(0, tt_element_str(tt_true));
+    tt_assert_and_check_return(vector);
+
+    tt_vector_insert_tail(vector, "tail");
+
+    // insert head one by one
+    tt_size_t i = 0;
+    tt_hong_t t = tt_uclock();
+    for (i = 0; i < n; i++) tt_vector_insert_head(vector, "item");
+    t = tt_uclock() - t;
+    tt_trace_d("insert head x %lu: %lld us", n, t);
+
+    // remove head one by one
+    t = tt_uclock();
+    for (i = 0; i < n; i++) tt_vector_remove_head(vector);
+    t = tt_uclock() - t;
+    tt_trace_d("remove head x %lu: %lld us", n, t);
+
+    // ninsert head
+    t = tt_uclock();
+    tt_vector_ninsert_head(vector, "item", n);
+    t = tt_uclock() - t;
+    tt_trace_d("ninsert head %lu: %lld us", n, t);
+
+    // nremove head
+    t = tt_uclock();
+    tt_vector_nremove_head(vector, n);
+    t = tt_uclock() - t;
+    tt_trace_d("nremove head %lu: %lld us, size: %lu, last: %s", n, t, tt_vector_size(vector), (tt_char_t const*)tt_vector_last(vector));
+
+    tt_vector_exit(vector);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_vector_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo vector");
+
+    tt_demo_vector_insert_tail_perf(100, 10000000);
+    tt_demo_vector_insert_tail_perf(50, 10000000);
+    tt_demo_vector_insert_tail_perf(0, 100000);
+    tt_demo_vector_reserve();
+    tt_demo_vector_ninsert_perf(50000);
+
+    return 0;
+}
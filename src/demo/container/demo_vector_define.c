@@ -0,0 +1,117 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_VECTOR_DEFINE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the point type
+typedef struct __tt_demo_point_t
+{
+    tt_int32_t      x;
+    tt_int32_t      y;
+
+}tt_demo_point_t;
+
+// the point is ordered by x and then y
+static __tt_inline__ tt_long_t tt_demo_vector_point_comp(tt_demo_point_t const* litem, tt_demo_point_t const* ritem)
+{
+    if (litem->x != ritem->x) return tt_vector_define_comp_num(&litem->x, &ritem->x);
+    return tt_vector_define_comp_num(&litem->y, &ritem->y);
+}
+
+// define tt_demo_vector_u32_xxx() with the numeric ordering
+TT_VECTOR_DEFINE(tt_demo_vector_u32, tt_uint32_t)
+
+// define tt_demo_vector_point_xxx(), the struct needs the comparator
+TT_VECTOR_DEFINE_WITH_COMP(tt_demo_vector_point, tt_demo_point_t, tt_demo_vector_point_comp)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_vector_define_point(tt_void_t)
+{
+    // the vector and its data are allocated by the small allocator
+    tt_demo_vector_point_ref_t vector = tt_demo_vector_point_init_with_allocator(0, tt_small_allocator());
+    tt_assert_and_check_return(vector);
+
+    tt_int32_t i = 0;
+    for (i = 0; i < 5; i++)
+    {
+        tt_demo_point_t point = {i, i * i};
+        tt_demo_vector_point_insert_tail(vector, point);
+    }
+    tt_demo_point_t head = {-1, -1};
+    tt_demo_vector_point_insert_head(vector, head);
+    tt_demo_vector_point_remove(vector, 3);
+
+    // walk the items by the iterator
+    tt_for_all(tt_demo_point_t*, point, tt_demo_vector_point_iterator(vector))
+    {
+        tt_trace_d("point: (%d, %d)", point->x, point->y);
+    }
+
+    // find by the item pointer
+    tt_demo_point_t      four = {4, 16};
+    tt_iterator_ref_t    iterator = tt_demo_vector_point_iterator(vector);
+    tt_trace_d("find (4, 16): %lu, size: %lu", tt_find_all(iterator, &four), tt_demo_vector_point_size(vector));
+
+    tt_demo_vector_point_exit(vector);
+}
+
+static tt_void_t tt_demo_vector_define_perf(tt_size_t n)
+{
+    tt_vector_ref_t            vector = tt_vector_init(0, tt_element_uint8());
+    tt_demo_vector_u32_ref_t   vector_u32 = tt_demo_vector_u32_init(0);
+    if (vector && vector_u32)
+    {
+        // insert tail and sum by tt_vector
+        tt_size_t i = 0;
+        tt_size_t sum = 0;
+        tt_hong_t t = tt_uclock();
+        for (i = 0; i < n; i++) tt_vector_insert_tail(vector, tt_u2p(i));
+        tt_for_all(tt_pointer_t, item, vector) sum += tt_p2u8(item);
+        t = tt_uclock() - t;
+        tt_trace_d("vector:     n: %lu, sum: %lu, time: %lld us", n, sum, t);
+
+        // insert tail and sum by the typed vector
+        sum = 0;
+        t = tt_uclock();
+        for (i = 0; i < n; i++) tt_demo_vector_u32_insert_tail(vector_u32, (tt_uint8_t)i);
+        tt_uint32_t* data = tt_demo_vector_u32_data(vector_u32);
+        tt_size_t    size = tt_demo_vector_u32_size(vector_u32);
+        for (i = 0; i < size; i++) sum += data[i];
+        t = tt_uclock() - t;
+        tt_trace_d("vector_u32: n: %lu, sum: %lu, time: %lld us", n, sum, t);
+
+        // the existing algorithms work on the typed vector too
+        tt_uint32_t value = 0x7f;
+        tt_trace_d("vector_u32: find 0x7f: %lu", tt_find_all(tt_demo_vector_u32_iterator(vector_u32), &value));
+    }
+
+    if (vector) tt_vector_exit(vector);
+    if (vector_u32) tt_demo_vector_u32_exit(vector_u32);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_vector_define_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo vector define");
+
+    tt_demo_vector_define_point();
+    tt_demo_vector_define_perf(10000000);
+
+    return 0;
+}
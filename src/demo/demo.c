@@ -48,8 +48,27 @@ static tt_demo_t g_demo[] = {
 	TT_DEMO_MAIN_ITEM(utils_dump),
 	TT_DEMO_MAIN_ITEM(utils_mix),
 	TT_DEMO_MAIN_ITEM(circular_buffer),
+	TT_DEMO_MAIN_ITEM(record_ring),
 	TT_DEMO_MAIN_ITEM(single_list_entry),
 	TT_DEMO_MAIN_ITEM(queue_entry),
+	TT_DEMO_MAIN_ITEM(vector),
+	TT_DEMO_MAIN_ITEM(hash_map),
+	TT_DEMO_MAIN_ITEM(vector_define),
+	TT_DEMO_MAIN_ITEM(deque),
+	TT_DEMO_MAIN_ITEM(heap),
+	TT_DEMO_MAIN_ITEM(bloom_filter),
+	TT_DEMO_MAIN_ITEM(lru_cache),
+	TT_DEMO_MAIN_ITEM(bplus_tree),
+	TT_DEMO_MAIN_ITEM(bitmap),
+	TT_DEMO_MAIN_ITEM(radix_tree),
+	TT_DEMO_MAIN_ITEM(string_pool),
+	TT_DEMO_MAIN_ITEM(slot_map),
+	TT_DEMO_MAIN_ITEM(timer_wheel),
+	TT_DEMO_MAIN_ITEM(fixed_pool),
+	TT_DEMO_MAIN_ITEM(arena),
+	TT_DEMO_MAIN_ITEM(small_allocator),
+	TT_DEMO_MAIN_ITEM(malloc_trace),
+	TT_DEMO_MAIN_ITEM(vmem),
 	TT_DEMO_MAIN_ITEM(platform_thread),
 	TT_DEMO_MAIN_ITEM(platform_spinlock),
 	TT_DEMO_MAIN_ITEM(platform_semaphore),
@@ -62,10 +81,6 @@ tt_int_t main(tt_int_t argc, tt_char_t** argv)
 #else
 #endif		
 	
-	// debug
-	// argc = 2;
-	// argv[1] = "fixed_pool";
-
 	// find the demo main
 	tt_int_t         ok;
 	tt_char_t const* name = tt_null;
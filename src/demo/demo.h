@@ -29,10 +29,28 @@ TT_DEMO_MAIN_DECL(utils);
 TT_DEMO_MAIN_DECL(utils_dump);
 TT_DEMO_MAIN_DECL(utils_mix);
 TT_DEMO_MAIN_DECL(circular_buffer);
+TT_DEMO_MAIN_DECL(record_ring);
 TT_DEMO_MAIN_DECL(single_list_entry);
 TT_DEMO_MAIN_DECL(queue_entry);
+TT_DEMO_MAIN_DECL(vector);
+TT_DEMO_MAIN_DECL(hash_map);
+TT_DEMO_MAIN_DECL(vector_define);
+TT_DEMO_MAIN_DECL(deque);
+TT_DEMO_MAIN_DECL(heap);
+TT_DEMO_MAIN_DECL(bloom_filter);
+TT_DEMO_MAIN_DECL(lru_cache);
+TT_DEMO_MAIN_DECL(bplus_tree);
+TT_DEMO_MAIN_DECL(bitmap);
+TT_DEMO_MAIN_DECL(radix_tree);
+TT_DEMO_MAIN_DECL(string_pool);
+TT_DEMO_MAIN_DECL(slot_map);
+TT_DEMO_MAIN_DECL(timer_wheel);
 TT_DEMO_MAIN_DECL(static_fixed_pool);
 TT_DEMO_MAIN_DECL(fixed_pool);
+TT_DEMO_MAIN_DECL(arena);
+TT_DEMO_MAIN_DECL(small_allocator);
+TT_DEMO_MAIN_DECL(malloc_trace);
+TT_DEMO_MAIN_DECL(vmem);
 TT_DEMO_MAIN_DECL(static_large_allocator);
 TT_DEMO_MAIN_DECL(platform_thread);
 TT_DEMO_MAIN_DECL(platform_spinlock);
@@ -0,0 +1,86 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_ARENA"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_arena_base(tt_void_t)
+{
+    tt_arena_ref_t arena = tt_arena_init(0);
+    tt_assert_and_check_return(arena);
+
+    // bump
+    tt_char_t*   name = tt_arena_strdup(arena, "request");
+    tt_pointer_t page = tt_arena_align_malloc(arena, 100, 4096);
+    tt_trace_d("name: %s, page: %p, aligned: %d, size: %lu", name, page, !((tt_size_t)page & 4095), tt_arena_size(arena));
+
+    // rollback the temporary data
+    tt_arena_savepoint_t savepoint = tt_arena_save(arena);
+    tt_arena_malloc(arena, 1000);
+    tt_arena_malloc(arena, 100000);
+    tt_trace_d("temporary size: %lu", tt_arena_size(arena));
+    tt_arena_restore(arena, &savepoint);
+    tt_trace_d("restored size: %lu", tt_arena_size(arena));
+
+    // the vector and strings in the arena
+    tt_allocator_ref_t allocator = tt_arena_allocator(arena);
+    tt_vector_ref_t vector = tt_vector_init_with_allocator(4, tt_element_str_with_allocator(tt_true, allocator), allocator);
+    tt_vector_insert_tail(vector, "hello");
+    tt_vector_insert_tail(vector, "arena");
+    tt_for_all(tt_char_t const*, str, vector) tt_trace_d("vector: %s", str);
+    tt_vector_exit(vector);
+
+    // free all
+    tt_arena_reset(arena);
+    tt_trace_d("reset size: %lu", tt_arena_size(arena));
+
+    tt_arena_exit(arena);
+}
+
+static tt_void_t tt_demo_arena_perf(tt_allocator_ref_t allocator, tt_arena_ref_t arena, tt_char_t const* name, tt_size_t n)
+{
+    tt_char_t str[64];
+    tt_size_t i = 0;
+    tt_size_t r = 0;
+    tt_hong_t t = tt_mclock();
+    for (r = 0; r < 100; r++)
+    {
+        // the temporaries of one request
+        tt_vector_ref_t vector = tt_vector_init_with_allocator(0, tt_element_str_with_allocator(tt_true, allocator), allocator);
+        for (i = 0; i < n; i++)
+        {
+            snprintf(str, sizeof(str), "header/%lu", i);
+            tt_vector_insert_tail(vector, str);
+        }
+        tt_vector_exit(vector);
+        if (arena) tt_arena_reset(arena);
+    }
+    tt_trace_d("%s: %lu x 100: %lld ms", name, n, tt_mclock() - t);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_arena_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo arena");
+
+    tt_demo_arena_base();
+
+    tt_arena_ref_t arena = tt_arena_init(0);
+    tt_demo_arena_perf(tt_null, tt_null, "native", 10000);
+    tt_demo_arena_perf(tt_arena_allocator(arena), arena, "arena", 10000);
+    tt_arena_exit(arena);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_FIXED_POOL"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+typedef struct __tt_demo_fixed_pool_entry_t
+{
+    // the list entry
+    tt_list_entry_t         entry;
+
+    // the data
+    tt_size_t               data;
+
+}tt_demo_fixed_pool_entry_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_bool_t tt_demo_fixed_pool_walk(tt_pointer_t data, tt_cpointer_t priv)
+{
+    tt_demo_fixed_pool_entry_t* item = (tt_demo_fixed_pool_entry_t*)data;
+    tt_trace_d("walk: %lu", item->data);
+    return tt_true;
+}
+
+static tt_void_t tt_demo_fixed_pool_exit(tt_pointer_t data, tt_cpointer_t priv)
+{
+    (*((tt_size_t*)priv))++;
+}
+
+static tt_void_t tt_demo_fixed_pool_base(tt_void_t)
+{
+    tt_size_t exited = 0;
+    tt_fixed_pool_ref_t pool = tt_fixed_pool_init(0, sizeof(tt_demo_fixed_pool_entry_t), tt_demo_fixed_pool_exit, &exited);
+    tt_assert_and_check_return(pool);
+
+    tt_demo_fixed_pool_entry_t* items[5];
+    tt_size_t i = 0;
+    for (i = 0; i < 5; i++)
+    {
+        items[i] = (tt_demo_fixed_pool_entry_t*)tt_fixed_pool_malloc0(pool);
+        if (items[i]) items[i]->data = i;
+    }
+    tt_fixed_pool_free(pool, items[1]);
+    tt_fixed_pool_free(pool, items[3]);
+
+    tt_trace_d("size: %lu, item size: %lu", tt_fixed_pool_size(pool), tt_fixed_pool_item_size(pool));
+    tt_fixed_pool_walk(pool, tt_demo_fixed_pool_walk, tt_null);
+
+    tt_fixed_pool_exit(pool);
+    tt_trace_d("exited: %lu", exited);
+}
+
+static tt_void_t tt_demo_fixed_pool_perf(tt_size_t n)
+{
+    tt_pointer_t* items = (tt_pointer_t*)tt_nalloc0(sizeof(tt_pointer_t), n);
+    tt_assert_and_check_return(items);
+
+    // malloc and free by the fixed pool
+    tt_fixed_pool_ref_t pool = tt_fixed_pool_init(0, sizeof(tt_demo_fixed_pool_entry_t), tt_null, tt_null);
+    tt_size_t i = 0;
+    tt_size_t r = 0;
+    tt_hong_t t = tt_mclock();
+    for (r = 0; r < 10; r++)
+    {
+        for (i = 0; i < n; i++) items[i] = tt_fixed_pool_malloc(pool);
+        for (i = 0; i < n; i++) tt_fixed_pool_free(pool, items[i]);
+    }
+    tt_hong_t tp = tt_mclock() - t;
+    tt_fixed_pool_exit(pool);
+
+    // malloc and free by the libc
+    t = tt_mclock();
+    for (r = 0; r < 10; r++)
+    {
+        for (i = 0; i < n; i++) items[i] = tt_malloc(sizeof(tt_demo_fixed_pool_entry_t));
+        for (i = 0; i < n; i++) tt_free(items[i]);
+    }
+    tt_hong_t tm = tt_mclock() - t;
+
+    tt_trace_d("n: %lu x 10, fixed pool: %lld ms, malloc: %lld ms", n, tp, tm);
+    tt_free(items);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_fixed_pool_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo fixed pool");
+
+    tt_demo_fixed_pool_base();
+    tt_demo_fixed_pool_perf(1000000);
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_MALLOC_TRACE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef TT_CONFIG_MALLOC_TRACE
+static tt_void_t tt_demo_malloc_trace_base(tt_void_t)
+{
+    // the container items are traced at the call sites of the containers
+    tt_vector_ref_t vector = tt_vector_init(16, tt_element_str(tt_true));
+    tt_assert_and_check_return(vector);
+
+    tt_size_t i = 0;
+    tt_char_t s[32];
+    for (i = 0; i < 1000; i++)
+    {
+        snprintf(s, sizeof(s), "item: %lu", i);
+        tt_vector_insert_tail(vector, s);
+    }
+    tt_trace_d("size: %lu bytes, peak: %lu bytes", tt_malloc_trace_size(), tt_malloc_trace_peak());
+    tt_vector_exit(vector);
+
+    // the data is leaked and reported at tt_lib_exit
+    tt_pointer_t leak = tt_malloc(64);
+    tt_trace_d("leak: %p, size: %lu bytes, peak: %lu bytes", leak, tt_malloc_trace_size(), tt_malloc_trace_peak());
+
+    tt_malloc_trace_dump();
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_malloc_trace_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo malloc trace");
+
+#ifdef TT_CONFIG_MALLOC_TRACE
+    tt_demo_malloc_trace_base();
+#else
+    tt_trace_d("enable TT_CONFIG_MALLOC_TRACE in prefix/config.h for tracing tt_malloc");
+#endif
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_SMALL_ALLOCATOR"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread count
+#define TT_DEMO_SMALL_ALLOCATOR_THREADS     (4)
+
+// the item count of one thread
+#define TT_DEMO_SMALL_ALLOCATOR_ITEMS       (100000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_int_t tt_demo_small_allocator_small(tt_cpointer_t priv)
+{
+    tt_pointer_t* items = (tt_pointer_t*)priv;
+    tt_size_t i = 0;
+    tt_size_t r = 0;
+    for (r = 0; r < 10; r++)
+    {
+        for (i = 0; i < TT_DEMO_SMALL_ALLOCATOR_ITEMS; i++) items[i] = tt_small_allocator_malloc(8 + (i & 255));
+        for (i = 0; i < TT_DEMO_SMALL_ALLOCATOR_ITEMS; i++) tt_small_allocator_free(items[i]);
+    }
+    return 0;
+}
+
+static tt_int_t tt_demo_small_allocator_libc(tt_cpointer_t priv)
+{
+    tt_pointer_t* items = (tt_pointer_t*)priv;
+    tt_size_t i = 0;
+    tt_size_t r = 0;
+    for (r = 0; r < 10; r++)
+    {
+        for (i = 0; i < TT_DEMO_SMALL_ALLOCATOR_ITEMS; i++) items[i] = malloc(8 + (i & 255));
+        for (i = 0; i < TT_DEMO_SMALL_ALLOCATOR_ITEMS; i++) free(items[i]);
+    }
+    return 0;
+}
+
+static tt_hong_t tt_demo_small_allocator_run(tt_thread_func_t func)
+{
+    tt_pointer_t*   items[TT_DEMO_SMALL_ALLOCATOR_THREADS];
+    tt_thread_ref_t threads[TT_DEMO_SMALL_ALLOCATOR_THREADS];
+    tt_size_t       i = 0;
+    tt_hong_t       t = tt_mclock();
+    for (i = 0; i < TT_DEMO_SMALL_ALLOCATOR_THREADS; i++)
+    {
+        items[i]   = (tt_pointer_t*)calloc(TT_DEMO_SMALL_ALLOCATOR_ITEMS, sizeof(tt_pointer_t));
+        threads[i] = tt_thread_init(tt_null, func, items[i], 0);
+    }
+    for (i = 0; i < TT_DEMO_SMALL_ALLOCATOR_THREADS; i++)
+    {
+        if (threads[i])
+        {
+            tt_thread_wait(threads[i], -1, tt_null);
+            tt_thread_exit(threads[i]);
+        }
+        free(items[i]);
+    }
+    return tt_mclock() - t;
+}
+
+static tt_void_t tt_demo_small_allocator_base(tt_void_t)
+{
+    // the small data and the large data
+    tt_char_t* small = (tt_char_t*)tt_small_allocator_malloc0(24);
+    tt_char_t* large = (tt_char_t*)tt_small_allocator_malloc0(8192);
+    tt_trace_d("small: %p, large: %p", small, large);
+
+    // move the small data to the larger class
+    small = (tt_char_t*)tt_small_allocator_ralloc(small, 100);
+    tt_trace_d("ralloc: %p", small);
+
+    tt_small_allocator_free(small);
+    tt_small_allocator_free(large);
+
+    // the container items
+    tt_hash_map_ref_t hash_map = tt_hash_map_init_with_allocator(0, tt_element_str_with_allocator(tt_true, tt_small_allocator()), tt_element_str_with_allocator(tt_true, tt_small_allocator()), tt_small_allocator());
+    if (hash_map)
+    {
+        tt_hash_map_insert(hash_map, "hello", "world");
+        tt_hash_map_insert(hash_map, "small", "allocator");
+        tt_trace_d("hello: %s, small: %s", (tt_char_t const*)tt_hash_map_get(hash_map, "hello"), (tt_char_t const*)tt_hash_map_get(hash_map, "small"));
+        tt_hash_map_exit(hash_map);
+    }
+
+    // return the cached items of this thread
+    tt_small_allocator_flush();
+}
+
+static tt_void_t tt_demo_small_allocator_perf(tt_void_t)
+{
+    tt_hong_t ts = tt_demo_small_allocator_run(tt_demo_small_allocator_small);
+    tt_hong_t tm = tt_demo_small_allocator_run(tt_demo_small_allocator_libc);
+    tt_trace_d("threads: %d, n: %d x 10, small allocator: %lld ms, malloc: %lld ms", TT_DEMO_SMALL_ALLOCATOR_THREADS, TT_DEMO_SMALL_ALLOCATOR_ITEMS, ts, tm);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_small_allocator_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo small allocator");
+
+    tt_demo_small_allocator_base();
+    tt_demo_small_allocator_perf();
+
+    return 0;
+}
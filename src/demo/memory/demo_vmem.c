@@ -0,0 +1,80 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "DEMO_VMEM"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ttlib.h"
+#include "../color.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tt_void_t tt_demo_vmem_vector(tt_allocator_ref_t allocator, tt_char_t const* name, tt_size_t n)
+{
+    tt_size_t i = 0;
+    tt_hong_t t = tt_mclock();
+
+    // the large vector grows in place with the vmem allocator
+    tt_vector_ref_t vector = tt_vector_init_with_allocator(0, tt_element_uint8(), allocator);
+    tt_assert_and_check_return(vector);
+
+    tt_pointer_t data = tt_null;
+    tt_size_t    moved = 0;
+    for (i = 0; i < n; i++)
+    {
+        tt_vector_insert_tail(vector, tt_u2p(i));
+        if (tt_vector_data(vector) != data)
+        {
+            data = tt_vector_data(vector);
+            moved++;
+        }
+    }
+    tt_trace_d("%s: %lu items, moved: %lu, %lld ms", name, tt_vector_size(vector), moved, tt_mclock() - t);
+
+    tt_vector_exit(vector);
+}
+
+static tt_void_t tt_demo_vmem_circular_buffer(tt_void_t)
+{
+    // the large data of the circular buffer
+    tt_size_t  size = TT_VMEM_HUGE_PAGE_SIZE;
+    tt_byte_t* data = (tt_byte_t*)tt_vmem_reserve(size);
+    tt_assert_and_check_return(data);
+    if (tt_vmem_commit(data, size))
+    {
+        tt_circular_buffer_t buffer;
+        tt_byte_t            in[] = "vmem";
+        tt_byte_t            out[8] = {0};
+        tt_circular_buffer_init(&buffer, data, size);
+        tt_circular_buffer_writ(&buffer, in, sizeof(in));
+        tt_circular_buffer_read(&buffer, out, sizeof(in));
+        tt_trace_d("circular buffer: %p, aligned: %d, read: %s", data, !((tt_size_t)data & (TT_VMEM_HUGE_PAGE_SIZE - 1)), out);
+        tt_circular_buffer_exit(&buffer);
+    }
+    tt_vmem_release(data, size);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tt_int_t tt_demo_vmem_main(tt_int_t argc, tt_char_t** argv)
+{
+    // print title
+    tt_print_title("demo vmem");
+
+    tt_trace_d("page size: %lu", tt_vmem_page_size());
+
+    tt_vmem_allocator_ref_t vmem = tt_vmem_allocator_init((tt_size_t)1 << 30);
+    tt_assert_and_check_return_val(vmem, -1);
+    tt_demo_vmem_vector(tt_null, "native", 100000000);
+    tt_demo_vmem_vector(tt_vmem_allocator(vmem), "vmem", 100000000);
+    tt_vmem_allocator_exit(vmem);
+
+    tt_demo_vmem_circular_buffer();
+
+    return 0;
+}
@@ -14,5 +14,6 @@
  * includes
  */
 #include "circular_buffer.h"
+#include "record_ring.h"
 
 #endif
\ No newline at end of file
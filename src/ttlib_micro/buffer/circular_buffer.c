@@ -7,11 +7,93 @@
  * @brief      circular_buffer.c file
  */
 
+// for memfd_create
+#define _GNU_SOURCE
+
 /*//////////////////////////////////////////////////////////////////////////////////////
 * includes
 */
 #include "circular_buffer.h"
+#include "../memory/vmem.h"
+#include "../platform/atomic.h"
+#include "../platform/futex.h"
+#include "../platform/time.h"
 #include "string.h"
+#include <sys/mman.h>
+#include <unistd.h>
+
+/// the spin count before parking on the futex
+#define TT_CIRCULAR_BUFFER_SPIN   (64)
+
+/// the offset of the index, avoid the division if the size is pow2
+static __tt_inline__ tt_size_t tt_circular_buffer_offset(tt_size_t size, tt_uint64_t idx)
+{
+	return (size & (size - 1)) ? (tt_size_t)(idx % size) : (tt_size_t)(idx & (size - 1));
+}
+
+/// map the same memfd pages twice back to back
+static tt_byte_t* tt_circular_buffer_mirror_init(tt_size_t size)
+{
+#ifdef MFD_CLOEXEC
+	tt_byte_t *data = tt_null;
+	tt_int_t   fd = -1;
+	tt_bool_t  ok = tt_false;
+	do
+	{
+		tt_check_break(size <= (~(tt_size_t)0) >> 1);
+
+		fd = memfd_create("tt_circular_buffer", MFD_CLOEXEC);
+		tt_check_break(fd >= 0);
+		tt_check_break(!ftruncate(fd, (off_t)size));
+
+		/// reserve the whole range, then replace the two halves with the same pages
+		data = (tt_byte_t*)mmap(tt_null, size << 1, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (data == (tt_byte_t*)MAP_FAILED)
+		{
+			data = tt_null;
+			break;
+		}
+		tt_check_break(mmap(data, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED);
+		tt_check_break(mmap(data + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED);
+
+		ok = tt_true;
+
+	} while (0);
+
+	/// the mappings keep the pages
+	if (fd >= 0) close(fd);
+	if (!ok && data)
+	{
+		munmap(data, size << 1);
+		data = tt_null;
+	}
+	return data;
+#else
+	return tt_null;
+#endif
+}
+
+/// init the data of the given size, mirror it if the size is aligned by the page size
+static tt_byte_t* tt_circular_buffer_data_init(tt_size_t size, tt_size_t* mode)
+{
+	tt_byte_t *data = tt_null;
+	if (!(size & (tt_vmem_page_size() - 1)) && (data = tt_circular_buffer_mirror_init(size)))
+	{
+		*mode = TT_CIRCULAR_BUFFER_MODE_MIRROR;
+		return data;
+	}
+
+	*mode = TT_CIRCULAR_BUFFER_MODE_MALLOC;
+	return (tt_byte_t*)tt_malloc(size);
+}
+
+static tt_void_t tt_circular_buffer_data_exit(tt_byte_t *data, tt_size_t size, tt_size_t mode)
+{
+	tt_check_return(data);
+
+	if (mode == TT_CIRCULAR_BUFFER_MODE_MIRROR) munmap(data, size << 1);
+	else if (mode == TT_CIRCULAR_BUFFER_MODE_MALLOC) tt_free(data);
+}
 
 /// cb is full?
 static tt_bool_t tt_circular_buffer_is_full(tt_circular_buffer_ref_t buff)
@@ -55,14 +137,14 @@ static tt_bool_t tt_cirular_buffer_writ_assign(tt_circular_buffer_ref_t buff, tt
 	tt_assert(tail && head && (min_size <= buff->size));
 	tt_check_return_val(min_size, tt_false);
 
-	if ((buff->size - (buff->w_idx % buff->size)) >= min_size)
+	if (buff->mode == TT_CIRCULAR_BUFFER_MODE_MIRROR || (buff->size - tt_circular_buffer_offset(buff->size, buff->w_idx)) >= min_size)
 	{
 		*tail = min_size;
 		*head = 0;
 	}
 	else
 	{
-		*tail = buff->size - (buff->w_idx % buff->size);
+		*tail = buff->size - tt_circular_buffer_offset(buff->size, buff->w_idx);
 		*head = min_size - *tail;
 	}
 
@@ -74,14 +156,14 @@ static tt_bool_t tt_cirular_buffer_read_assign(tt_circular_buffer_ref_t buff, tt
 	tt_assert(tail && head);
 	tt_check_return_val(min_size, tt_false);
 
-	if ((buff->size - (buff->r_idx % buff->size)) >= min_size)
+	if (buff->mode == TT_CIRCULAR_BUFFER_MODE_MIRROR || (buff->size - tt_circular_buffer_offset(buff->size, buff->r_idx)) >= min_size)
 	{
 		*tail = min_size;
 		*head = 0;
 	}
 	else
 	{
-		*tail = buff->size - (buff->r_idx % buff->size);
+		*tail = buff->size - tt_circular_buffer_offset(buff->size, buff->r_idx);
 		*head = min_size - *tail;
 	}
 
@@ -96,14 +178,29 @@ tt_bool_t tt_circular_buffer_init(tt_circular_buffer_ref_t buff, tt_byte_t *data
 	buff->w_idx = 0;
 	buff->data = data;
 	buff->size = size;
+	buff->mode = TT_CIRCULAR_BUFFER_MODE_USER;
 
 	return tt_true;
 }
 
+tt_bool_t tt_circular_buffer_init_mirror(tt_circular_buffer_ref_t buff, tt_size_t size)
+{
+	tt_assert(buff);
+	tt_check_return_val(size, tt_false);
+
+	buff->r_idx = 0;
+	buff->w_idx = 0;
+	buff->size = size;
+	buff->data = tt_circular_buffer_data_init(size, &buff->mode);
+
+	return buff->data ? tt_true : tt_false;
+}
+
 tt_bool_t tt_circular_buffer_exit(tt_circular_buffer_ref_t buff)
 {
 	tt_assert(buff);
 
+	tt_circular_buffer_data_exit(buff->data, buff->size, buff->mode);
 	buff->r_idx = 0;
 	buff->w_idx = 0;
 	buff->data = tt_null;
@@ -125,14 +222,14 @@ tt_uint64_t tt_circular_buffer_writ_cover(tt_circular_buffer_ref_t buff, tt_byte
 		/// 1th
 		tt_cirular_buffer_writ_assign(buff, buff->size, &tail_size, &head_size);
 		/// tail write done
-		memcpy(buff->data + buff->w_idx % buff->size, &in[size - valid_size], tail_size);
+		memcpy(buff->data + tt_circular_buffer_offset(buff->size, buff->w_idx), &in[size - valid_size], tail_size);
 		/// head write done
 		if (head_size) memcpy(buff->data, &in[size - valid_size] + tail_size, head_size);
 
 		/// 2th TODO need to opt
 		tt_cirular_buffer_writ_assign(buff, size % buff->size, &tail_size, &head_size);
 		/// tail write done
-		memcpy(buff->data + buff->w_idx % buff->size, &in[size - size % buff->size], tail_size);
+		memcpy(buff->data + tt_circular_buffer_offset(buff->size, buff->w_idx), &in[size - size % buff->size], tail_size);
 		/// head write done
 		if (head_size) memcpy(buff->data, &in[size - size % buff->size] + tail_size, head_size);
 
@@ -147,7 +244,7 @@ tt_uint64_t tt_circular_buffer_writ_cover(tt_circular_buffer_ref_t buff, tt_byte
 		tt_cirular_buffer_writ_assign(buff, size, &tail_size, &head_size);
 
 		/// tail write done
-		memcpy(buff->data + buff->w_idx % buff->size, in, tail_size);
+		memcpy(buff->data + tt_circular_buffer_offset(buff->size, buff->w_idx), in, tail_size);
 		/// head write done
 		if (head_size) memcpy(buff->data, in + tail_size, head_size);
 
@@ -171,7 +268,7 @@ tt_uint64_t tt_circular_buffer_writ(tt_circular_buffer_ref_t buff, tt_byte_t *in
 		tt_cirular_buffer_writ_assign(buff, min_size, &tail_size, &head_size);
 
 		/// tail write done
-		memcpy(buff->data + buff->w_idx % buff->size, in, tail_size);
+		memcpy(buff->data + tt_circular_buffer_offset(buff->size, buff->w_idx), in, tail_size);
 		/// head write done
 		if (head_size) memcpy(buff->data, in + tail_size, head_size);
 
@@ -198,7 +295,7 @@ tt_uint64_t tt_circular_buffer_read(tt_circular_buffer_ref_t buff, tt_byte_t *ou
 		tt_cirular_buffer_read_assign(buff, min_size, &tail_size, &head_size);
 
 		/// tail read done
-		memcpy(out, buff->data + buff->r_idx % buff->size, tail_size);
+		memcpy(out, buff->data + tt_circular_buffer_offset(buff->size, buff->r_idx), tail_size);
 		/// head read done
 		if (head_size) memcpy(out + tail_size, buff->data, head_size);
 
@@ -213,3 +310,323 @@ tt_uint64_t tt_circular_buffer_read(tt_circular_buffer_ref_t buff, tt_byte_t *ou
 
 	return min_size;
 }
+
+/*! assign the regions of the given bytes at the index, split at the end of the buffer
+*
+* @param data, real buffer start addr
+* @param buff_size, real buffer size
+* @param mode, the data mode, never split if it is mirrored
+* @param idx, read or write index
+* @param size, the bytes, not greater than buff_size
+* @param regions, the two regions
+* @return count of the regions
+*/
+static tt_size_t tt_circular_buffer_regions_assign(tt_byte_t *data, tt_size_t buff_size, tt_size_t mode, tt_uint64_t idx, tt_size_t size, tt_circular_buffer_region_t regions[2])
+{
+	tt_check_return_val(size, 0);
+
+	tt_size_t offset = tt_circular_buffer_offset(buff_size, idx);
+	tt_size_t tail_size = mode == TT_CIRCULAR_BUFFER_MODE_MIRROR ? size : tt_min(buff_size - offset, size);
+
+	regions[0].data = data + offset;
+	regions[0].size = tail_size;
+	tt_check_return_val(size > tail_size, 1);
+
+	regions[1].data = data;
+	regions[1].size = size - tail_size;
+	return 2;
+}
+
+tt_size_t tt_circular_buffer_writ_reserve(tt_circular_buffer_ref_t buff, tt_size_t size, tt_circular_buffer_region_t regions[2])
+{
+	tt_assert(regions);
+
+	size = (tt_size_t)tt_min(tt_circular_buffer_left(buff), size);
+	return tt_circular_buffer_regions_assign(buff->data, buff->size, buff->mode, buff->w_idx, size, regions);
+}
+
+tt_void_t tt_circular_buffer_writ_commit(tt_circular_buffer_ref_t buff, tt_size_t size)
+{
+	tt_assert(size <= tt_circular_buffer_left(buff));
+
+	/// update index
+	buff->w_idx += size;
+}
+
+tt_size_t tt_circular_buffer_read_peek(tt_circular_buffer_ref_t buff, tt_size_t size, tt_circular_buffer_region_t regions[2])
+{
+	tt_assert(regions);
+
+	size = (tt_size_t)tt_min(tt_circular_buffer_used(buff), size);
+	return tt_circular_buffer_regions_assign(buff->data, buff->size, buff->mode, buff->r_idx, size, regions);
+}
+
+tt_void_t tt_circular_buffer_read_consume(tt_circular_buffer_ref_t buff, tt_size_t size)
+{
+	tt_assert(size <= tt_circular_buffer_used(buff));
+
+	/// update index
+	buff->r_idx += size;
+}
+
+/// spsc left size for the producer, reload the read index only if the cached one says it is not enough
+static tt_uint64_t tt_circular_buffer_spsc_left(tt_circular_buffer_spsc_ref_t buff, tt_uint64_t w_idx, tt_size_t size)
+{
+	tt_uint64_t left = buff->size - (w_idx - buff->r_idx_cache);
+	if (left < size)
+	{
+		buff->r_idx_cache = atomic_load_explicit(&buff->r_idx, TT_ATOMIC_ACQUIRE);
+		left = buff->size - (w_idx - buff->r_idx_cache);
+	}
+	return left;
+}
+
+/// spsc used size for the consumer, reload the write index only if the cached one says it is not enough
+static tt_uint64_t tt_circular_buffer_spsc_used(tt_circular_buffer_spsc_ref_t buff, tt_uint64_t r_idx, tt_size_t size)
+{
+	tt_uint64_t used = buff->w_idx_cache - r_idx;
+	if (used < size)
+	{
+		buff->w_idx_cache = atomic_load_explicit(&buff->w_idx, TT_ATOMIC_ACQUIRE);
+		used = buff->w_idx_cache - r_idx;
+	}
+	return used;
+}
+
+/// spsc publish the write index, wake the consumer only if it is parked
+static tt_void_t tt_circular_buffer_spsc_writ_publish(tt_circular_buffer_spsc_ref_t buff, tt_uint64_t w_idx)
+{
+	atomic_store_explicit(&buff->w_idx, w_idx, TT_ATOMIC_RELEASE);
+
+	/// the consumer stores r_parked and then loads w_idx, so one of us must see the other
+	atomic_thread_fence(TT_ATOMIC_SEQ_CST);
+	if (atomic_load_explicit(&buff->r_parked, TT_ATOMIC_RELAXED))
+	{
+		atomic_fetch_add_explicit(&buff->w_event, 1, TT_ATOMIC_RELEASE);
+		tt_futex_wake(&buff->w_event, 1);
+	}
+}
+
+/// spsc publish the read index, wake the producer only if it is parked
+static tt_void_t tt_circular_buffer_spsc_read_publish(tt_circular_buffer_spsc_ref_t buff, tt_uint64_t r_idx)
+{
+	atomic_store_explicit(&buff->r_idx, r_idx, TT_ATOMIC_RELEASE);
+
+	/// the producer stores w_parked and then loads r_idx, so one of us must see the other
+	atomic_thread_fence(TT_ATOMIC_SEQ_CST);
+	if (atomic_load_explicit(&buff->w_parked, TT_ATOMIC_RELAXED))
+	{
+		atomic_fetch_add_explicit(&buff->r_event, 1, TT_ATOMIC_RELEASE);
+		tt_futex_wake(&buff->r_event, 1);
+	}
+}
+
+/// spsc the left time (ms) of the deadline, -1: infinity, 0: timeout
+static tt_long_t tt_circular_buffer_spsc_timeout(tt_hong_t deadline)
+{
+	tt_check_return_val(deadline >= 0, -1);
+
+	tt_hong_t now = tt_mclock();
+	return deadline > now ? (tt_long_t)(deadline - now) : 0;
+}
+
+tt_bool_t tt_circular_buffer_spsc_init(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *data, tt_size_t size)
+{
+	tt_assert(buff);
+	tt_check_return_val(data && size, tt_false);
+
+	buff->data = data;
+	buff->size = size;
+	buff->mode = TT_CIRCULAR_BUFFER_MODE_USER;
+	buff->r_idx_cache = 0;
+	buff->w_idx_cache = 0;
+	atomic_init(&buff->w_idx, 0);
+	atomic_init(&buff->r_idx, 0);
+	atomic_init(&buff->w_event, 0);
+	atomic_init(&buff->r_event, 0);
+	atomic_init(&buff->w_parked, 0);
+	atomic_init(&buff->r_parked, 0);
+
+	return tt_true;
+}
+
+tt_bool_t tt_circular_buffer_spsc_init_mirror(tt_circular_buffer_spsc_ref_t buff, tt_size_t size)
+{
+	tt_assert(buff);
+	tt_check_return_val(size, tt_false);
+
+	buff->size = size;
+	buff->data = tt_circular_buffer_data_init(size, &buff->mode);
+	buff->r_idx_cache = 0;
+	buff->w_idx_cache = 0;
+	atomic_init(&buff->w_idx, 0);
+	atomic_init(&buff->r_idx, 0);
+	atomic_init(&buff->w_event, 0);
+	atomic_init(&buff->r_event, 0);
+	atomic_init(&buff->w_parked, 0);
+	atomic_init(&buff->r_parked, 0);
+
+	return buff->data ? tt_true : tt_false;
+}
+
+tt_bool_t tt_circular_buffer_spsc_exit(tt_circular_buffer_spsc_ref_t buff)
+{
+	tt_assert(buff);
+
+	tt_circular_buffer_data_exit(buff->data, buff->size, buff->mode);
+	buff->data = tt_null;
+	buff->size = 0;
+	buff->r_idx_cache = 0;
+	buff->w_idx_cache = 0;
+	atomic_store_explicit(&buff->w_idx, 0, TT_ATOMIC_RELAXED);
+	atomic_store_explicit(&buff->r_idx, 0, TT_ATOMIC_RELAXED);
+
+	return tt_true;
+}
+
+tt_uint64_t tt_circular_buffer_spsc_writ(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *in, tt_size_t size)
+{
+	tt_circular_buffer_region_t regions[2];
+	tt_size_t i = 0, n = 0, writ_size = 0;
+
+	/// only the producer stores the write index
+	tt_uint64_t w_idx = atomic_load_explicit(&buff->w_idx, TT_ATOMIC_RELAXED);
+	tt_uint64_t left = tt_circular_buffer_spsc_left(buff, w_idx, size);
+	size = (tt_size_t)tt_min(left, size);
+
+	/// tail and head write done
+	n = tt_circular_buffer_regions_assign(buff->data, buff->size, buff->mode, w_idx, size, regions);
+	for (i = 0; i < n; i++)
+	{
+		memcpy(regions[i].data, in + writ_size, regions[i].size);
+		writ_size += regions[i].size;
+	}
+
+	/// publish the data to the consumer
+	if (size) tt_circular_buffer_spsc_writ_publish(buff, w_idx + size);
+
+	return size;
+}
+
+tt_uint64_t tt_circular_buffer_spsc_read(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *out, tt_size_t size)
+{
+	tt_circular_buffer_region_t regions[2];
+	tt_size_t i = 0, n = 0, read_size = 0;
+
+	/// only the consumer stores the read index
+	tt_uint64_t r_idx = atomic_load_explicit(&buff->r_idx, TT_ATOMIC_RELAXED);
+	tt_uint64_t used = tt_circular_buffer_spsc_used(buff, r_idx, size);
+	size = (tt_size_t)tt_min(used, size);
+
+	/// tail and head read done
+	n = tt_circular_buffer_regions_assign(buff->data, buff->size, buff->mode, r_idx, size, regions);
+	for (i = 0; i < n; i++)
+	{
+		memcpy(out + read_size, regions[i].data, regions[i].size);
+		read_size += regions[i].size;
+	}
+
+	/// release the space to the producer
+	if (size) tt_circular_buffer_spsc_read_publish(buff, r_idx + size);
+
+	return size;
+}
+
+tt_size_t tt_circular_buffer_spsc_writ_reserve(tt_circular_buffer_spsc_ref_t buff, tt_size_t size, tt_circular_buffer_region_t regions[2])
+{
+	tt_uint64_t w_idx = atomic_load_explicit(&buff->w_idx, TT_ATOMIC_RELAXED);
+	tt_uint64_t left = tt_circular_buffer_spsc_left(buff, w_idx, size);
+	size = (tt_size_t)tt_min(left, size);
+
+	return tt_circular_buffer_regions_assign(buff->data, buff->size, buff->mode, w_idx, size, regions);
+}
+
+tt_void_t tt_circular_buffer_spsc_writ_commit(tt_circular_buffer_spsc_ref_t buff, tt_size_t size)
+{
+	tt_uint64_t w_idx = atomic_load_explicit(&buff->w_idx, TT_ATOMIC_RELAXED);
+	tt_assert(size <= buff->size - (w_idx - buff->r_idx_cache));
+
+	/// publish the data to the consumer
+	tt_circular_buffer_spsc_writ_publish(buff, w_idx + size);
+}
+
+tt_size_t tt_circular_buffer_spsc_read_peek(tt_circular_buffer_spsc_ref_t buff, tt_size_t size, tt_circular_buffer_region_t regions[2])
+{
+	tt_uint64_t r_idx = atomic_load_explicit(&buff->r_idx, TT_ATOMIC_RELAXED);
+	tt_uint64_t used = tt_circular_buffer_spsc_used(buff, r_idx, size);
+	size = (tt_size_t)tt_min(used, size);
+
+	return tt_circular_buffer_regions_assign(buff->data, buff->size, buff->mode, r_idx, size, regions);
+}
+
+tt_void_t tt_circular_buffer_spsc_read_consume(tt_circular_buffer_spsc_ref_t buff, tt_size_t size)
+{
+	tt_uint64_t r_idx = atomic_load_explicit(&buff->r_idx, TT_ATOMIC_RELAXED);
+	tt_assert(size <= buff->w_idx_cache - r_idx);
+
+	/// release the space to the producer
+	tt_circular_buffer_spsc_read_publish(buff, r_idx + size);
+}
+
+tt_uint64_t tt_circular_buffer_spsc_read_wait(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *out, tt_size_t size, tt_long_t timeout)
+{
+	tt_uint64_t read_size = 0;
+	tt_size_t   spin = TT_CIRCULAR_BUFFER_SPIN;
+	tt_hong_t   deadline = timeout < 0 ? -1 : tt_mclock() + timeout;
+	while (size && !(read_size = tt_circular_buffer_spsc_read(buff, out, size)))
+	{
+		/// spin briefly
+		if (spin)
+		{
+			spin--;
+			continue;
+		}
+
+		/// timeout?
+		tt_long_t left = tt_circular_buffer_spsc_timeout(deadline);
+		tt_check_break(left);
+
+		/// park only if it is still empty after announcing it
+		tt_uint32_t event = atomic_load_explicit(&buff->w_event, TT_ATOMIC_ACQUIRE);
+		atomic_store_explicit(&buff->r_parked, 1, TT_ATOMIC_RELAXED);
+		atomic_thread_fence(TT_ATOMIC_SEQ_CST);
+		if (atomic_load_explicit(&buff->w_idx, TT_ATOMIC_RELAXED) == atomic_load_explicit(&buff->r_idx, TT_ATOMIC_RELAXED))
+			tt_futex_wait(&buff->w_event, event, left);
+		atomic_store_explicit(&buff->r_parked, 0, TT_ATOMIC_RELAXED);
+	}
+
+	return read_size;
+}
+
+tt_uint64_t tt_circular_buffer_spsc_writ_wait(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *in, tt_size_t size, tt_long_t timeout)
+{
+	tt_assert_and_check_return_val(size <= buff->size, 0);
+
+	/// only the producer stores the write index
+	tt_uint64_t w_idx = atomic_load_explicit(&buff->w_idx, TT_ATOMIC_RELAXED);
+	tt_size_t   spin = TT_CIRCULAR_BUFFER_SPIN;
+	tt_hong_t   deadline = timeout < 0 ? -1 : tt_mclock() + timeout;
+	while (tt_circular_buffer_spsc_left(buff, w_idx, size) < size)
+	{
+		/// spin briefly
+		if (spin)
+		{
+			spin--;
+			continue;
+		}
+
+		/// timeout?
+		tt_long_t left = tt_circular_buffer_spsc_timeout(deadline);
+		if (!left) return 0;
+
+		/// park only if it is still full after announcing it
+		tt_uint32_t event = atomic_load_explicit(&buff->r_event, TT_ATOMIC_ACQUIRE);
+		atomic_store_explicit(&buff->w_parked, 1, TT_ATOMIC_RELAXED);
+		atomic_thread_fence(TT_ATOMIC_SEQ_CST);
+		if (buff->size - (w_idx - atomic_load_explicit(&buff->r_idx, TT_ATOMIC_RELAXED)) < size)
+			tt_futex_wait(&buff->r_event, event, left);
+		atomic_store_explicit(&buff->w_parked, 0, TT_ATOMIC_RELAXED);
+	}
+
+	return tt_circular_buffer_spsc_writ(buff, in, size);
+}
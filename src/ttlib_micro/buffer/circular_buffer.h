@@ -23,15 +23,79 @@ __tt_extern_c_enter__
 /* //////////////////////////////////////////////////////////////////////////////////////
  * type
  */
+
+/// the circular buffer data mode
+typedef enum __tt_circular_buffer_mode_e
+{
+	TT_CIRCULAR_BUFFER_MODE_USER    = 0     //!< the user real buffer
+,	TT_CIRCULAR_BUFFER_MODE_MALLOC  = 1     //!< the buffer is allocated by tt_malloc, split at the end
+,	TT_CIRCULAR_BUFFER_MODE_MIRROR  = 2     //!< the same pages are mapped twice, never split
+
+}tt_circular_buffer_mode_e;
+
 typedef struct __tt_circular_buffer_t
 {
 	tt_uint64_t r_idx;
 	tt_uint64_t w_idx;
 	tt_size_t   size;
 	tt_byte_t   *data;
+	tt_size_t   mode;
 
 }tt_circular_buffer_t, *tt_circular_buffer_ref_t;
 
+/*! the single-producer/single-consumer circular buffer
+ *
+ * only one thread writes and only one thread reads without any lock, the
+ * indices are published by acquire/release atomics on the separate cache lines,
+ * and each side caches the index of the other side, so the shared index is
+ * loaded only if the cached one says the buffer is full or empty.
+ *
+ * it never blocks or traces, writ and read return 0 if it is full or empty,
+ * and writ_wait and read_wait spin briefly and then park on the futex, the
+ * other side wakes them only if they are parked, so the uncontended path costs
+ * no syscalls.
+ *
+ * @note it is aligned by TT_CPU_CACHELINE, use tt_allocator_align_malloc if it is allocated dynamically
+ */
+typedef struct __tt_circular_buffer_spsc_t
+{
+	// the readonly fields
+	tt_size_t   size;
+	tt_byte_t   *data;
+	tt_size_t   mode;
+
+	// the producer, the write index and the cached read index
+	__tt_aligned__(TT_CPU_CACHELINE) _Atomic tt_uint64_t w_idx;
+	tt_uint64_t r_idx_cache;
+
+	// the consumer, the read index and the cached write index
+	__tt_aligned__(TT_CPU_CACHELINE) _Atomic tt_uint64_t r_idx;
+	tt_uint64_t w_idx_cache;
+
+	// the futex events and the parked flags, they are written only when parking and waking
+	__tt_aligned__(TT_CPU_CACHELINE) _Atomic tt_uint32_t w_event;
+	_Atomic tt_uint32_t r_event;
+	_Atomic tt_uint32_t w_parked;
+	_Atomic tt_uint32_t r_parked;
+
+}tt_circular_buffer_spsc_t, *tt_circular_buffer_spsc_ref_t;
+
+/*! the contiguous region of the circular buffer for zero-copy writing and reading
+ *
+ * <pre>
+ * data: |region[1] ...|            |region[0] .........|
+ *       0                          idx % size           size
+ * </pre>
+ *
+ * the reserved or peeked bytes are split into two regions at the end of the buffer
+ */
+typedef struct __tt_circular_buffer_region_t
+{
+	tt_byte_t   *data;
+	tt_size_t   size;
+
+}tt_circular_buffer_region_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -44,7 +108,25 @@ typedef struct __tt_circular_buffer_t
  */
 tt_bool_t            tt_circular_buffer_init(tt_circular_buffer_ref_t buff, tt_byte_t *data, tt_size_t size);
 
-/*! circular buffer exit
+/*! circular buffer init with the mirrored data
+ *
+ * <pre>
+ * data: |page0|page1| ... |pageN|page0|page1| ... |pageN|
+ *       |<------ size ------->|<------ mirror ------->|
+ * </pre>
+ *
+ * the same memfd pages are mapped twice back to back, so the bytes from any
+ * index are always contiguous and the reserved or peeked bytes are one region.
+ *
+ * the data is allocated by tt_malloc and split at the end as before if the
+ * size is not aligned by the page size or the mapping fails.
+ *
+ * @param buffer
+ * @param size,      real buffer size, aligned by tt_vmem_page_size() for mirroring
+ */
+tt_bool_t            tt_circular_buffer_init_mirror(tt_circular_buffer_ref_t buff, tt_size_t size);
+
+/*! circular buffer exit, free the data if it is allocated by init_mirror
  *
  * @param buffer
  */
@@ -77,6 +159,138 @@ tt_uint64_t          tt_circular_buffer_writ(tt_circular_buffer_ref_t buff, tt_b
 */
 tt_uint64_t          tt_circular_buffer_writ_cover(tt_circular_buffer_ref_t buff, tt_byte_t *in, tt_size_t size);
 
+/*! circular buffer writ reserve, the producer serializes into the regions directly
+ *
+ * @code
+ *
+ * tt_circular_buffer_region_t regions[2];
+ * tt_size_t n = tt_circular_buffer_writ_reserve(&buff, size, regions);
+ * for (i = 0; i < n; i++) serialize(regions[i].data, regions[i].size);
+ * tt_circular_buffer_writ_commit(&buff, size);
+ *
+ * @endcode
+ *
+ * @param buffer
+ * @param size,       size of user want to write, it is clipped to the left size
+ * @param regions,    the two regions of the reserved bytes
+ * @return            count of the regions, 0 if full
+ */
+tt_size_t            tt_circular_buffer_writ_reserve(tt_circular_buffer_ref_t buff, tt_size_t size, tt_circular_buffer_region_t regions[2]);
+
+/*! circular buffer writ commit, make the written bytes of the reserved regions readable
+ *
+ * @param buffer
+ * @param size,       size of user have written, not greater than the reserved size
+ */
+tt_void_t            tt_circular_buffer_writ_commit(tt_circular_buffer_ref_t buff, tt_size_t size);
+
+/*! circular buffer read peek, the consumer parses the regions in place
+ *
+ * @param buffer
+ * @param size,       size of user want to read, it is clipped to the used size
+ * @param regions,    the two regions of the peeked bytes
+ * @return            count of the regions, 0 if empty
+ */
+tt_size_t            tt_circular_buffer_read_peek(tt_circular_buffer_ref_t buff, tt_size_t size, tt_circular_buffer_region_t regions[2]);
+
+/*! circular buffer read consume, free the parsed bytes of the peeked regions
+ *
+ * @param buffer
+ * @param size,       size of user have read, not greater than the peeked size
+ */
+tt_void_t            tt_circular_buffer_read_consume(tt_circular_buffer_ref_t buff, tt_size_t size);
+
+/*! spsc circular buffer init, it is called before the producer and the consumer are started
+ *
+ * @param buffer
+ * @param data,      user real buffer start addr
+ * @param size,      real buffer size
+ */
+tt_bool_t            tt_circular_buffer_spsc_init(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *data, tt_size_t size);
+
+/*! spsc circular buffer init with the mirrored data, see tt_circular_buffer_init_mirror
+ *
+ * @param buffer
+ * @param size,      real buffer size, aligned by tt_vmem_page_size() for mirroring
+ */
+tt_bool_t            tt_circular_buffer_spsc_init_mirror(tt_circular_buffer_spsc_ref_t buff, tt_size_t size);
+
+/*! spsc circular buffer exit, it is called after the producer and the consumer are stopped
+ *
+ * @param buffer
+ */
+tt_bool_t            tt_circular_buffer_spsc_exit(tt_circular_buffer_spsc_ref_t buff);
+
+/*! spsc circular buffer read, only called by the consumer
+ *
+ * @param buffer
+ * @param out,       user real buff for read
+ * @param size,      size of user real buff
+ * @return           size of user have read, 0 if empty
+ */
+tt_uint64_t          tt_circular_buffer_spsc_read(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *out, tt_size_t size);
+
+/*! spsc circular buffer writ, only called by the producer, not cover if full
+*
+* @param buffer
+* @param in,         user real buff for write
+* @param size,       size of user write buff
+* @return            size of user have write, 0 if full
+*/
+tt_uint64_t          tt_circular_buffer_spsc_writ(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *in, tt_size_t size);
+
+/*! spsc circular buffer read wait, only called by the consumer, wait until it is not empty
+ *
+ * @param buffer
+ * @param out,       user real buff for read
+ * @param size,      size of user real buff
+ * @param timeout,   the timeout (ms), -1: infinity
+ * @return           size of user have read, 0 if timeout
+ */
+tt_uint64_t          tt_circular_buffer_spsc_read_wait(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *out, tt_size_t size, tt_long_t timeout);
+
+/*! spsc circular buffer writ wait, only called by the producer, wait until the whole buff can be written
+*
+* @param buffer
+* @param in,         user real buff for write
+* @param size,       size of user write buff, not greater than the buffer size
+* @param timeout,    the timeout (ms), -1: infinity
+* @return            size of user have write, 0 if timeout
+*/
+tt_uint64_t          tt_circular_buffer_spsc_writ_wait(tt_circular_buffer_spsc_ref_t buff, tt_byte_t *in, tt_size_t size, tt_long_t timeout);
+
+/*! spsc circular buffer writ reserve, only called by the producer
+ *
+ * @param buffer
+ * @param size,       size of user want to write, it is clipped to the left size
+ * @param regions,    the two regions of the reserved bytes
+ * @return            count of the regions, 0 if full
+ */
+tt_size_t            tt_circular_buffer_spsc_writ_reserve(tt_circular_buffer_spsc_ref_t buff, tt_size_t size, tt_circular_buffer_region_t regions[2]);
+
+/*! spsc circular buffer writ commit, publish the written bytes to the consumer
+ *
+ * @param buffer
+ * @param size,       size of user have written, not greater than the reserved size
+ */
+tt_void_t            tt_circular_buffer_spsc_writ_commit(tt_circular_buffer_spsc_ref_t buff, tt_size_t size);
+
+/*! spsc circular buffer read peek, only called by the consumer
+ *
+ * @param buffer
+ * @param size,       size of user want to read, it is clipped to the used size
+ * @param regions,    the two regions of the peeked bytes
+ * @return            count of the regions, 0 if empty
+ */
+tt_size_t            tt_circular_buffer_spsc_read_peek(tt_circular_buffer_spsc_ref_t buff, tt_size_t size, tt_circular_buffer_region_t regions[2]);
+
+/*! spsc circular buffer read consume, release the read bytes to the producer
+ *
+ * @param buffer
+ * @param size,       size of user have read, not greater than the peeked size
+ */
+tt_void_t            tt_circular_buffer_spsc_read_consume(tt_circular_buffer_spsc_ref_t buff, tt_size_t size);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,209 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       record_ring.c
+ * @ingroup    buffer
+ * @author     tango
+ * @date       2021-08-08
+ * @brief      record_ring.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_BUFFER_RECORD_RING"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "record_ring.h"
+#include "string.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the head size
+#define TT_RECORD_RING_HEAD_SIZE            tt_align(sizeof(tt_record_ring_head_t), TT_RECORD_RING_ALIGN)
+
+// the record size of the payload size
+#define tt_record_ring_size(size)           (TT_RECORD_RING_HEAD_SIZE + tt_align(size, TT_RECORD_RING_ALIGN))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the record type
+typedef enum __tt_record_ring_type_e
+{
+    TT_RECORD_RING_TYPE_DATA        = 0     //!< the payload
+,   TT_RECORD_RING_TYPE_PAD         = 1     //!< the padding to the end of the buffer
+
+}tt_record_ring_type_e;
+
+// the record head type
+typedef struct __tt_record_ring_head_t
+{
+    // the payload size
+    tt_uint32_t         size;
+
+    // the record type
+    tt_uint32_t         type;
+
+}tt_record_ring_head_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+// the contiguous bytes at the position of the regions, tt_null if they are split or not enough
+static tt_byte_t* tt_record_ring_at(tt_circular_buffer_region_t const* regions, tt_size_t n, tt_size_t pos, tt_size_t size)
+{
+    if (n > 0 && pos + size <= regions[0].size) return regions[0].data + pos;
+    if (n > 1 && pos >= regions[0].size && pos + size <= regions[0].size + regions[1].size) return regions[1].data + (pos - regions[0].size);
+    return tt_null;
+}
+
+// write the record after the written bytes, it is published by the caller
+static tt_bool_t tt_record_ring_push_done(tt_record_ring_ref_t ring, tt_size_t* writ, tt_byte_t const* data, tt_size_t size)
+{
+    tt_circular_buffer_region_t regions[2];
+    tt_check_return_val(size <= 0xffffffff && tt_record_ring_size(size) <= ring->buff.size, tt_false);
+
+    tt_size_t  need = tt_record_ring_size(size);
+    tt_size_t  n = tt_circular_buffer_spsc_writ_reserve(&ring->buff, *writ + need, regions);
+    tt_byte_t* p = tt_record_ring_at(regions, n, *writ, need);
+    if (!p)
+    {
+        // it is full if the record is not at the end of the buffer
+        tt_check_return_val(n && *writ < regions[0].size, tt_false);
+
+        // skip the rest of the buffer by the padding record, and write it at the head
+        tt_size_t pad = regions[0].size - *writ;
+        n = tt_circular_buffer_spsc_writ_reserve(&ring->buff, *writ + pad + need, regions);
+        p = n > 1 ? tt_record_ring_at(regions, n, *writ + pad, need) : tt_null;
+        tt_check_return_val(p, tt_false);
+
+        tt_record_ring_head_t* head = (tt_record_ring_head_t*)(regions[0].data + *writ);
+        head->size = (tt_uint32_t)(pad - TT_RECORD_RING_HEAD_SIZE);
+        head->type = TT_RECORD_RING_TYPE_PAD;
+        *writ += pad;
+    }
+
+    tt_record_ring_head_t* head = (tt_record_ring_head_t*)p;
+    head->size = (tt_uint32_t)size;
+    head->type = TT_RECORD_RING_TYPE_DATA;
+    if (size) memcpy(p + TT_RECORD_RING_HEAD_SIZE, data, size);
+    *writ += need;
+    return tt_true;
+}
+
+// read the record after the read bytes in place, it is released by the caller
+static tt_byte_t const* tt_record_ring_pop_done(tt_record_ring_ref_t ring, tt_size_t* read, tt_size_t* size)
+{
+    tt_circular_buffer_region_t regions[2];
+    while (1)
+    {
+        tt_size_t              n = tt_circular_buffer_spsc_read_peek(&ring->buff, *read + TT_RECORD_RING_HEAD_SIZE, regions);
+        tt_record_ring_head_t* head = (tt_record_ring_head_t*)tt_record_ring_at(regions, n, *read, TT_RECORD_RING_HEAD_SIZE);
+        tt_check_return_val(head, tt_null);
+
+        // skip the padding
+        if (head->type == TT_RECORD_RING_TYPE_PAD)
+        {
+            *read += TT_RECORD_RING_HEAD_SIZE + head->size;
+            continue;
+        }
+
+        // the producer publishes the whole record
+        tt_size_t  need = tt_record_ring_size(head->size);
+        n = tt_circular_buffer_spsc_read_peek(&ring->buff, *read + need, regions);
+        tt_byte_t* p = tt_record_ring_at(regions, n, *read, need);
+        tt_assert_and_check_return_val(p, tt_null);
+
+        *size = head->size;
+        *read += need;
+        return p + TT_RECORD_RING_HEAD_SIZE;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_bool_t tt_record_ring_init(tt_record_ring_ref_t ring, tt_size_t size)
+{
+    tt_assert_and_check_return_val(ring, tt_false);
+
+    // the head is never split if the buffer size is aligned
+    size = tt_align(size, TT_RECORD_RING_ALIGN);
+    tt_check_return_val(size >= TT_RECORD_RING_HEAD_SIZE, tt_false);
+
+    return tt_circular_buffer_spsc_init_mirror(&ring->buff, size);
+}
+
+tt_void_t tt_record_ring_exit(tt_record_ring_ref_t ring)
+{
+    tt_assert_and_check_return(ring);
+
+    tt_circular_buffer_spsc_exit(&ring->buff);
+}
+
+tt_bool_t tt_record_ring_push(tt_record_ring_ref_t ring, tt_byte_t const* data, tt_size_t size)
+{
+    return tt_record_ring_push_n(ring, &data, &size, 1) == 1;
+}
+
+tt_size_t tt_record_ring_push_n(tt_record_ring_ref_t ring, tt_byte_t const** datas, tt_size_t const* sizes, tt_size_t count)
+{
+    tt_assert(ring && datas && sizes);
+
+    tt_size_t i = 0;
+    tt_size_t writ = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (!tt_record_ring_push_done(ring, &writ, datas[i], sizes[i])) break;
+    }
+
+    // publish them once
+    if (writ) tt_circular_buffer_spsc_writ_commit(&ring->buff, writ);
+    return i;
+}
+
+tt_long_t tt_record_ring_pop(tt_record_ring_ref_t ring, tt_byte_t* data, tt_size_t maxn, tt_size_t* size)
+{
+    tt_assert(ring && size);
+
+    // empty?
+    tt_size_t        read = 0;
+    tt_byte_t const* p = tt_record_ring_pop_done(ring, &read, size);
+    tt_check_return_val(p, 0);
+
+    // the buffer is too small, keep the record
+    tt_check_return_val(*size <= maxn, -1);
+
+    if (*size) memcpy(data, p, *size);
+    tt_circular_buffer_spsc_read_consume(&ring->buff, read);
+    return 1;
+}
+
+tt_size_t tt_record_ring_pop_n(tt_record_ring_ref_t ring, tt_record_ring_func_t func, tt_cpointer_t priv, tt_size_t count)
+{
+    tt_assert(ring && func);
+
+    tt_size_t i = 0;
+    tt_size_t read = 0;
+    tt_size_t size = 0;
+    for (i = 0; i < count; i++)
+    {
+        tt_byte_t const* p = tt_record_ring_pop_done(ring, &read, &size);
+        tt_check_break(p);
+
+        func(p, size, priv);
+    }
+
+    // release them once
+    if (read) tt_circular_buffer_spsc_read_consume(&ring->buff, read);
+    return i;
+}
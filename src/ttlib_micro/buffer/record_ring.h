@@ -0,0 +1,137 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       record_ring.h
+ * @ingroup    buffer
+ * @author     tango
+ * @date       2021-08-08
+ * @brief      record_ring.h file
+ */
+
+#ifndef TT_BUFFER_RECORD_RING_H
+#define TT_BUFFER_RECORD_RING_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "circular_buffer.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the record alignment, the head and the payload are aligned by it
+#define TT_RECORD_RING_ALIGN                (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the variable-length record ring on the spsc circular buffer
+ *
+ * <pre>
+ * data: |head|payload..|pad|head|payload|pad| ... |head: padding ...|
+ *        size, type                                 the record is not split at the end
+ * </pre>
+ *
+ * each record has an 8 bytes head and the payload is aligned by TT_RECORD_RING_ALIGN,
+ * the rest of the buffer is skipped by a padding record if the record does not fit
+ * before the end, and the mirrored buffer never needs it.
+ *
+ * only one thread pushes and only one thread pops, push_n and pop_n move many
+ * records with one index publish.
+ */
+typedef struct __tt_record_ring_t
+{
+    // the buffer
+    tt_circular_buffer_spsc_t   buff;
+
+}tt_record_ring_t, *tt_record_ring_ref_t;
+
+/*! the record func type for popping in place
+ *
+ * @param data          the payload
+ * @param size          the payload size
+ * @param priv          the user private data
+ */
+typedef tt_void_t       (*tt_record_ring_func_t)(tt_byte_t const* data, tt_size_t size, tt_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the record ring, the data is mirrored if the size is aligned by the page size
+ *
+ * @param ring          the record ring
+ * @param size          the buffer size, aligned by TT_RECORD_RING_ALIGN
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_record_ring_init(tt_record_ring_ref_t ring, tt_size_t size);
+
+/*! exit the record ring
+ *
+ * @param ring          the record ring
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_record_ring_exit(tt_record_ring_ref_t ring);
+
+/*! push the record, only called by the producer
+ *
+ * @param ring          the record ring
+ * @param data          the payload
+ * @param size          the payload size
+ *
+ * @return              tt_true or tt_false if it is full
+ */
+tt_bool_t               tt_record_ring_push(tt_record_ring_ref_t ring, tt_byte_t const* data, tt_size_t size);
+
+/*! push the records and publish them once, only called by the producer
+ *
+ * @param ring          the record ring
+ * @param datas         the payloads
+ * @param sizes         the payload sizes
+ * @param count         the record count
+ *
+ * @return              the pushed record count, the rest are not pushed if it is full
+ */
+tt_size_t               tt_record_ring_push_n(tt_record_ring_ref_t ring, tt_byte_t const** datas, tt_size_t const* sizes, tt_size_t count);
+
+/*! pop the record, only called by the consumer
+ *
+ * the record is kept if the buffer is too small, so the consumer can pop it again with the required size
+ *
+ * @param ring          the record ring
+ * @param data          the payload buffer
+ * @param maxn          the payload buffer size
+ * @param size          the payload size, or the required size if the buffer is too small, it may be zero
+ *
+ * @return              ok: 1; empty: 0; the buffer is too small: -1
+ */
+tt_long_t               tt_record_ring_pop(tt_record_ring_ref_t ring, tt_byte_t* data, tt_size_t maxn, tt_size_t* size);
+
+/*! pop the records in place and release them once, only called by the consumer
+ *
+ * @param ring          the record ring
+ * @param func          the record func, the payload is valid only in it
+ * @param priv          the user private data
+ * @param count         the maximum record count
+ *
+ * @return              the popped record count
+ */
+tt_size_t               tt_record_ring_pop_n(tt_record_ring_ref_t ring, tt_record_ring_func_t func, tt_cpointer_t priv, tt_size_t count);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
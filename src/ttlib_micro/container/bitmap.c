@@ -0,0 +1,382 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       bitmap.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-29
+ * @brief      bitmap.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_BITMAP"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "bitmap.h"
+#include "../utils/bits.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the word bits
+#define TT_BITMAP_WORD_BITS             (64)
+
+// the word shift
+#define TT_BITMAP_WORD_SHIFT            (6)
+
+// the full word
+#define TT_BITMAP_WORD_FULL             (~(tt_uint64_t)0)
+
+// the word count of the bits
+#define tt_bitmap_words(size)           (((size) + TT_BITMAP_WORD_BITS - 1) >> TT_BITMAP_WORD_SHIFT)
+
+// the mask of the bits [pos & 63, 64) in the word
+#define tt_bitmap_mask_head(pos)        (TT_BITMAP_WORD_FULL << ((pos) & (TT_BITMAP_WORD_BITS - 1)))
+
+// the mask of the bits [0, (last & 63) + 1) in the word
+#define tt_bitmap_mask_tail(last)       (TT_BITMAP_WORD_FULL >> ((TT_BITMAP_WORD_BITS - 1) - ((last) & (TT_BITMAP_WORD_BITS - 1))))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+typedef struct __tt_bitmap_t
+{
+    // the words
+    tt_uint64_t*        words;
+
+    // the bit count
+    tt_size_t           size;
+
+    // the word count of the bits
+    tt_size_t           count;
+
+    // the word maxn
+    tt_size_t           maxn;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_bitmap_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+// keep the bits after the size be zero
+static __tt_inline__ tt_void_t tt_bitmap_trim(tt_bitmap_t* bitmap)
+{
+    if (bitmap->size & (TT_BITMAP_WORD_BITS - 1))
+        bitmap->words[bitmap->count - 1] &= tt_bitmap_mask_tail(bitmap->size - 1);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_bitmap_ref_t tt_bitmap_init(tt_size_t size)
+{
+    return tt_bitmap_init_with_allocator(size, tt_null);
+}
+
+tt_bitmap_ref_t tt_bitmap_init_with_allocator(tt_size_t size, tt_allocator_ref_t allocator)
+{
+    // done
+    tt_bool_t       ok = tt_false;
+    tt_bitmap_t*    bitmap = tt_null;
+    do
+    {
+        bitmap = tt_allocator_malloc0(allocator, sizeof(tt_bitmap_t));
+        tt_assert_and_check_break(bitmap);
+        bitmap->allocator = allocator;
+
+        // make words
+        if (size)
+        {
+            bitmap->maxn  = tt_bitmap_words(size);
+            bitmap->words = (tt_uint64_t*)tt_allocator_nalloc0(allocator, sizeof(tt_uint64_t), bitmap->maxn);
+            tt_assert_and_check_break(bitmap->words);
+        }
+        bitmap->size  = size;
+        bitmap->count = tt_bitmap_words(size);
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && bitmap)
+    {
+        tt_allocator_free(allocator, bitmap);
+        bitmap = tt_null;
+    }
+
+    return (tt_bitmap_ref_t)bitmap;
+}
+
+tt_void_t tt_bitmap_exit(tt_bitmap_ref_t self)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return(bitmap);
+
+    // free words
+    if (bitmap->words)
+    {
+        tt_allocator_free(bitmap->allocator, bitmap->words);
+        bitmap->words = tt_null;
+    }
+
+    tt_allocator_free(bitmap->allocator, bitmap);
+}
+
+tt_void_t tt_bitmap_clear(tt_bitmap_ref_t self)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return(bitmap);
+
+    if (bitmap->count) tt_memset(bitmap->words, 0, bitmap->count * sizeof(tt_uint64_t));
+}
+
+tt_size_t tt_bitmap_size(tt_bitmap_ref_t self)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return_val(bitmap, 0);
+
+    return bitmap->size;
+}
+
+tt_bool_t tt_bitmap_resize(tt_bitmap_ref_t self, tt_size_t size)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return_val(bitmap, tt_false);
+
+    // grow words
+    tt_size_t count = tt_bitmap_words(size);
+    if (count > bitmap->maxn)
+    {
+        tt_size_t    maxn = tt_max(count, bitmap->maxn + (bitmap->maxn >> 1));
+        tt_uint64_t* words = (tt_uint64_t*)tt_allocator_ralloc(bitmap->allocator, bitmap->words, maxn * sizeof(tt_uint64_t));
+        tt_assert_and_check_return_val(words, tt_false);
+
+        bitmap->words = words;
+        bitmap->maxn  = maxn;
+    }
+
+    // the new words are zero
+    if (count > bitmap->count) tt_memset(bitmap->words + bitmap->count, 0, (count - bitmap->count) * sizeof(tt_uint64_t));
+
+    bitmap->size  = size;
+    bitmap->count = count;
+    tt_bitmap_trim(bitmap);
+    return tt_true;
+}
+
+tt_void_t tt_bitmap_set(tt_bitmap_ref_t self, tt_size_t pos)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return(bitmap && pos < bitmap->size);
+
+    bitmap->words[pos >> TT_BITMAP_WORD_SHIFT] |= (tt_uint64_t)1 << (pos & (TT_BITMAP_WORD_BITS - 1));
+}
+
+tt_void_t tt_bitmap_reset(tt_bitmap_ref_t self, tt_size_t pos)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return(bitmap && pos < bitmap->size);
+
+    bitmap->words[pos >> TT_BITMAP_WORD_SHIFT] &= ~((tt_uint64_t)1 << (pos & (TT_BITMAP_WORD_BITS - 1)));
+}
+
+tt_bool_t tt_bitmap_test(tt_bitmap_ref_t self, tt_size_t pos)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return_val(bitmap && pos < bitmap->size, tt_false);
+
+    return (bitmap->words[pos >> TT_BITMAP_WORD_SHIFT] >> (pos & (TT_BITMAP_WORD_BITS - 1))) & 1;
+}
+
+tt_void_t tt_bitmap_set_range(tt_bitmap_ref_t self, tt_size_t pos, tt_size_t size)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return(bitmap && pos <= bitmap->size && size <= bitmap->size - pos);
+    tt_check_return(size);
+
+    tt_size_t last = pos + size - 1;
+    tt_size_t head = pos >> TT_BITMAP_WORD_SHIFT;
+    tt_size_t tail = last >> TT_BITMAP_WORD_SHIFT;
+    if (head == tail) bitmap->words[head] |= tt_bitmap_mask_head(pos) & tt_bitmap_mask_tail(last);
+    else
+    {
+        bitmap->words[head] |= tt_bitmap_mask_head(pos);
+        if (tail > head + 1) tt_memset(bitmap->words + head + 1, 0xff, (tail - head - 1) * sizeof(tt_uint64_t));
+        bitmap->words[tail] |= tt_bitmap_mask_tail(last);
+    }
+}
+
+tt_void_t tt_bitmap_reset_range(tt_bitmap_ref_t self, tt_size_t pos, tt_size_t size)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return(bitmap && pos <= bitmap->size && size <= bitmap->size - pos);
+    tt_check_return(size);
+
+    tt_size_t last = pos + size - 1;
+    tt_size_t head = pos >> TT_BITMAP_WORD_SHIFT;
+    tt_size_t tail = last >> TT_BITMAP_WORD_SHIFT;
+    if (head == tail) bitmap->words[head] &= ~(tt_bitmap_mask_head(pos) & tt_bitmap_mask_tail(last));
+    else
+    {
+        bitmap->words[head] &= ~tt_bitmap_mask_head(pos);
+        if (tail > head + 1) tt_memset(bitmap->words + head + 1, 0, (tail - head - 1) * sizeof(tt_uint64_t));
+        bitmap->words[tail] &= ~tt_bitmap_mask_tail(last);
+    }
+}
+
+tt_bool_t tt_bitmap_test_range(tt_bitmap_ref_t self, tt_size_t pos, tt_size_t size)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return_val(bitmap && pos <= bitmap->size && size <= bitmap->size - pos, tt_false);
+    tt_check_return_val(size, tt_true);
+
+    tt_size_t last = pos + size - 1;
+    tt_size_t head = pos >> TT_BITMAP_WORD_SHIFT;
+    tt_size_t tail = last >> TT_BITMAP_WORD_SHIFT;
+    if (head == tail)
+    {
+        tt_uint64_t mask = tt_bitmap_mask_head(pos) & tt_bitmap_mask_tail(last);
+        return (bitmap->words[head] & mask) == mask;
+    }
+
+    tt_check_return_val((bitmap->words[head] & tt_bitmap_mask_head(pos)) == tt_bitmap_mask_head(pos), tt_false);
+    tt_size_t i = 0;
+    for (i = head + 1; i < tail; i++)
+    {
+        tt_check_return_val(bitmap->words[i] == TT_BITMAP_WORD_FULL, tt_false);
+    }
+    return (bitmap->words[tail] & tt_bitmap_mask_tail(last)) == tt_bitmap_mask_tail(last);
+}
+
+tt_size_t tt_bitmap_find_set(tt_bitmap_ref_t self, tt_size_t pos)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return_val(bitmap, TT_BITMAP_NONE);
+    tt_check_return_val(pos < bitmap->size, TT_BITMAP_NONE);
+
+    // the bits after the size are zero, so the found bit is always in the bitmap
+    tt_size_t   i = pos >> TT_BITMAP_WORD_SHIFT;
+    tt_uint64_t w = bitmap->words[i] & tt_bitmap_mask_head(pos);
+    while (!w)
+    {
+        if (++i >= bitmap->count) return TT_BITMAP_NONE;
+        w = bitmap->words[i];
+    }
+    return (i << TT_BITMAP_WORD_SHIFT) + tt_bits_cl0_u64_le(w);
+}
+
+tt_size_t tt_bitmap_find_reset(tt_bitmap_ref_t self, tt_size_t pos)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return_val(bitmap, TT_BITMAP_NONE);
+    tt_check_return_val(pos < bitmap->size, TT_BITMAP_NONE);
+
+    // skip the full words
+    tt_size_t   i = pos >> TT_BITMAP_WORD_SHIFT;
+    tt_uint64_t w = ~bitmap->words[i] & tt_bitmap_mask_head(pos);
+    while (!w)
+    {
+        if (++i >= bitmap->count) return TT_BITMAP_NONE;
+        w = ~bitmap->words[i];
+    }
+
+    // the reset bit may be after the size in the last word
+    pos = (i << TT_BITMAP_WORD_SHIFT) + tt_bits_cl0_u64_le(w);
+    return pos < bitmap->size ? pos : TT_BITMAP_NONE;
+}
+
+tt_size_t tt_bitmap_count(tt_bitmap_ref_t self)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return_val(bitmap, 0);
+
+    tt_size_t i = 0;
+    tt_size_t n = 0;
+    for (i = 0; i < bitmap->count; i++) n += tt_bits_cb1_u64(bitmap->words[i]);
+    return n;
+}
+
+tt_size_t tt_bitmap_count_range(tt_bitmap_ref_t self, tt_size_t pos, tt_size_t size)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_assert_and_check_return_val(bitmap && pos <= bitmap->size && size <= bitmap->size - pos, 0);
+    tt_check_return_val(size, 0);
+
+    tt_size_t last = pos + size - 1;
+    tt_size_t head = pos >> TT_BITMAP_WORD_SHIFT;
+    tt_size_t tail = last >> TT_BITMAP_WORD_SHIFT;
+    if (head == tail) return tt_bits_cb1_u64(bitmap->words[head] & tt_bitmap_mask_head(pos) & tt_bitmap_mask_tail(last));
+
+    tt_size_t i = 0;
+    tt_size_t n = tt_bits_cb1_u64(bitmap->words[head] & tt_bitmap_mask_head(pos));
+    for (i = head + 1; i < tail; i++) n += tt_bits_cb1_u64(bitmap->words[i]);
+    return n + tt_bits_cb1_u64(bitmap->words[tail] & tt_bitmap_mask_tail(last));
+}
+
+tt_void_t tt_bitmap_and(tt_bitmap_ref_t self, tt_bitmap_ref_t other)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_bitmap_t* bitmap_other = (tt_bitmap_t*)other;
+    tt_assert_and_check_return(bitmap && bitmap_other);
+
+    // the simple loops will be vectorized by the compiler
+    tt_size_t i = 0;
+    tt_size_t n = tt_min(bitmap->count, bitmap_other->count);
+    tt_uint64_t*       d = bitmap->words;
+    tt_uint64_t const* s = bitmap_other->words;
+    for (i = 0; i < n; i++) d[i] &= s[i];
+    if (bitmap->count > n) tt_memset(d + n, 0, (bitmap->count - n) * sizeof(tt_uint64_t));
+}
+
+tt_void_t tt_bitmap_or(tt_bitmap_ref_t self, tt_bitmap_ref_t other)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_bitmap_t* bitmap_other = (tt_bitmap_t*)other;
+    tt_assert_and_check_return(bitmap && bitmap_other);
+
+    tt_size_t i = 0;
+    tt_size_t n = tt_min(bitmap->count, bitmap_other->count);
+    tt_uint64_t*       d = bitmap->words;
+    tt_uint64_t const* s = bitmap_other->words;
+    for (i = 0; i < n; i++) d[i] |= s[i];
+    if (n) tt_bitmap_trim(bitmap);
+}
+
+tt_void_t tt_bitmap_xor(tt_bitmap_ref_t self, tt_bitmap_ref_t other)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_bitmap_t* bitmap_other = (tt_bitmap_t*)other;
+    tt_assert_and_check_return(bitmap && bitmap_other);
+
+    tt_size_t i = 0;
+    tt_size_t n = tt_min(bitmap->count, bitmap_other->count);
+    tt_uint64_t*       d = bitmap->words;
+    tt_uint64_t const* s = bitmap_other->words;
+    for (i = 0; i < n; i++) d[i] ^= s[i];
+    if (n) tt_bitmap_trim(bitmap);
+}
+
+tt_void_t tt_bitmap_andnot(tt_bitmap_ref_t self, tt_bitmap_ref_t other)
+{
+    tt_bitmap_t* bitmap = (tt_bitmap_t*)self;
+    tt_bitmap_t* bitmap_other = (tt_bitmap_t*)other;
+    tt_assert_and_check_return(bitmap && bitmap_other);
+
+    tt_size_t i = 0;
+    tt_size_t n = tt_min(bitmap->count, bitmap_other->count);
+    tt_uint64_t*       d = bitmap->words;
+    tt_uint64_t const* s = bitmap_other->words;
+    for (i = 0; i < n; i++) d[i] &= ~s[i];
+}
@@ -0,0 +1,245 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       bitmap.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-29
+ * @brief      bitmap.h file
+ */
+
+#ifndef TT_CONTAINER_BITMAP_H
+#define TT_CONTAINER_BITMAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the invalid bit position, returned if the bit is not found
+#define TT_BITMAP_NONE                  ((tt_size_t)-1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the bitmap ref type
+ *
+ * <pre>
+ * bits: |   word0   |   word1   |   word2   | ... |   wordN   |   (64-bits words)
+ *        0       63  64     127  128    191          |<- size ->|
+ *
+ * the bits after the size of the last word are always zero.
+ *
+ * performance:
+ *
+ * set/reset/test:       O(1)
+ * range set/reset/test: O(n / 64)
+ * find set/reset:       O(n / 64)
+ * count:                O(n / 64)
+ * and/or/xor/andnot:    O(n / 64)
+ * </pre>
+ *
+ */
+typedef __tt_typeref__(bitmap);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init bitmap, all bits are zero
+ *
+ * @param size          the bit count
+ *
+ * @return              the bitmap
+ */
+tt_bitmap_ref_t         tt_bitmap_init(tt_size_t size);
+
+/*! init bitmap with the allocator
+ *
+ * @param size          the bit count
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the bitmap
+ */
+tt_bitmap_ref_t         tt_bitmap_init_with_allocator(tt_size_t size, tt_allocator_ref_t allocator);
+
+/*! exit bitmap
+ *
+ * @param bitmap        the bitmap
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_exit(tt_bitmap_ref_t bitmap);
+
+/*! reset all bits
+ *
+ * @param bitmap        the bitmap
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_clear(tt_bitmap_ref_t bitmap);
+
+/*! the bit count
+ *
+ * @param bitmap        the bitmap
+ *
+ * @return              the bit count
+ */
+tt_size_t               tt_bitmap_size(tt_bitmap_ref_t bitmap);
+
+/*! resize the bit count, the new bits are zero
+ *
+ * @param bitmap        the bitmap
+ * @param size          the new bit count
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_bitmap_resize(tt_bitmap_ref_t bitmap, tt_size_t size);
+
+/*! set the bit
+ *
+ * @param bitmap        the bitmap
+ * @param pos           the bit position
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_set(tt_bitmap_ref_t bitmap, tt_size_t pos);
+
+/*! reset the bit
+ *
+ * @param bitmap        the bitmap
+ * @param pos           the bit position
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_reset(tt_bitmap_ref_t bitmap, tt_size_t pos);
+
+/*! test the bit
+ *
+ * @param bitmap        the bitmap
+ * @param pos           the bit position
+ *
+ * @return              tt_true if the bit is set
+ */
+tt_bool_t               tt_bitmap_test(tt_bitmap_ref_t bitmap, tt_size_t pos);
+
+/*! set the bits of range [pos, pos + size)
+ *
+ * @param bitmap        the bitmap
+ * @param pos           the first bit position
+ * @param size          the bit count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_set_range(tt_bitmap_ref_t bitmap, tt_size_t pos, tt_size_t size);
+
+/*! reset the bits of range [pos, pos + size)
+ *
+ * @param bitmap        the bitmap
+ * @param pos           the first bit position
+ * @param size          the bit count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_reset_range(tt_bitmap_ref_t bitmap, tt_size_t pos, tt_size_t size);
+
+/*! test the bits of range [pos, pos + size)
+ *
+ * @param bitmap        the bitmap
+ * @param pos           the first bit position
+ * @param size          the bit count
+ *
+ * @return              tt_true if all bits are set
+ */
+tt_bool_t               tt_bitmap_test_range(tt_bitmap_ref_t bitmap, tt_size_t pos, tt_size_t size);
+
+/*! find the first set bit from the given position
+ *
+ * @param bitmap        the bitmap
+ * @param pos           the start bit position
+ *
+ * @return              the bit position or TT_BITMAP_NONE
+ */
+tt_size_t               tt_bitmap_find_set(tt_bitmap_ref_t bitmap, tt_size_t pos);
+
+/*! find the first reset bit from the given position, .e.g allocate one free slot
+ *
+ * @param bitmap        the bitmap
+ * @param pos           the start bit position
+ *
+ * @return              the bit position or TT_BITMAP_NONE
+ */
+tt_size_t               tt_bitmap_find_reset(tt_bitmap_ref_t bitmap, tt_size_t pos);
+
+/*! the count of the set bits
+ *
+ * @param bitmap        the bitmap
+ *
+ * @return              the set bit count
+ */
+tt_size_t               tt_bitmap_count(tt_bitmap_ref_t bitmap);
+
+/*! the count of the set bits of range [pos, pos + size)
+ *
+ * @param bitmap        the bitmap
+ * @param pos           the first bit position
+ * @param size          the bit count
+ *
+ * @return              the set bit count
+ */
+tt_size_t               tt_bitmap_count_range(tt_bitmap_ref_t bitmap, tt_size_t pos, tt_size_t size);
+
+/*! bitmap &= other, the bits out of the other size are reset
+ *
+ * @param bitmap        the bitmap
+ * @param other         the other bitmap
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_and(tt_bitmap_ref_t bitmap, tt_bitmap_ref_t other);
+
+/*! bitmap |= other, the other bits out of the bitmap size are ignored
+ *
+ * @param bitmap        the bitmap
+ * @param other         the other bitmap
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_or(tt_bitmap_ref_t bitmap, tt_bitmap_ref_t other);
+
+/*! bitmap ^= other, the other bits out of the bitmap size are ignored
+ *
+ * @param bitmap        the bitmap
+ * @param other         the other bitmap
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_xor(tt_bitmap_ref_t bitmap, tt_bitmap_ref_t other);
+
+/*! bitmap &= ~other
+ *
+ * @param bitmap        the bitmap
+ * @param other         the other bitmap
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bitmap_andnot(tt_bitmap_ref_t bitmap, tt_bitmap_ref_t other);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
@@ -0,0 +1,259 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       bloom_filter.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-26
+ * @brief      bloom_filter.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_BLOOM_FILTER"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "element/element.h"
+#include "bloom_filter.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum bit count
+#define TT_BLOOM_FILTER_BITS_MIN            (TT_CPU_BITSIZE)
+
+// the maximum hash count
+#define TT_BLOOM_FILTER_HASH_MAXN           (31)
+
+// the item count of one batch for nadd and ntest
+#define TT_BLOOM_FILTER_BATCH               (16)
+
+// the full hash mask
+#define TT_BLOOM_FILTER_HASH_MASK           (~(tt_size_t)0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+typedef struct __tt_bloom_filter_t
+{
+    // the bits
+    tt_size_t*          bits;
+
+    // the bit count, pow2
+    tt_size_t           maxn;
+
+    // the bit mask
+    tt_size_t           mask;
+
+    // the hash count
+    tt_size_t           hash_count;
+
+    // the element
+    tt_element_t        element;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_bloom_filter_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tt_inline__ tt_void_t tt_bloom_filter_hash(tt_bloom_filter_t* filter, tt_cpointer_t data, tt_size_t* hash0, tt_size_t* hash1)
+{
+    *hash0 = filter->element.hash(&filter->element, data, TT_BLOOM_FILTER_HASH_MASK, 0);
+
+    // the step must be odd for walking the pow2 bits
+    *hash1 = filter->element.hash(&filter->element, data, TT_BLOOM_FILTER_HASH_MASK, 1) | 1;
+}
+
+static tt_bool_t tt_bloom_filter_add_hash(tt_bloom_filter_t* filter, tt_size_t hash0, tt_size_t hash1)
+{
+    tt_size_t i = 0;
+    tt_size_t o = 0;
+    for (i = 0; i < filter->hash_count; i++, hash0 += hash1)
+    {
+        tt_size_t  b = hash0 & filter->mask;
+        tt_size_t* w = filter->bits + (b >> TT_CPU_SHIFT);
+        tt_size_t  m = (tt_size_t)1 << (b & (TT_CPU_BITSIZE - 1));
+        o |= ~*w & m;
+        *w |= m;
+    }
+
+    // new if one bit at least is not set before
+    return o ? tt_true : tt_false;
+}
+
+static tt_bool_t tt_bloom_filter_test_hash(tt_bloom_filter_t* filter, tt_size_t hash0, tt_size_t hash1)
+{
+    tt_size_t i = 0;
+    for (i = 0; i < filter->hash_count; i++, hash0 += hash1)
+    {
+        tt_size_t b = hash0 & filter->mask;
+        if (!(filter->bits[b >> TT_CPU_SHIFT] & ((tt_size_t)1 << (b & (TT_CPU_BITSIZE - 1))))) return tt_false;
+    }
+    return tt_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_bloom_filter_ref_t tt_bloom_filter_init(tt_size_t probability, tt_size_t item_maxn, tt_element_t e)
+{
+    return tt_bloom_filter_init_with_allocator(probability, item_maxn, e, tt_null);
+}
+
+tt_bloom_filter_ref_t tt_bloom_filter_init_with_allocator(tt_size_t probability, tt_size_t item_maxn, tt_element_t e, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(e.hash && probability && probability <= TT_BLOOM_FILTER_HASH_MAXN && item_maxn, tt_null);
+
+    // done
+    tt_bool_t           ok = tt_false;
+    tt_bloom_filter_t*  filter = tt_null;
+    do
+    {
+        filter = tt_allocator_malloc0(allocator, sizeof(tt_bloom_filter_t));
+        tt_assert_and_check_break(filter);
+        filter->allocator = allocator;
+
+        // the optimal hash count: k = p
+        filter->hash_count = probability;
+        filter->element    = e;
+
+        // the optimal bit count: m = n * k / ln(2) ~= n * k * 1.443
+        tt_size_t maxn = item_maxn * probability;
+        tt_assert_and_check_break(maxn / probability == item_maxn && maxn <= (TT_BLOOM_FILTER_HASH_MASK >> 2));
+        maxn += (maxn / 1000) * 443 + (maxn % 1000) * 443 / 1000;
+        maxn = tt_max(maxn, TT_BLOOM_FILTER_BITS_MIN);
+
+        // align by pow2 for masking the bit index
+        tt_size_t bits = TT_BLOOM_FILTER_BITS_MIN;
+        while (bits < maxn) bits <<= 1;
+        filter->maxn = bits;
+        filter->mask = bits - 1;
+
+        // make bits
+        filter->bits = (tt_size_t*)tt_allocator_nalloc0(allocator, sizeof(tt_size_t), filter->maxn >> TT_CPU_SHIFT);
+        tt_assert_and_check_break(filter->bits);
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && filter)
+    {
+        tt_allocator_free(allocator, filter);
+        filter = tt_null;
+    }
+
+    return (tt_bloom_filter_ref_t)filter;
+}
+
+tt_void_t tt_bloom_filter_exit(tt_bloom_filter_ref_t self)
+{
+    tt_bloom_filter_t* filter = (tt_bloom_filter_t*)self;
+    tt_assert_and_check_return(filter);
+
+    // free bits
+    if (filter->bits)
+    {
+        tt_allocator_free(filter->allocator, filter->bits);
+        filter->bits = tt_null;
+    }
+
+    tt_allocator_free(filter->allocator, filter);
+}
+
+tt_void_t tt_bloom_filter_clear(tt_bloom_filter_ref_t self)
+{
+    tt_bloom_filter_t* filter = (tt_bloom_filter_t*)self;
+    tt_assert_and_check_return(filter && filter->bits);
+
+    tt_memset(filter->bits, 0, (filter->maxn >> TT_CPU_SHIFT) * sizeof(tt_size_t));
+}
+
+tt_bool_t tt_bloom_filter_add(tt_bloom_filter_ref_t self, tt_cpointer_t data)
+{
+    tt_bloom_filter_t* filter = (tt_bloom_filter_t*)self;
+    tt_assert_and_check_return_val(filter, tt_false);
+
+    tt_size_t hash0, hash1;
+    tt_bloom_filter_hash(filter, data, &hash0, &hash1);
+    return tt_bloom_filter_add_hash(filter, hash0, hash1);
+}
+
+tt_bool_t tt_bloom_filter_test(tt_bloom_filter_ref_t self, tt_cpointer_t data)
+{
+    tt_bloom_filter_t* filter = (tt_bloom_filter_t*)self;
+    tt_assert_and_check_return_val(filter, tt_false);
+
+    tt_size_t hash0, hash1;
+    tt_bloom_filter_hash(filter, data, &hash0, &hash1);
+    return tt_bloom_filter_test_hash(filter, hash0, hash1);
+}
+
+tt_size_t tt_bloom_filter_nadd(tt_bloom_filter_ref_t self, tt_cpointer_t const* datas, tt_size_t size)
+{
+    tt_bloom_filter_t* filter = (tt_bloom_filter_t*)self;
+    tt_assert_and_check_return_val(filter && (datas || !size), 0);
+
+    // hash one batch first, then the bit accesses are not blocked by the hash computing
+    tt_size_t i = 0;
+    tt_size_t n = 0;
+    tt_size_t hash0[TT_BLOOM_FILTER_BATCH];
+    tt_size_t hash1[TT_BLOOM_FILTER_BATCH];
+    while (size)
+    {
+        tt_size_t batch = tt_min(size, TT_BLOOM_FILTER_BATCH);
+        for (i = 0; i < batch; i++) tt_bloom_filter_hash(filter, datas[i], &hash0[i], &hash1[i]);
+        for (i = 0; i < batch; i++) if (tt_bloom_filter_add_hash(filter, hash0[i], hash1[i])) n++;
+
+        datas += batch;
+        size  -= batch;
+    }
+    return n;
+}
+
+tt_size_t tt_bloom_filter_ntest(tt_bloom_filter_ref_t self, tt_cpointer_t const* datas, tt_size_t size, tt_bool_t* results)
+{
+    tt_bloom_filter_t* filter = (tt_bloom_filter_t*)self;
+    tt_assert_and_check_return_val(filter && (datas || !size), 0);
+
+    // hash one batch first, then the bit accesses are not blocked by the hash computing
+    tt_size_t i = 0;
+    tt_size_t n = 0;
+    tt_size_t hash0[TT_BLOOM_FILTER_BATCH];
+    tt_size_t hash1[TT_BLOOM_FILTER_BATCH];
+    while (size)
+    {
+        tt_size_t batch = tt_min(size, TT_BLOOM_FILTER_BATCH);
+        for (i = 0; i < batch; i++) tt_bloom_filter_hash(filter, datas[i], &hash0[i], &hash1[i]);
+        for (i = 0; i < batch; i++)
+        {
+            tt_bool_t ok = tt_bloom_filter_test_hash(filter, hash0[i], hash1[i]);
+            if (results) results[i] = ok;
+            if (ok) n++;
+        }
+
+        datas += batch;
+        size  -= batch;
+        if (results) results += batch;
+    }
+    return n;
+}
+
+tt_size_t tt_bloom_filter_maxn(tt_bloom_filter_ref_t self)
+{
+    tt_bloom_filter_t* filter = (tt_bloom_filter_t*)self;
+    tt_assert_and_check_return_val(filter, 0);
+
+    return filter->maxn;
+}
@@ -0,0 +1,167 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       bloom_filter.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-26
+ * @brief      bloom_filter.h file
+ */
+
+#ifndef TT_CONTAINER_BLOOM_FILTER_H
+#define TT_CONTAINER_BLOOM_FILTER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+#include "element/element.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the false positive probability: ~0.1 (1 / 2^3)
+#define TT_BLOOM_FILTER_PROBABILITY_0_1         (3)
+
+/// the false positive probability: ~0.01 (1 / 2^7)
+#define TT_BLOOM_FILTER_PROBABILITY_0_01        (7)
+
+/// the false positive probability: ~0.001 (1 / 2^10)
+#define TT_BLOOM_FILTER_PROBABILITY_0_001       (10)
+
+/// the false positive probability: ~0.0001 (1 / 2^13)
+#define TT_BLOOM_FILTER_PROBABILITY_0_0001      (13)
+
+/// the false positive probability: ~0.00001 (1 / 2^17)
+#define TT_BLOOM_FILTER_PROBABILITY_0_00001     (17)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the bloom filter ref type
+ *
+ * <pre>
+ * bits: |0|1|0|0|1|0|1|0|0|0|1|0|...|  (tt_size_t words)
+ *          |     |   |       |
+ *        hash(data, 0) + i * hash(data, 1), i = [0, k)
+ *
+ * the false positive probability is ~1 / 2^p, the hash count k is p and
+ * the bit count is (item_maxn * p / ln(2)), aligned by pow2.
+ *
+ * only the element hash functions of index 0 and 1 are called for each item,
+ * the k bit indexes are made by double hashing.
+ *
+ * performance:
+ *
+ * add:  fast, O(k)
+ * test: fast, O(k)
+ * </pre>
+ *
+ * @note the item can not be removed, the false positive probability will be higher if the item count > item_maxn
+ *
+ */
+typedef __tt_typeref__(bloom_filter);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init bloom filter
+ *
+ * @param probability   the false positive probability exponent p, ~1 / 2^p, .e.g TT_BLOOM_FILTER_PROBABILITY_0_01
+ * @param item_maxn     the expected item count
+ * @param e             the element, the hash function is required
+ *
+ * @return              the bloom filter
+ */
+tt_bloom_filter_ref_t   tt_bloom_filter_init(tt_size_t probability, tt_size_t item_maxn, tt_element_t e);
+
+/*! init bloom filter with the allocator
+ *
+ * @param probability   the false positive probability exponent p, ~1 / 2^p, .e.g TT_BLOOM_FILTER_PROBABILITY_0_01
+ * @param item_maxn     the expected item count
+ * @param e             the element, the hash function is required
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the bloom filter
+ */
+tt_bloom_filter_ref_t   tt_bloom_filter_init_with_allocator(tt_size_t probability, tt_size_t item_maxn, tt_element_t e, tt_allocator_ref_t allocator);
+
+/*! exit bloom filter
+ *
+ * @param filter        the bloom filter
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bloom_filter_exit(tt_bloom_filter_ref_t filter);
+
+/*! clear bloom filter
+ *
+ * @param filter        the bloom filter
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bloom_filter_clear(tt_bloom_filter_ref_t filter);
+
+/*! add the item data
+ *
+ * @param filter        the bloom filter
+ * @param data          the item data
+ *
+ * @return              tt_true if the data is new, tt_false if it may be added before
+ */
+tt_bool_t               tt_bloom_filter_add(tt_bloom_filter_ref_t filter, tt_cpointer_t data);
+
+/*! test the item data
+ *
+ * @param filter        the bloom filter
+ * @param data          the item data
+ *
+ * @return              tt_false if the data is absent, tt_true if it may be added before
+ */
+tt_bool_t               tt_bloom_filter_test(tt_bloom_filter_ref_t filter, tt_cpointer_t data);
+
+/*! add the item datas, all hashes of one batch are computed before setting the bits
+ *
+ * @param filter        the bloom filter
+ * @param datas         the item datas
+ * @param size          the item count
+ *
+ * @return              the new item count
+ */
+tt_size_t               tt_bloom_filter_nadd(tt_bloom_filter_ref_t filter, tt_cpointer_t const* datas, tt_size_t size);
+
+/*! test the item datas, all hashes of one batch are computed before testing the bits
+ *
+ * @param filter        the bloom filter
+ * @param datas         the item datas
+ * @param size          the item count
+ * @param results       the test results, may be tt_null
+ *
+ * @return              the count of the items which may be added before
+ */
+tt_size_t               tt_bloom_filter_ntest(tt_bloom_filter_ref_t filter, tt_cpointer_t const* datas, tt_size_t size, tt_bool_t* results);
+
+/*! the bit count of the bloom filter
+ *
+ * @param filter        the bloom filter
+ *
+ * @return              the bit count
+ */
+tt_size_t               tt_bloom_filter_maxn(tt_bloom_filter_ref_t filter);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
@@ -0,0 +1,912 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       bplus_tree.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-28
+ * @brief      bplus_tree.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_BPLUS_TREE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "element/element.h"
+#include "bplus_tree.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum node size
+#define TT_BPLUS_TREE_NODE_SIZE_MIN             (128)
+
+// the maximum node size
+#define TT_BPLUS_TREE_NODE_SIZE_MAX             (65536)
+
+// the maximum depth, the inner node has two children at least after splitting
+#define TT_BPLUS_TREE_DEPTH_MAXN                (TT_CPU_BITSIZE)
+
+// the node key buffer
+#define tt_bplus_tree_key(tree, node, i)        ((tt_byte_t*)((node) + 1) + (i) * (tree)->element_key.size)
+
+// the leaf data buffer
+#define tt_bplus_tree_data(tree, node, i)       ((tt_byte_t*)((node) + 1) + (tree)->leaf_doff + (i) * (tree)->element_data.size)
+
+// the inner children
+#define tt_bplus_tree_childs(tree, node)        ((tt_bplus_tree_node_t**)((tt_byte_t*)((node) + 1) + (tree)->inner_coff))
+
+// the key data of the node key buffer
+#define tt_bplus_tree_key_data(tree, node, i)   ((tree)->element_key.data(&(tree)->element_key, tt_bplus_tree_key(tree, node, i)))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the node type, the keys and the datas or children are placed after it
+typedef struct __tt_bplus_tree_node_t
+{
+    // the prev leaf
+    struct __tt_bplus_tree_node_t*      prev;
+
+    // the next leaf
+    struct __tt_bplus_tree_node_t*      next;
+
+    // is leaf?
+    tt_uint16_t                         leaf;
+
+    // the key count
+    tt_uint16_t                         size;
+
+}tt_bplus_tree_node_t;
+
+typedef struct __tt_bplus_tree_t
+{
+    // iterator
+    tt_iterator_t           itor;
+
+    // the root node
+    tt_bplus_tree_node_t*   root;
+
+    // the head leaf
+    tt_bplus_tree_node_t*   head;
+
+    // the last leaf
+    tt_bplus_tree_node_t*   last;
+
+    // the item count
+    tt_size_t               size;
+
+    // the node size, pow2
+    tt_size_t               node_size;
+
+    // the key maxn of the leaf
+    tt_size_t               leaf_maxn;
+
+    // the data offset of the leaf payload
+    tt_size_t               leaf_doff;
+
+    // the key maxn of the inner
+    tt_size_t               inner_maxn;
+
+    // the children offset of the inner payload
+    tt_size_t               inner_coff;
+
+    // the key buffers of the separator and the middle key for splitting
+    tt_byte_t*              kbuff;
+
+    // the iterator item
+    tt_bplus_tree_item_t    item;
+
+    // the element of key
+    tt_element_t            element_key;
+
+    // the element of data
+    tt_element_t            element_data;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_bplus_tree_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tt_bplus_tree_node_t* tt_bplus_tree_node_make(tt_bplus_tree_t* tree, tt_bool_t leaf)
+{
+    // make node aligned by the node size, then the itor can be made of the leaf and the slot
+    tt_pointer_t node = tt_allocator_align_malloc(tree->allocator, tree->node_size, tree->node_size);
+    tt_assert_and_check_return_val(node, tt_null);
+
+    tt_memset(node, 0, sizeof(tt_bplus_tree_node_t));
+    ((tt_bplus_tree_node_t*)node)->leaf = (tt_uint16_t)leaf;
+    return (tt_bplus_tree_node_t*)node;
+}
+
+static tt_void_t tt_bplus_tree_node_free(tt_bplus_tree_t* tree, tt_bplus_tree_node_t* node)
+{
+    tt_allocator_align_free(tree->allocator, node);
+}
+
+static tt_void_t tt_bplus_tree_node_exit(tt_bplus_tree_t* tree, tt_bplus_tree_node_t* node)
+{
+    tt_size_t i = 0;
+    if (node->leaf)
+    {
+        if (tree->element_key.nfree) tree->element_key.nfree(&tree->element_key, tt_bplus_tree_key(tree, node, 0), node->size);
+        if (tree->element_data.nfree) tree->element_data.nfree(&tree->element_data, tt_bplus_tree_data(tree, node, 0), node->size);
+    }
+    else
+    {
+        tt_bplus_tree_node_t** childs = tt_bplus_tree_childs(tree, node);
+        for (i = 0; i <= node->size; i++) tt_bplus_tree_node_exit(tree, childs[i]);
+        if (tree->element_key.nfree) tree->element_key.nfree(&tree->element_key, tt_bplus_tree_key(tree, node, 0), node->size);
+    }
+    tt_bplus_tree_node_free(tree, node);
+}
+
+// the first slot which key >= the given key, or which key > the given key if upper
+static tt_size_t tt_bplus_tree_node_bound(tt_bplus_tree_t* tree, tt_bplus_tree_node_t* node, tt_cpointer_t key, tt_bool_t upper, tt_bool_t* found)
+{
+    tt_size_t l = 0;
+    tt_size_t r = node->size;
+    while (l < r)
+    {
+        tt_size_t m = (l + r) >> 1;
+        tt_long_t c = tree->element_key.comp(&tree->element_key, tt_bplus_tree_key_data(tree, node, m), key);
+        if (c < 0 || (upper && !c)) l = m + 1;
+        else r = m;
+    }
+    if (found) *found = (l < node->size && !tree->element_key.comp(&tree->element_key, tt_bplus_tree_key_data(tree, node, l), key));
+    return l;
+}
+
+// seek the leaf of the key and save the path
+static tt_bplus_tree_node_t* tt_bplus_tree_seek(tt_bplus_tree_t* tree, tt_cpointer_t key, tt_bplus_tree_node_t** path, tt_size_t* index, tt_size_t* depth)
+{
+    tt_size_t               d = 0;
+    tt_bplus_tree_node_t*   node = tree->root;
+    while (!node->leaf)
+    {
+        // the child covers [key[i - 1], key[i])
+        tt_size_t i = tt_bplus_tree_node_bound(tree, node, key, tt_true, tt_null);
+        if (path)
+        {
+            tt_assert_and_check_return_val(d < TT_BPLUS_TREE_DEPTH_MAXN, tt_null);
+            path[d]  = node;
+            index[d] = i;
+        }
+        d++;
+        node = tt_bplus_tree_childs(tree, node)[i];
+    }
+    if (depth) *depth = d;
+    return node;
+}
+
+static __tt_inline__ tt_size_t tt_bplus_tree_itor_make(tt_bplus_tree_node_t* leaf, tt_size_t slot)
+{
+    return (tt_size_t)leaf | slot;
+}
+
+static __tt_inline__ tt_bplus_tree_node_t* tt_bplus_tree_itor_leaf(tt_bplus_tree_t* tree, tt_size_t itor)
+{
+    return (tt_bplus_tree_node_t*)(itor & ~(tree->node_size - 1));
+}
+
+static __tt_inline__ tt_size_t tt_bplus_tree_itor_slot(tt_bplus_tree_t* tree, tt_size_t itor)
+{
+    return itor & (tree->node_size - 1);
+}
+
+// the itor of the slot, the slot may be the end of the leaf
+static tt_size_t tt_bplus_tree_itor_seek(tt_bplus_tree_node_t* leaf, tt_size_t slot)
+{
+    if (slot < leaf->size) return tt_bplus_tree_itor_make(leaf, slot);
+    return leaf->next ? tt_bplus_tree_itor_make(leaf->next, 0) : 0;
+}
+
+static tt_void_t tt_bplus_tree_leaf_insert(tt_bplus_tree_t* tree, tt_bplus_tree_node_t* leaf, tt_size_t slot, tt_cpointer_t key, tt_cpointer_t data)
+{
+    tt_size_t n = leaf->size - slot;
+    if (n)
+    {
+        tt_memmov(tt_bplus_tree_key(tree, leaf, slot + 1), tt_bplus_tree_key(tree, leaf, slot), n * tree->element_key.size);
+        tt_memmov(tt_bplus_tree_data(tree, leaf, slot + 1), tt_bplus_tree_data(tree, leaf, slot), n * tree->element_data.size);
+    }
+    tree->element_key.dupl(&tree->element_key, tt_bplus_tree_key(tree, leaf, slot), key);
+    tree->element_data.dupl(&tree->element_data, tt_bplus_tree_data(tree, leaf, slot), data);
+    leaf->size++;
+}
+
+// insert the key buffer and the right child of it to the inner
+static tt_void_t tt_bplus_tree_inner_insert(tt_bplus_tree_t* tree, tt_bplus_tree_node_t* inner, tt_size_t i, tt_byte_t const* kbuff, tt_bplus_tree_node_t* child)
+{
+    tt_bplus_tree_node_t** childs = tt_bplus_tree_childs(tree, inner);
+    tt_size_t n = inner->size - i;
+    if (n)
+    {
+        tt_memmov(tt_bplus_tree_key(tree, inner, i + 1), tt_bplus_tree_key(tree, inner, i), n * tree->element_key.size);
+        tt_memmov(childs + i + 2, childs + i + 1, n * sizeof(tt_bplus_tree_node_t*));
+    }
+    tt_memcpy(tt_bplus_tree_key(tree, inner, i), kbuff, tree->element_key.size);
+    childs[i + 1] = child;
+    inner->size++;
+}
+
+static tt_void_t tt_bplus_tree_leaf_remove(tt_bplus_tree_t* tree, tt_bplus_tree_node_t* leaf, tt_size_t slot)
+{
+    if (tree->element_key.free) tree->element_key.free(&tree->element_key, tt_bplus_tree_key(tree, leaf, slot));
+    if (tree->element_data.free) tree->element_data.free(&tree->element_data, tt_bplus_tree_data(tree, leaf, slot));
+
+    tt_size_t n = leaf->size - slot - 1;
+    if (n)
+    {
+        tt_memmov(tt_bplus_tree_key(tree, leaf, slot), tt_bplus_tree_key(tree, leaf, slot + 1), n * tree->element_key.size);
+        tt_memmov(tt_bplus_tree_data(tree, leaf, slot), tt_bplus_tree_data(tree, leaf, slot + 1), n * tree->element_data.size);
+    }
+    leaf->size--;
+}
+
+static tt_void_t tt_bplus_tree_remove_at(tt_bplus_tree_t* tree, tt_bplus_tree_node_t* leaf, tt_size_t slot, tt_bplus_tree_node_t** path, tt_size_t* index, tt_size_t depth)
+{
+    // remove the item
+    tt_bplus_tree_leaf_remove(tree, leaf, slot);
+    tree->size--;
+
+    // free the empty leaf if it is not the root
+    tt_check_return(!leaf->size && leaf != tree->root);
+    if (leaf->prev) leaf->prev->next = leaf->next;
+    else tree->head = leaf->next;
+    if (leaf->next) leaf->next->prev = leaf->prev;
+    else tree->last = leaf->prev;
+    tt_bplus_tree_node_free(tree, leaf);
+
+    // remove the empty child from the parents
+    while (depth--)
+    {
+        tt_bplus_tree_node_t*   inner = path[depth];
+        tt_bplus_tree_node_t**  childs = tt_bplus_tree_childs(tree, inner);
+        tt_size_t               i = index[depth];
+
+        // the inner has only this child? free it too
+        if (!inner->size)
+        {
+            tt_bplus_tree_node_free(tree, inner);
+            if (inner == tree->root)
+            {
+                // all items have been removed, the root is an empty leaf now
+                tree->root = tt_bplus_tree_node_make(tree, tt_true);
+                tree->head = tree->root;
+                tree->last = tree->root;
+                tt_assert(tree->root);
+                return;
+            }
+            continue;
+        }
+
+        // remove the child and the separator key of it
+        tt_size_t k = i ? i - 1 : 0;
+        if (tree->element_key.free) tree->element_key.free(&tree->element_key, tt_bplus_tree_key(tree, inner, k));
+        tt_memmov(tt_bplus_tree_key(tree, inner, k), tt_bplus_tree_key(tree, inner, k + 1), (inner->size - k - 1) * tree->element_key.size);
+        tt_memmov(childs + i, childs + i + 1, (inner->size - i) * sizeof(tt_bplus_tree_node_t*));
+        inner->size--;
+        break;
+    }
+
+    // collapse the root which has only one child
+    while (!tree->root->leaf && !tree->root->size)
+    {
+        tt_bplus_tree_node_t* root = tree->root;
+        tree->root = tt_bplus_tree_childs(tree, root)[0];
+        tt_bplus_tree_node_free(tree, root);
+    }
+}
+
+static tt_size_t tt_bplus_tree_itor_size(tt_iterator_ref_t iterator)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert(tree);
+
+    return tree->size;
+}
+
+static tt_size_t tt_bplus_tree_itor_head(tt_iterator_ref_t iterator)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert(tree);
+
+    return tree->size ? tt_bplus_tree_itor_make(tree->head, 0) : 0;
+}
+
+static tt_size_t tt_bplus_tree_itor_last(tt_iterator_ref_t iterator)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert(tree);
+
+    return tree->size ? tt_bplus_tree_itor_make(tree->last, tree->last->size - 1) : 0;
+}
+
+static tt_size_t tt_bplus_tree_itor_tail(tt_iterator_ref_t iterator)
+{
+    // tail, must't access
+    return 0;
+}
+
+static tt_size_t tt_bplus_tree_itor_next(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert_and_check_return_val(tree && itor, 0);
+
+    return tt_bplus_tree_itor_seek(tt_bplus_tree_itor_leaf(tree, itor), tt_bplus_tree_itor_slot(tree, itor) + 1);
+}
+
+static tt_size_t tt_bplus_tree_itor_prev(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert(tree);
+
+    // the prev of tail is last
+    if (!itor) return tt_bplus_tree_itor_last(iterator);
+
+    tt_bplus_tree_node_t*   leaf = tt_bplus_tree_itor_leaf(tree, itor);
+    tt_size_t               slot = tt_bplus_tree_itor_slot(tree, itor);
+    if (slot) return itor - 1;
+    return leaf->prev ? tt_bplus_tree_itor_make(leaf->prev, leaf->prev->size - 1) : 0;
+}
+
+static tt_pointer_t tt_bplus_tree_itor_item(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert_and_check_return_val(tree && itor, tt_null);
+
+    tt_bplus_tree_node_t*   leaf = tt_bplus_tree_itor_leaf(tree, itor);
+    tt_size_t               slot = tt_bplus_tree_itor_slot(tree, itor);
+    tree->item.key  = tt_bplus_tree_key_data(tree, leaf, slot);
+    tree->item.data = tree->element_data.data(&tree->element_data, tt_bplus_tree_data(tree, leaf, slot));
+    return &tree->item;
+}
+
+static tt_int32_t tt_bplus_tree_itor_comp(tt_iterator_ref_t iterator, tt_cpointer_t litem, tt_cpointer_t ritem)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert(tree && litem && ritem);
+
+    // compare the item key
+    return tree->element_key.comp(&tree->element_key, ((tt_bplus_tree_item_ref_t)litem)->key, ((tt_bplus_tree_item_ref_t)ritem)->key);
+}
+
+static tt_void_t tt_bplus_tree_itor_copy(tt_iterator_ref_t iterator, tt_size_t itor, tt_cpointer_t item)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert_and_check_return(tree && itor && item);
+
+    // copy the item data
+    tt_bplus_tree_node_t* leaf = tt_bplus_tree_itor_leaf(tree, itor);
+    tree->element_data.copy(&tree->element_data, tt_bplus_tree_data(tree, leaf, tt_bplus_tree_itor_slot(tree, itor)), ((tt_bplus_tree_item_ref_t)item)->data);
+}
+
+static tt_void_t tt_bplus_tree_itor_remove(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert_and_check_return(tree && itor);
+
+    // remove by key for the path, the key is freed after removing
+    tt_bplus_tree_node_t* leaf = tt_bplus_tree_itor_leaf(tree, itor);
+    tt_size_t             slot = tt_bplus_tree_itor_slot(tree, itor);
+    tt_bplus_tree_node_t* path[TT_BPLUS_TREE_DEPTH_MAXN];
+    tt_size_t             index[TT_BPLUS_TREE_DEPTH_MAXN];
+    tt_size_t             depth = 0;
+    if (tt_bplus_tree_seek(tree, tt_bplus_tree_key_data(tree, leaf, slot), path, index, &depth) == leaf)
+        tt_bplus_tree_remove_at(tree, leaf, slot, path, index, depth);
+}
+
+static tt_void_t tt_bplus_tree_itor_nremove(tt_iterator_ref_t iterator, tt_size_t prev, tt_size_t next, tt_size_t size)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)iterator;
+    tt_assert_and_check_return(tree);
+
+    // remove items in range(prev, next), prev is tail if removing from head
+    while (size--)
+    {
+        tt_size_t itor = prev ? tt_bplus_tree_itor_next(iterator, prev) : tt_bplus_tree_itor_head(iterator);
+        if (!itor || itor == next) break;
+
+        // the next itor may be changed after removing, so remove it by the prev itor again
+        tt_bplus_tree_itor_remove(iterator, itor);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_bplus_tree_ref_t tt_bplus_tree_init(tt_size_t node_size, tt_element_t element_key, tt_element_t element_data)
+{
+    return tt_bplus_tree_init_with_allocator(node_size, element_key, element_data, tt_null);
+}
+
+tt_bplus_tree_ref_t tt_bplus_tree_init_with_allocator(tt_size_t node_size, tt_element_t element_key, tt_element_t element_data, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(element_key.size && element_key.comp && element_key.data && element_key.dupl, tt_null);
+    tt_assert_and_check_return_val(element_data.size && element_data.data && element_data.dupl && element_data.repl, tt_null);
+
+    // done
+    tt_bool_t           ok = tt_false;
+    tt_bplus_tree_t*    tree = tt_null;
+    do
+    {
+        if (!node_size) node_size = TT_BPLUS_TREE_NODE_SIZE_DEFAULT;
+        tt_assert_and_check_break(tt_ispow2(node_size) && node_size >= TT_BPLUS_TREE_NODE_SIZE_MIN && node_size <= TT_BPLUS_TREE_NODE_SIZE_MAX);
+
+        tree = tt_allocator_malloc0(allocator, sizeof(tt_bplus_tree_t));
+        tt_assert_and_check_break(tree);
+        tree->allocator = allocator;
+
+        // init tree
+        tree->node_size    = node_size;
+        tree->element_key  = element_key;
+        tree->element_data = element_data;
+
+        // the leaf payload: keys, datas
+        tt_size_t ksize = element_key.size;
+        tt_size_t dsize = element_data.size;
+        tt_size_t payload = node_size - sizeof(tt_bplus_tree_node_t);
+        tt_size_t n = payload / (ksize + dsize);
+        while (n && tt_align_cpu(n * ksize) + n * dsize > payload) n--;
+        tree->leaf_maxn = n;
+        tree->leaf_doff = tt_align_cpu(n * ksize);
+
+        // the inner payload: keys, children
+        n = (payload - sizeof(tt_pointer_t)) / (ksize + sizeof(tt_pointer_t));
+        while (n && tt_align_cpu(n * ksize) + (n + 1) * sizeof(tt_pointer_t) > payload) n--;
+        tree->inner_maxn = n;
+        tree->inner_coff = tt_align_cpu(n * ksize);
+
+        // the node is too small?
+        tt_assert_and_check_break(tree->leaf_maxn >= 3 && tree->inner_maxn >= 3 && tree->leaf_maxn <= 0xffff && tree->inner_maxn <= 0xffff);
+
+        // make key buffers
+        tree->kbuff = (tt_byte_t*)tt_allocator_malloc(allocator, ksize << 1);
+        tt_assert_and_check_break(tree->kbuff);
+
+        // init iterator operation
+        static tt_iterator_op_t op =
+        {
+            tt_bplus_tree_itor_size,
+            tt_bplus_tree_itor_head,
+            tt_bplus_tree_itor_last,
+            tt_bplus_tree_itor_tail,
+            tt_bplus_tree_itor_prev,
+            tt_bplus_tree_itor_next,
+            tt_bplus_tree_itor_item,
+            tt_bplus_tree_itor_comp,
+            tt_bplus_tree_itor_copy,
+            tt_bplus_tree_itor_remove,
+            tt_bplus_tree_itor_nremove
+        };
+
+        // init itor
+        tree->itor.mode = TT_ITERATOR_MODE_FORWARD | TT_ITERATOR_MODE_REVERSE | TT_ITERATOR_MODE_MUTABLE;
+        tree->itor.priv = tt_null;
+        tree->itor.step = sizeof(tt_bplus_tree_item_t);
+        tree->itor.op   = &op;
+
+        // make the root leaf
+        tree->root = tt_bplus_tree_node_make(tree, tt_true);
+        tt_assert_and_check_break(tree->root);
+        tree->head = tree->root;
+        tree->last = tree->root;
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && tree)
+    {
+        if (tree->kbuff) tt_allocator_free(allocator, tree->kbuff);
+        tt_allocator_free(allocator, tree);
+        tree = tt_null;
+    }
+
+    return (tt_bplus_tree_ref_t)tree;
+}
+
+tt_void_t tt_bplus_tree_exit(tt_bplus_tree_ref_t self)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return(tree);
+
+    // free all nodes
+    if (tree->root) tt_bplus_tree_node_exit(tree, tree->root);
+    tree->root = tt_null;
+
+    // free key buffers
+    if (tree->kbuff)
+    {
+        tt_allocator_free(tree->allocator, tree->kbuff);
+        tree->kbuff = tt_null;
+    }
+
+    tt_allocator_free(tree->allocator, tree);
+}
+
+tt_void_t tt_bplus_tree_clear(tt_bplus_tree_ref_t self)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return(tree && tree->root);
+
+    // keep the root leaf only
+    if (tree->root->leaf)
+    {
+        if (tree->element_key.nfree) tree->element_key.nfree(&tree->element_key, tt_bplus_tree_key(tree, tree->root, 0), tree->root->size);
+        if (tree->element_data.nfree) tree->element_data.nfree(&tree->element_data, tt_bplus_tree_data(tree, tree->root, 0), tree->root->size);
+        tree->root->size = 0;
+    }
+    else
+    {
+        tt_bplus_tree_node_t* root = tt_bplus_tree_node_make(tree, tt_true);
+        tt_assert_and_check_return(root);
+
+        tt_bplus_tree_node_exit(tree, tree->root);
+        tree->root = root;
+    }
+    tree->head = tree->root;
+    tree->last = tree->root;
+    tree->size = 0;
+}
+
+tt_pointer_t tt_bplus_tree_get(tt_bplus_tree_ref_t self, tt_cpointer_t key)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return_val(tree, tt_null);
+
+    tt_size_t itor = tt_bplus_tree_find(self, key);
+    tt_check_return_val(itor, tt_null);
+
+    return tree->element_data.data(&tree->element_data, tt_bplus_tree_data(tree, tt_bplus_tree_itor_leaf(tree, itor), tt_bplus_tree_itor_slot(tree, itor)));
+}
+
+tt_size_t tt_bplus_tree_find(tt_bplus_tree_ref_t self, tt_cpointer_t key)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return_val(tree, 0);
+
+    tt_bool_t               found = tt_false;
+    tt_bplus_tree_node_t*   leaf = tt_bplus_tree_seek(tree, key, tt_null, tt_null, tt_null);
+    tt_size_t               slot = tt_bplus_tree_node_bound(tree, leaf, key, tt_false, &found);
+    return found ? tt_bplus_tree_itor_make(leaf, slot) : 0;
+}
+
+tt_size_t tt_bplus_tree_lower_bound(tt_bplus_tree_ref_t self, tt_cpointer_t key)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return_val(tree, 0);
+
+    tt_bplus_tree_node_t* leaf = tt_bplus_tree_seek(tree, key, tt_null, tt_null, tt_null);
+    return tt_bplus_tree_itor_seek(leaf, tt_bplus_tree_node_bound(tree, leaf, key, tt_false, tt_null));
+}
+
+tt_size_t tt_bplus_tree_upper_bound(tt_bplus_tree_ref_t self, tt_cpointer_t key)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return_val(tree, 0);
+
+    tt_bplus_tree_node_t* leaf = tt_bplus_tree_seek(tree, key, tt_null, tt_null, tt_null);
+    return tt_bplus_tree_itor_seek(leaf, tt_bplus_tree_node_bound(tree, leaf, key, tt_true, tt_null));
+}
+
+tt_bool_t tt_bplus_tree_insert(tt_bplus_tree_ref_t self, tt_cpointer_t key, tt_cpointer_t data)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return_val(tree, tt_false);
+
+    // seek the leaf
+    tt_bplus_tree_node_t*   path[TT_BPLUS_TREE_DEPTH_MAXN];
+    tt_size_t               index[TT_BPLUS_TREE_DEPTH_MAXN];
+    tt_size_t               depth = 0;
+    tt_bool_t               found = tt_false;
+    tt_bplus_tree_node_t*   leaf = tt_bplus_tree_seek(tree, key, path, index, &depth);
+    tt_assert_and_check_return_val(leaf, tt_false);
+
+    // replace the data if the key has been existed
+    tt_size_t slot = tt_bplus_tree_node_bound(tree, leaf, key, tt_false, &found);
+    if (found)
+    {
+        tree->element_data.repl(&tree->element_data, tt_bplus_tree_data(tree, leaf, slot), data);
+        return tt_true;
+    }
+
+    // not full? insert it
+    if (leaf->size < tree->leaf_maxn)
+    {
+        tt_bplus_tree_leaf_insert(tree, leaf, slot, key, data);
+        tree->size++;
+        return tt_true;
+    }
+
+    // make all nodes of the splitting first, then nothing need be rollbacked if failed
+    tt_bplus_tree_node_t*   nodes[TT_BPLUS_TREE_DEPTH_MAXN + 2];
+    tt_size_t               count = 1;
+    tt_size_t               d = depth;
+    while (d && path[d - 1]->size == tree->inner_maxn) { d--; count++; }
+    if (!d) count++;
+    tt_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        nodes[i] = tt_bplus_tree_node_make(tree, !i);
+        if (!nodes[i])
+        {
+            while (i--) tt_bplus_tree_node_free(tree, nodes[i]);
+            return tt_false;
+        }
+    }
+
+    // split the leaf, the right leaf gets the upper half
+    tt_bplus_tree_node_t*   right = nodes[0];
+    tt_size_t               mid = leaf->size >> 1;
+    tt_size_t               n = leaf->size - mid;
+    tt_memcpy(tt_bplus_tree_key(tree, right, 0), tt_bplus_tree_key(tree, leaf, mid), n * tree->element_key.size);
+    tt_memcpy(tt_bplus_tree_data(tree, right, 0), tt_bplus_tree_data(tree, leaf, mid), n * tree->element_data.size);
+    right->size = (tt_uint16_t)n;
+    leaf->size  = (tt_uint16_t)mid;
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next) leaf->next->prev = right;
+    else tree->last = right;
+    leaf->next = right;
+
+    // insert it
+    if (slot > mid) tt_bplus_tree_leaf_insert(tree, right, slot - mid, key, data);
+    else tt_bplus_tree_leaf_insert(tree, leaf, slot, key, data);
+    tree->size++;
+
+    // the separator key of the right leaf
+    tt_size_t   ksize = tree->element_key.size;
+    tt_byte_t*  sep = tree->kbuff;
+    tt_byte_t*  up = tree->kbuff + ksize;
+    tree->element_key.dupl(&tree->element_key, sep, tt_bplus_tree_key_data(tree, right, 0));
+
+    // insert the separator to the parents, split the full parents
+    tt_bplus_tree_node_t* child = right;
+    tt_size_t             next = 1;
+    while (depth--)
+    {
+        tt_bplus_tree_node_t* inner = path[depth];
+        tt_size_t             k = index[depth];
+        if (inner->size < tree->inner_maxn)
+        {
+            tt_bplus_tree_inner_insert(tree, inner, k, sep, child);
+            child = tt_null;
+            break;
+        }
+
+        /* split the inner with the inserted key, the middle key goes up
+         *
+         * left: keys[0, m), right: keys(m, maxn], the inserted key is at k
+         */
+        tt_bplus_tree_node_t*   inner_right = nodes[next++];
+        tt_bplus_tree_node_t**  childs = tt_bplus_tree_childs(tree, inner);
+        tt_bplus_tree_node_t**  rchilds = tt_bplus_tree_childs(tree, inner_right);
+        tt_size_t               maxn = inner->size;
+        tt_size_t               m = (maxn + 1) >> 1;
+        if (k < m)
+        {
+            // the middle key is keys[m - 1]
+            tt_memcpy(up, tt_bplus_tree_key(tree, inner, m - 1), ksize);
+            tt_memcpy(tt_bplus_tree_key(tree, inner_right, 0), tt_bplus_tree_key(tree, inner, m), (maxn - m) * ksize);
+            tt_memcpy(rchilds, childs + m, (maxn - m + 1) * sizeof(tt_bplus_tree_node_t*));
+            inner_right->size = (tt_uint16_t)(maxn - m);
+            inner->size = (tt_uint16_t)(m - 1);
+            tt_bplus_tree_inner_insert(tree, inner, k, sep, child);
+        }
+        else if (k == m)
+        {
+            // the middle key is the inserted key
+            tt_memcpy(up, sep, ksize);
+            tt_memcpy(tt_bplus_tree_key(tree, inner_right, 0), tt_bplus_tree_key(tree, inner, m), (maxn - m) * ksize);
+            rchilds[0] = child;
+            tt_memcpy(rchilds + 1, childs + m + 1, (maxn - m) * sizeof(tt_bplus_tree_node_t*));
+            inner_right->size = (tt_uint16_t)(maxn - m);
+            inner->size = (tt_uint16_t)m;
+        }
+        else
+        {
+            // the middle key is keys[m]
+            tt_memcpy(up, tt_bplus_tree_key(tree, inner, m), ksize);
+            tt_memcpy(tt_bplus_tree_key(tree, inner_right, 0), tt_bplus_tree_key(tree, inner, m + 1), (maxn - m - 1) * ksize);
+            tt_memcpy(rchilds, childs + m + 1, (maxn - m) * sizeof(tt_bplus_tree_node_t*));
+            inner_right->size = (tt_uint16_t)(maxn - m - 1);
+            inner->size = (tt_uint16_t)m;
+            tt_bplus_tree_inner_insert(tree, inner_right, k - m - 1, sep, child);
+        }
+
+        // the middle key is the separator of the upper level
+        tt_memcpy(sep, up, ksize);
+        child = inner_right;
+    }
+
+    // split the root
+    if (child)
+    {
+        tt_bplus_tree_node_t* root = nodes[next++];
+        tt_memcpy(tt_bplus_tree_key(tree, root, 0), sep, ksize);
+        tt_bplus_tree_childs(tree, root)[0] = tree->root;
+        tt_bplus_tree_childs(tree, root)[1] = child;
+        root->size = 1;
+        tree->root = root;
+    }
+    tt_assert(next == count);
+    return tt_true;
+}
+
+tt_void_t tt_bplus_tree_remove(tt_bplus_tree_ref_t self, tt_cpointer_t key)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return(tree);
+
+    // seek the leaf
+    tt_bplus_tree_node_t*   path[TT_BPLUS_TREE_DEPTH_MAXN];
+    tt_size_t               index[TT_BPLUS_TREE_DEPTH_MAXN];
+    tt_size_t               depth = 0;
+    tt_bool_t               found = tt_false;
+    tt_bplus_tree_node_t*   leaf = tt_bplus_tree_seek(tree, key, path, index, &depth);
+    tt_assert_and_check_return(leaf);
+
+    // remove it
+    tt_size_t slot = tt_bplus_tree_node_bound(tree, leaf, key, tt_false, &found);
+    if (found) tt_bplus_tree_remove_at(tree, leaf, slot, path, index, depth);
+}
+
+tt_bool_t tt_bplus_tree_load(tt_bplus_tree_ref_t self, tt_cpointer_t const* keys, tt_cpointer_t const* datas, tt_size_t size)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return_val(tree && ((keys && datas) || !size), tt_false);
+
+    // clear it first
+    tt_bplus_tree_clear(self);
+    tt_check_return_val(size, tt_true);
+
+    // check the sorted keys
+    tt_size_t i = 0;
+    for (i = 1; i < size; i++)
+    {
+        tt_check_return_val(tree->element_key.comp(&tree->element_key, keys[i - 1], keys[i]) < 0, tt_false);
+    }
+
+    // the leaf count
+    tt_size_t count = (size + tree->leaf_maxn - 1) / tree->leaf_maxn;
+
+    // the nodes and the first keys of the current level
+    tt_bool_t               ok = tt_false;
+    tt_bplus_tree_node_t**  nodes = (tt_bplus_tree_node_t**)tt_allocator_nalloc0(tree->allocator, sizeof(tt_bplus_tree_node_t*), count);
+    tt_cpointer_t*          firsts = (tt_cpointer_t*)tt_allocator_nalloc0(tree->allocator, sizeof(tt_cpointer_t), count);
+    do
+    {
+        tt_assert_and_check_break(nodes && firsts);
+
+        // make leaves, the root leaf is reused as the head leaf
+        tt_bplus_tree_node_t* prev = tt_null;
+        for (i = 0; i < count; i++)
+        {
+            tt_bplus_tree_node_t* leaf = i ? tt_bplus_tree_node_make(tree, tt_true) : tree->root;
+            tt_assert_and_check_break(leaf);
+
+            tt_size_t head = i * tree->leaf_maxn;
+            tt_size_t n = tt_min(tree->leaf_maxn, size - head);
+            tt_size_t j = 0;
+            for (j = 0; j < n; j++)
+            {
+                tree->element_key.dupl(&tree->element_key, tt_bplus_tree_key(tree, leaf, j), keys[head + j]);
+                tree->element_data.dupl(&tree->element_data, tt_bplus_tree_data(tree, leaf, j), datas[head + j]);
+            }
+            leaf->size = (tt_uint16_t)n;
+            leaf->prev = prev;
+            if (prev) prev->next = leaf;
+            prev = leaf;
+
+            nodes[i]  = leaf;
+            firsts[i] = tt_bplus_tree_key_data(tree, leaf, 0);
+            tree->size += n;
+        }
+        tree->last = prev;
+        if (i < count) break;
+
+        // make inner levels from the bottom
+        while (count > 1)
+        {
+            tt_size_t fanout = tree->inner_maxn + 1;
+            tt_size_t upper = (count + fanout - 1) / fanout;
+            for (i = 0; i < upper; i++)
+            {
+                tt_bplus_tree_node_t* inner = tt_bplus_tree_node_make(tree, tt_false);
+                tt_assert_and_check_break(inner);
+
+                tt_size_t head = i * fanout;
+                tt_size_t n = tt_min(fanout, count - head);
+                tt_size_t j = 0;
+                tt_bplus_tree_node_t** childs = tt_bplus_tree_childs(tree, inner);
+                for (j = 0; j < n; j++)
+                {
+                    childs[j] = nodes[head + j];
+                    if (j) tree->element_key.dupl(&tree->element_key, tt_bplus_tree_key(tree, inner, j - 1), firsts[head + j]);
+                }
+                inner->size = (tt_uint16_t)(n - 1);
+
+                // the lower level slots before head + n have been used
+                nodes[i]  = inner;
+                firsts[i] = firsts[head];
+            }
+            if (i < upper)
+            {
+                // attach the remaining lower nodes to the built part for freeing them by clear
+                tt_size_t j = 0;
+                for (j = 0; j < i; j++) tt_bplus_tree_node_exit(tree, nodes[j]);
+                tt_size_t rest = i * fanout;
+                for (; rest < count; rest++) tt_bplus_tree_node_exit(tree, nodes[rest]);
+                tree->root = tt_null;
+                break;
+            }
+            count = upper;
+        }
+        tt_check_break(tree->root);
+        tree->root = nodes[0];
+
+        ok = tt_true;
+
+    } while (0);
+
+    // failed? free the made leaves
+    if (!ok && tree->root)
+    {
+        if (nodes)
+        {
+            tt_size_t j = 0;
+            for (j = 1; j < count && nodes[j]; j++) tt_bplus_tree_node_exit(tree, nodes[j]);
+        }
+        tree->root->next = tt_null;
+        tt_bplus_tree_clear(self);
+    }
+    else if (!ok)
+    {
+        tree->root = tt_bplus_tree_node_make(tree, tt_true);
+        tt_assert(tree->root);
+        tree->head = tree->root;
+        tree->last = tree->root;
+        tree->size = 0;
+    }
+
+    if (nodes) tt_allocator_free(tree->allocator, nodes);
+    if (firsts) tt_allocator_free(tree->allocator, firsts);
+    return ok;
+}
+
+tt_size_t tt_bplus_tree_size(tt_bplus_tree_ref_t self)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return_val(tree, 0);
+
+    return tree->size;
+}
+
+tt_size_t tt_bplus_tree_height(tt_bplus_tree_ref_t self)
+{
+    tt_bplus_tree_t* tree = (tt_bplus_tree_t*)self;
+    tt_assert_and_check_return_val(tree, 0);
+
+    tt_size_t             height = 1;
+    tt_bplus_tree_node_t* node = tree->root;
+    while (!node->leaf)
+    {
+        node = tt_bplus_tree_childs(tree, node)[0];
+        height++;
+    }
+    return height;
+}
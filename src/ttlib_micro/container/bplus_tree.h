@@ -0,0 +1,231 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       bplus_tree.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-28
+ * @brief      bplus_tree.h file
+ */
+
+#ifndef TT_CONTAINER_BPLUS_TREE_H
+#define TT_CONTAINER_BPLUS_TREE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+#include "element/element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the node size of four cache lines
+#define TT_BPLUS_TREE_NODE_SIZE_SMALL           (256)
+
+/// the default node size
+#define TT_BPLUS_TREE_NODE_SIZE_DEFAULT         (512)
+
+/// the node size of one page
+#define TT_BPLUS_TREE_NODE_SIZE_PAGE            (4096)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the b+tree item type
+typedef struct __tt_bplus_tree_item_t
+{
+    /// the item key
+    tt_pointer_t        key;
+
+    /// the item data
+    tt_pointer_t        data;
+
+}tt_bplus_tree_item_t, *tt_bplus_tree_item_ref_t;
+
+/*! the b+tree ordered map ref type
+ *
+ * <pre>
+ *                        [    k3    |    k6    ]                      inner
+ *                       /           |           \
+ * leaves: [k0 k1 k2] <-> [k3 k4 k5] <-> [k6 k7] <-> ...              sorted
+ *          d0 d1 d2       d3 d4 d5       d6 d7
+ *
+ * all items are stored in the leaves which are linked in the key order,
+ * the nodes are fixed-size and aligned by the node size, so the keys of
+ * one node are searched in a few cache lines.
+ *
+ * the empty leaf is freed at once and the node is not merged when it is
+ * less than half full (free-at-empty), it is enough for the mixed insert
+ * and remove loads and keeps the remove simple.
+ *
+ * performance:
+ *
+ * insert:      O(log(n))
+ * remove:      O(log(n))
+ * find:        O(log(n))
+ * lower bound: O(log(n))
+ * load:        O(n), from the sorted input
+ *
+ * iterator:
+ * next: fast
+ * prev: fast
+ * </pre>
+ *
+ * @note the itor is invalid after inserting or removing
+ *
+ */
+typedef tt_iterator_ref_t tt_bplus_tree_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init b+tree
+ *
+ * @param node_size     the node bytes, pow2, .e.g TT_BPLUS_TREE_NODE_SIZE_PAGE, using the default size if be zero
+ * @param element_key   the element of item key, the comp function is required
+ * @param element_data  the element of item data
+ *
+ * @return              the b+tree
+ */
+tt_bplus_tree_ref_t     tt_bplus_tree_init(tt_size_t node_size, tt_element_t element_key, tt_element_t element_data);
+
+/*! init b+tree with the allocator
+ *
+ * @param node_size     the node bytes, pow2, .e.g TT_BPLUS_TREE_NODE_SIZE_PAGE, using the default size if be zero
+ * @param element_key   the element of item key, the comp function is required
+ * @param element_data  the element of item data
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the b+tree
+ */
+tt_bplus_tree_ref_t     tt_bplus_tree_init_with_allocator(tt_size_t node_size, tt_element_t element_key, tt_element_t element_data, tt_allocator_ref_t allocator);
+
+/*! exit b+tree
+ *
+ * @param tree          the b+tree
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bplus_tree_exit(tt_bplus_tree_ref_t tree);
+
+/*! clear b+tree
+ *
+ * @param tree          the b+tree
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bplus_tree_clear(tt_bplus_tree_ref_t tree);
+
+/*! get the item data from key
+ *
+ * @param tree          the b+tree
+ * @param key           the item key
+ *
+ * @return              the item data, tt_null if not found
+ */
+tt_pointer_t            tt_bplus_tree_get(tt_bplus_tree_ref_t tree, tt_cpointer_t key);
+
+/*! find the item from key
+ *
+ * @param tree          the b+tree
+ * @param key           the item key
+ *
+ * @return              the item itor, tt_iterator_tail(tree) if not found
+ */
+tt_size_t               tt_bplus_tree_find(tt_bplus_tree_ref_t tree, tt_cpointer_t key);
+
+/*! seek the first item which key >= the given key
+ *
+ * @code
+ *
+ * // walk the items of the key range [lower, upper)
+ * tt_size_t itor = tt_bplus_tree_lower_bound(tree, lower);
+ * tt_size_t tail = tt_bplus_tree_lower_bound(tree, upper);
+ * for (; itor != tail; itor = tt_iterator_next(tree, itor))
+ * {
+ *     tt_bplus_tree_item_ref_t item = (tt_bplus_tree_item_ref_t)tt_iterator_item(tree, itor);
+ *     // ...
+ * }
+ *
+ * @endcode
+ *
+ * @param tree          the b+tree
+ * @param key           the item key
+ *
+ * @return              the item itor, tt_iterator_tail(tree) if all keys < the given key
+ */
+tt_size_t               tt_bplus_tree_lower_bound(tt_bplus_tree_ref_t tree, tt_cpointer_t key);
+
+/*! seek the first item which key > the given key
+ *
+ * @param tree          the b+tree
+ * @param key           the item key
+ *
+ * @return              the item itor, tt_iterator_tail(tree) if all keys <= the given key
+ */
+tt_size_t               tt_bplus_tree_upper_bound(tt_bplus_tree_ref_t tree, tt_cpointer_t key);
+
+/*! insert item data from key, replace the data if the key has been existed
+ *
+ * @param tree          the b+tree
+ * @param key           the item key
+ * @param data          the item data
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_bplus_tree_insert(tt_bplus_tree_ref_t tree, tt_cpointer_t key, tt_cpointer_t data);
+
+/*! remove item from key
+ *
+ * @param tree          the b+tree
+ * @param key           the item key
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_bplus_tree_remove(tt_bplus_tree_ref_t tree, tt_cpointer_t key);
+
+/*! clear the b+tree and load the sorted items, the leaves are filled fully
+ *
+ * @param tree          the b+tree
+ * @param keys          the item keys, must be sorted and unique
+ * @param datas         the item datas
+ * @param size          the item count
+ *
+ * @return              tt_true or tt_false if the keys are not sorted
+ */
+tt_bool_t               tt_bplus_tree_load(tt_bplus_tree_ref_t tree, tt_cpointer_t const* keys, tt_cpointer_t const* datas, tt_size_t size);
+
+/*! the b+tree size
+ *
+ * @param tree          the b+tree
+ *
+ * @return              the b+tree size
+ */
+tt_size_t               tt_bplus_tree_size(tt_bplus_tree_ref_t tree);
+
+/*! the b+tree height, the levels of the nodes
+ *
+ * @param tree          the b+tree
+ *
+ * @return              the b+tree height
+ */
+tt_size_t               tt_bplus_tree_height(tt_bplus_tree_ref_t tree);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
@@ -18,6 +18,19 @@
 #include "list_entry.h"
 #include "single_list_entry.h"
 #include "queue_entry.h"
+#include "vector.h"
+#include "vector_define.h"
+#include "deque.h"
+#include "heap.h"
+#include "bloom_filter.h"
+#include "lru_cache.h"
+#include "bplus_tree.h"
+#include "bitmap.h"
+#include "radix_tree.h"
+#include "string_pool.h"
+#include "slot_map.h"
+#include "timer_wheel.h"
+#include "hash_map.h"
 
 #endif
 
@@ -0,0 +1,468 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       deque.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-25
+ * @brief      deque.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_DEQUE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "element/element.h"
+#include "deque.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default block bytes
+#define TT_DEQUE_BLOCK_BYTES            (4096)
+
+// the minimum item count of one block
+#define TT_DEQUE_BLOCK_MAXN_MIN         (16)
+
+// the initial block count
+#define TT_DEQUE_BLOCKS_MAXN            (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+typedef struct __tt_deque_t
+{
+    // iterator
+    tt_iterator_t       itor;
+
+    // the blocks ring
+    tt_byte_t**         blocks;
+
+    // the block count, pow2
+    tt_size_t           blocks_maxn;
+
+    // the item count of one block, pow2
+    tt_size_t           block_maxn;
+
+    // the block shift, block_maxn == 1 << block_shift
+    tt_size_t           block_shift;
+
+    // the position mask of all items, blocks_maxn * block_maxn - 1
+    tt_size_t           mask;
+
+    // the head position
+    tt_size_t           head;
+
+    // the deque size
+    tt_size_t           size;
+
+    // the element
+    tt_element_t        element;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_deque_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tt_inline__ tt_byte_t* tt_deque_buff(tt_deque_t* deque, tt_size_t itor)
+{
+    tt_size_t pos = (deque->head + itor) & deque->mask;
+    return deque->blocks[pos >> deque->block_shift] + (pos & (deque->block_maxn - 1)) * deque->element.size;
+}
+
+static tt_bool_t tt_deque_grow(tt_deque_t* deque)
+{
+    // the blocks ring is full now
+    tt_size_t blocks_maxn = deque->blocks_maxn << 1;
+    tt_assert_and_check_return_val(blocks_maxn > deque->blocks_maxn && (blocks_maxn << deque->block_shift) > deque->mask + 1, tt_false);
+
+    tt_byte_t** blocks = (tt_byte_t**)tt_allocator_nalloc0(deque->allocator, sizeof(tt_byte_t*), blocks_maxn);
+    tt_assert_and_check_return_val(blocks, tt_false);
+
+    // the head block is the first block now, only the block pointers are moved
+    tt_size_t i = 0;
+    tt_size_t head_block = deque->head >> deque->block_shift;
+    for (i = 0; i < deque->blocks_maxn; i++)
+        blocks[i] = deque->blocks[(head_block + i) & (deque->blocks_maxn - 1)];
+
+    /* the last items are in front of the head item in the head block if the head is not aligned,
+     * move them to the next block of the old last block
+     *
+     * before: [last items ... head ...] [...] ... [...]
+     * after:  [           ... head ...] [...] ... [...] [last items]
+     */
+    tt_size_t head = deque->head & (deque->block_maxn - 1);
+    if (head)
+    {
+        blocks[deque->blocks_maxn] = (tt_byte_t*)tt_allocator_nalloc0(deque->allocator, deque->element.size, deque->block_maxn);
+        if (!blocks[deque->blocks_maxn])
+        {
+            tt_allocator_free(deque->allocator, blocks);
+            return tt_false;
+        }
+        tt_memcpy(blocks[deque->blocks_maxn], blocks[0], head * deque->element.size);
+    }
+
+    // update blocks
+    tt_allocator_free(deque->allocator, deque->blocks);
+    deque->blocks      = blocks;
+    deque->blocks_maxn = blocks_maxn;
+    deque->mask        = (blocks_maxn << deque->block_shift) - 1;
+    deque->head        = head;
+
+    return tt_true;
+}
+
+static tt_byte_t* tt_deque_make(tt_deque_t* deque, tt_size_t pos)
+{
+    // make the block if it is not used before
+    tt_byte_t** block = &deque->blocks[pos >> deque->block_shift];
+    if (!*block) *block = (tt_byte_t*)tt_allocator_nalloc0(deque->allocator, deque->element.size, deque->block_maxn);
+    tt_assert_and_check_return_val(*block, tt_null);
+
+    return *block + (pos & (deque->block_maxn - 1)) * deque->element.size;
+}
+
+static tt_size_t tt_deque_itor_size(tt_iterator_ref_t iterator)
+{
+    tt_deque_t* deque = (tt_deque_t*)iterator;
+    tt_assert(deque);
+
+    return deque->size;
+}
+
+static tt_size_t tt_deque_itor_head(tt_iterator_ref_t iterator)
+{
+    // head
+    return 0;
+}
+
+static tt_size_t tt_deque_itor_last(tt_iterator_ref_t iterator)
+{
+    tt_deque_t* deque = (tt_deque_t*)iterator;
+    tt_assert(deque);
+
+    // last
+    return deque->size ? deque->size - 1 : 0;
+}
+
+static tt_size_t tt_deque_itor_tail(tt_iterator_ref_t iterator)
+{
+    tt_deque_t* deque = (tt_deque_t*)iterator;
+    tt_assert(deque);
+
+    // tail, must't access
+    return deque->size;
+}
+
+static tt_size_t tt_deque_itor_next(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_deque_t* deque = (tt_deque_t*)iterator;
+    tt_assert(deque);
+
+    tt_assert_and_check_return_val(itor < deque->size, deque->size);
+
+    return itor + 1;
+}
+
+static tt_size_t tt_deque_itor_prev(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_deque_t* deque = (tt_deque_t*)iterator;
+    tt_assert(deque);
+
+    tt_assert_and_check_return_val(itor && itor <= deque->size, 0);
+
+    return itor - 1;
+}
+
+static tt_pointer_t tt_deque_itor_item(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_deque_t* deque = (tt_deque_t*)iterator;
+    tt_assert_and_check_return_val(deque && itor < deque->size, tt_null);
+
+    return deque->element.data(&deque->element, tt_deque_buff(deque, itor));
+}
+
+static tt_void_t tt_deque_itor_copy(tt_iterator_ref_t iterator, tt_size_t itor, tt_cpointer_t data)
+{
+    tt_deque_t* deque = (tt_deque_t*)iterator;
+    tt_assert_and_check_return(deque && itor < deque->size);
+
+    deque->element.copy(&deque->element, tt_deque_buff(deque, itor), data);
+}
+
+static tt_int32_t tt_deque_itor_comp(tt_iterator_ref_t iterator, tt_cpointer_t ldata, tt_cpointer_t rdata)
+{
+    tt_deque_t* deque = (tt_deque_t*)iterator;
+    tt_assert(deque && deque->element.comp);
+
+    return deque->element.comp(&deque->element, ldata, rdata);
+}
+
+static tt_void_t tt_deque_itor_remove(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    // remove
+    tt_deque_remove((tt_deque_ref_t)iterator, itor);
+}
+
+static tt_void_t tt_deque_itor_nremove(tt_iterator_ref_t iterator, tt_size_t prev, tt_size_t next, tt_size_t size)
+{
+    tt_deque_t* deque = (tt_deque_t*)iterator;
+    tt_assert(deque);
+
+    // no size?
+    tt_check_return(size && deque->size);
+
+    // remove items in range(prev, next), prev is tail if removing from head
+    tt_size_t itor = (prev >= deque->size) ? 0 : prev + 1;
+    if (next > itor && next <= deque->size) size = tt_min(size, next - itor);
+    size = tt_min(size, deque->size - itor);
+
+    // remove
+    if (!itor) while (size--) tt_deque_remove_head(iterator);
+    else if (itor + size == deque->size) while (size--) tt_deque_remove_last(iterator);
+    else while (size--) tt_deque_remove(iterator, itor);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_deque_ref_t tt_deque_init(tt_size_t block_maxn, tt_element_t e)
+{
+    return tt_deque_init_with_allocator(block_maxn, e, tt_null);
+}
+
+tt_deque_ref_t tt_deque_init_with_allocator(tt_size_t block_maxn, tt_element_t e, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(e.size && e.data && e.dupl && e.repl && e.copy, tt_null);
+
+    // done
+    tt_bool_t   ok = tt_false;
+    tt_deque_t* deque = tt_null;
+    do
+    {
+        // the block item count, fill one page by default
+        if (!block_maxn) block_maxn = tt_max(TT_DEQUE_BLOCK_BYTES / e.size, TT_DEQUE_BLOCK_MAXN_MIN);
+        block_maxn = tt_align_pow2(block_maxn);
+
+        deque = tt_allocator_malloc0(allocator, sizeof(tt_deque_t));
+        tt_assert_and_check_break(deque);
+        deque->allocator = allocator;
+
+        // init deque
+        deque->element     = e;
+        deque->block_maxn  = block_maxn;
+        deque->block_shift = 0;
+        while (((tt_size_t)1 << deque->block_shift) < block_maxn) deque->block_shift++;
+        deque->blocks_maxn = TT_DEQUE_BLOCKS_MAXN;
+        deque->mask        = (deque->blocks_maxn << deque->block_shift) - 1;
+        deque->head        = 0;
+        deque->size        = 0;
+
+        // init iterator operation
+        static tt_iterator_op_t op =
+        {
+            tt_deque_itor_size,
+            tt_deque_itor_head,
+            tt_deque_itor_last,
+            tt_deque_itor_tail,
+            tt_deque_itor_prev,
+            tt_deque_itor_next,
+            tt_deque_itor_item,
+            tt_deque_itor_comp,
+            tt_deque_itor_copy,
+            tt_deque_itor_remove,
+            tt_deque_itor_nremove
+        };
+
+        // init itor
+        deque->itor.mode = TT_ITERATOR_MODE_FORWARD | TT_ITERATOR_MODE_REVERSE | TT_ITERATOR_MODE_RACCESS | TT_ITERATOR_MODE_MUTABLE;
+        deque->itor.priv = tt_null;
+        deque->itor.step = e.size;
+        deque->itor.op   = &op;
+
+        // make blocks ring, the blocks will be allocated when they are used
+        deque->blocks = (tt_byte_t**)tt_allocator_nalloc0(allocator, sizeof(tt_byte_t*), deque->blocks_maxn);
+        tt_assert_and_check_break(deque->blocks);
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && deque)
+    {
+        tt_allocator_free(allocator, deque);
+        deque = tt_null;
+    }
+
+    return (tt_deque_ref_t)deque;
+}
+
+tt_void_t tt_deque_exit(tt_deque_ref_t self)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return(deque);
+
+    // clear data
+    tt_deque_clear(self);
+
+    // free blocks
+    if (deque->blocks)
+    {
+        tt_size_t i = 0;
+        for (i = 0; i < deque->blocks_maxn; i++)
+        {
+            if (deque->blocks[i]) tt_allocator_free(deque->allocator, deque->blocks[i]);
+        }
+        tt_allocator_free(deque->allocator, deque->blocks);
+        deque->blocks = tt_null;
+    }
+
+    tt_allocator_free(deque->allocator, deque);
+}
+
+tt_void_t tt_deque_clear(tt_deque_ref_t self)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return(deque);
+
+    // free deque items
+    if (deque->element.free)
+    {
+        tt_size_t i = 0;
+        for (i = 0; i < deque->size; i++) deque->element.free(&deque->element, tt_deque_buff(deque, i));
+    }
+
+    deque->head = 0;
+    deque->size = 0;
+}
+
+tt_pointer_t tt_deque_head(tt_deque_ref_t self)
+{
+    return tt_deque_itor_item(self, tt_deque_itor_head(self));
+}
+
+tt_pointer_t tt_deque_last(tt_deque_ref_t self)
+{
+    return tt_deque_itor_item(self, tt_deque_itor_last(self));
+}
+
+tt_bool_t tt_deque_insert_head(tt_deque_ref_t self, tt_cpointer_t data)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return_val(deque, tt_false);
+
+    // full? grow the blocks ring
+    if (deque->size > deque->mask && !tt_deque_grow(deque)) return tt_false;
+
+    // make the head item
+    tt_size_t  head = (deque->head - 1) & deque->mask;
+    tt_byte_t* buff = tt_deque_make(deque, head);
+    tt_check_return_val(buff, tt_false);
+
+    deque->element.dupl(&deque->element, buff, data);
+    deque->head = head;
+    deque->size++;
+
+    return tt_true;
+}
+
+tt_bool_t tt_deque_insert_tail(tt_deque_ref_t self, tt_cpointer_t data)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return_val(deque, tt_false);
+
+    // full? grow the blocks ring
+    if (deque->size > deque->mask && !tt_deque_grow(deque)) return tt_false;
+
+    // make the tail item
+    tt_byte_t* buff = tt_deque_make(deque, (deque->head + deque->size) & deque->mask);
+    tt_check_return_val(buff, tt_false);
+
+    deque->element.dupl(&deque->element, buff, data);
+    deque->size++;
+
+    return tt_true;
+}
+
+tt_void_t tt_deque_replace(tt_deque_ref_t self, tt_size_t itor, tt_cpointer_t data)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return(deque && itor < deque->size);
+
+    deque->element.repl(&deque->element, tt_deque_buff(deque, itor), data);
+}
+
+tt_void_t tt_deque_remove(tt_deque_ref_t self, tt_size_t itor)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return(deque && itor < deque->size);
+
+    // free item
+    if (deque->element.free) deque->element.free(&deque->element, tt_deque_buff(deque, itor));
+
+    // move the items of the shorter side
+    tt_size_t i = 0;
+    tt_size_t n = deque->element.size;
+    if (itor < (deque->size >> 1))
+    {
+        for (i = itor; i; i--) tt_memcpy(tt_deque_buff(deque, i), tt_deque_buff(deque, i - 1), n);
+        deque->head = (deque->head + 1) & deque->mask;
+    }
+    else
+    {
+        for (i = itor; i + 1 < deque->size; i++) tt_memcpy(tt_deque_buff(deque, i), tt_deque_buff(deque, i + 1), n);
+    }
+    deque->size--;
+}
+
+tt_void_t tt_deque_remove_head(tt_deque_ref_t self)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return(deque && deque->size);
+
+    // free item
+    if (deque->element.free) deque->element.free(&deque->element, tt_deque_buff(deque, 0));
+
+    deque->head = (deque->head + 1) & deque->mask;
+    deque->size--;
+}
+
+tt_void_t tt_deque_remove_last(tt_deque_ref_t self)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return(deque && deque->size);
+
+    // free item
+    if (deque->element.free) deque->element.free(&deque->element, tt_deque_buff(deque, deque->size - 1));
+
+    deque->size--;
+}
+
+tt_size_t tt_deque_size(tt_deque_ref_t self)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return_val(deque, 0);
+
+    return deque->size;
+}
+
+tt_size_t tt_deque_maxn(tt_deque_ref_t self)
+{
+    tt_deque_t* deque = (tt_deque_t*)self;
+    tt_assert_and_check_return_val(deque, 0);
+
+    return deque->mask + 1;
+}
@@ -0,0 +1,199 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       deque.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-25
+ * @brief      deque.h file
+ */
+
+#ifndef TT_CONTAINER_DEQUE_H
+#define TT_CONTAINER_DEQUE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+#include "element/element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the deque ref type
+ *
+ * <pre>
+ * blocks: |--------|--------|--------|--------|
+ *          block2   block3   null     block1
+ *          ...last                    head...
+ *
+ * the items are stored in a ring of fixed-size blocks, the block item count
+ * and the block count are pow2, the item of itor is at:
+ *
+ * pos  = (head + itor) & (blocks_maxn * block_maxn - 1)
+ * item = blocks[pos / block_maxn] + (pos % block_maxn) * element.size
+ *
+ * the block is allocated only when it is used first and reused after removing,
+ * the blocks ring grows twice when it is full, only the block pointers are moved.
+ *
+ * performance:
+ *
+ * insert:
+ * insert head: fast, O(1)
+ * insert tail: fast, O(1)
+ *
+ * remove:
+ * remove midd: slow
+ * remove head: fast, O(1)
+ * remove last: fast, O(1)
+ *
+ * iterator:
+ * next: fast
+ * prev: fast
+ * item: fast, random access
+ * </pre>
+ *
+ * @note the itor of the same item is mutable
+ *
+ */
+typedef tt_iterator_ref_t tt_deque_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init deque
+ *
+ * @param block_maxn    the item count of one block, will be aligned by pow2, using the default count if be zero
+ * @param e             the element
+ *
+ * @return              the deque
+ */
+tt_deque_ref_t          tt_deque_init(tt_size_t block_maxn, tt_element_t e);
+
+/*! init deque with the allocator
+ *
+ * @param block_maxn    the item count of one block, will be aligned by pow2, using the default count if be zero
+ * @param e             the element
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the deque
+ */
+tt_deque_ref_t          tt_deque_init_with_allocator(tt_size_t block_maxn, tt_element_t e, tt_allocator_ref_t allocator);
+
+/*! exit deque
+ *
+ * @param deque         the deque
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_deque_exit(tt_deque_ref_t deque);
+
+/*! clear deque, the blocks will be kept for reusing
+ *
+ * @param deque         the deque
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_deque_clear(tt_deque_ref_t deque);
+
+/*! deque head item
+ *
+ * @param deque         the deque
+ *
+ * @return              the deque head item
+ */
+tt_pointer_t            tt_deque_head(tt_deque_ref_t deque);
+
+/*! deque last item
+ *
+ * @param deque         the deque
+ *
+ * @return              the deque last item
+ */
+tt_pointer_t            tt_deque_last(tt_deque_ref_t deque);
+
+/*! insert the deque head
+ *
+ * @param deque         the deque
+ * @param data          the data
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_deque_insert_head(tt_deque_ref_t deque, tt_cpointer_t data);
+
+/*! insert the deque tail
+ *
+ * @param deque         the deque
+ * @param data          the data
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_deque_insert_tail(tt_deque_ref_t deque, tt_cpointer_t data);
+
+/*! replace the deque item
+ *
+ * @param deque         the deque
+ * @param itor          the itor
+ * @param data          the data
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_deque_replace(tt_deque_ref_t deque, tt_size_t itor, tt_cpointer_t data);
+
+/*! remove the deque item, move the items of the shorter side
+ *
+ * @param deque         the deque
+ * @param itor          the itor
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_deque_remove(tt_deque_ref_t deque, tt_size_t itor);
+
+/*! remove the deque head item
+ *
+ * @param deque         the deque
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_deque_remove_head(tt_deque_ref_t deque);
+
+/*! remove the deque last item
+ *
+ * @param deque         the deque
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_deque_remove_last(tt_deque_ref_t deque);
+
+/*! the deque size
+ *
+ * @param deque         the deque
+ *
+ * @return              the deque size
+ */
+tt_size_t               tt_deque_size(tt_deque_ref_t deque);
+
+/*! the deque maxn, the item count of the current blocks ring
+ *
+ * @param deque         the deque
+ *
+ * @return              the deque maxn
+ */
+tt_size_t               tt_deque_maxn(tt_deque_ref_t deque);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
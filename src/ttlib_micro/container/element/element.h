@@ -14,6 +14,8 @@
  * includes
  */
 #include "prefix.h"
+#include "../string_pool.h"
+#include "../../memory/allocator.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -200,6 +202,36 @@ typedef struct __tt_element_t
  */
 tt_element_t        tt_element_uint8(tt_noarg_t);
 
+/*! the string element
+ *
+ * @param bcase     is case?
+ *
+ * @return          the element
+ */
+tt_element_t        tt_element_str(tt_bool_t bcase);
+
+/*! the string element with the allocator
+ *
+ * the strings are duplicated and freed by the allocator, .e.g tt_arena_allocator
+ *
+ * @param bcase     is case?
+ * @param allocator the allocator, using the native allocator if be tt_null
+ *
+ * @return          the element
+ */
+tt_element_t        tt_element_str_with_allocator(tt_bool_t bcase, tt_allocator_ref_t allocator);
+
+/*! the pooled string element
+ *
+ * the items are the handles of the string pool, so the equal strings are
+ * stored once and the duplicate and free are the reference operations.
+ *
+ * @param pool      the string pool
+ *
+ * @return          the element
+ */
+tt_element_t        tt_element_str_pooled(tt_string_pool_ref_t pool);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
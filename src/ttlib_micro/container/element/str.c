@@ -53,7 +53,7 @@ static tt_void_t tt_element_str_free(tt_element_ref_t e, tt_pointer_t buff)
     tt_pointer_t cstr =  *((tt_pointer_t*)buff);
     if(cstr)
     {
-        tt_free(cstr);
+        tt_allocator_free((tt_allocator_ref_t)e->priv, cstr);
 
         // clear it
         *((tt_pointer_t*)buff) = tt_null;
@@ -66,7 +66,7 @@ static tt_void_t tt_element_str_dupl(tt_element_ref_t e, tt_pointer_t buff, tt_c
     tt_assert_and_check_return(e && buff);
 
     // duplicate it
-    if(data) *((tt_pointer_t**)buff) = (tt_pointer_t)tt_strdup((tt_char_t const*)data);
+    if(data) *((tt_pointer_t**)buff) = (tt_pointer_t)tt_allocator_strdup((tt_allocator_ref_t)e->priv, (tt_char_t const*)data);
     else *((tt_pointer_t**)buff) = tt_null;
 }
 
@@ -136,12 +136,18 @@ static tt_void_t tt_element_str_nrepl(tt_element_ref_t e, tt_pointer_t buff, tt_
  * interfaces
  */
 tt_element_t        tt_element_str(tt_bool_t bcase)
+{
+    return tt_element_str_with_allocator(bcase, tt_null);
+}
+
+tt_element_t        tt_element_str_with_allocator(tt_bool_t bcase, tt_allocator_ref_t allocator)
 {
     tt_element_t e = {0};
 
     e.type   = TT_ELEMENT_TYPE_STR;
     e.flag   = !!(bcase);
     e.size   = sizeof(tt_char_t*);
+    e.priv   = allocator;
     e.hash   = tt_element_str_hash;
     e.comp   = tt_element_str_comp;
     e.data   = tt_element_str_data;
@@ -0,0 +1,159 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       str_pooled.c
+ * @ingroup    element
+ * @author     tango
+ * @date       2021-07-31
+ * @brief      str_pooled.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "element.h"
+#include "hash.h"
+#include "../../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private interfaces
+ */
+static tt_size_t tt_element_str_pooled_hash(tt_element_ref_t e, tt_cpointer_t data, tt_size_t mask, tt_size_t index)
+{
+    return tt_element_hash_cstr((tt_char_t const *)data, mask, index);
+}
+
+static tt_long_t tt_element_str_pooled_comp(tt_element_ref_t e, tt_cpointer_t ldata, tt_cpointer_t rdata)
+{
+    tt_assert_and_check_return_val(e && ldata && rdata, 0);
+
+    // the same handle? the data may be not the handle, so compare the string if the pointers are different
+    if (ldata == rdata) return 0;
+    return tt_strcmp((tt_char_t const *)ldata, (tt_char_t const *)rdata);
+}
+
+static tt_pointer_t tt_element_str_pooled_data(tt_element_ref_t e, tt_cpointer_t buff)
+{
+    /// check
+    tt_assert_and_check_return_val(buff, tt_null);
+
+    return *((tt_pointer_t*)buff);
+}
+
+static tt_char_t const * tt_element_str_pooled_cstr(tt_element_ref_t e, tt_cpointer_t data, tt_char_t *str, tt_size_t maxn)
+{
+    return (tt_char_t const *)data;
+}
+
+static tt_void_t tt_element_str_pooled_free(tt_element_ref_t e, tt_pointer_t buff)
+{
+    /// check
+    tt_assert_and_check_return(e && buff);
+
+    tt_char_t const* handle = *((tt_char_t const**)buff);
+    if(handle)
+    {
+        tt_string_pool_remove((tt_string_pool_ref_t)e->priv, handle);
+
+        // clear it
+        *((tt_pointer_t*)buff) = tt_null;
+    }
+}
+
+static tt_void_t tt_element_str_pooled_dupl(tt_element_ref_t e, tt_pointer_t buff, tt_cpointer_t data)
+{
+    // check
+    tt_assert_and_check_return(e && buff);
+
+    // reference it from the pool
+    if(data) *((tt_char_t const**)buff) = tt_string_pool_insert((tt_string_pool_ref_t)e->priv, (tt_char_t const*)data);
+    else *((tt_pointer_t*)buff) = tt_null;
+}
+
+static tt_void_t tt_element_str_pooled_repl(tt_element_ref_t e, tt_pointer_t buff, tt_cpointer_t data)
+{
+    // check
+    tt_assert_and_check_return(e && buff);
+
+    // reference the new string first, the old handle may be the same string
+    tt_char_t const* handle = *((tt_char_t const**)buff);
+    tt_element_str_pooled_dupl(e, buff, data);
+    if(handle) tt_string_pool_remove((tt_string_pool_ref_t)e->priv, handle);
+}
+
+static tt_void_t tt_element_str_pooled_copy(tt_element_ref_t e, tt_pointer_t buff, tt_cpointer_t data)
+{
+    // check
+    tt_assert_and_check_return(e && buff);
+
+    *((tt_cpointer_t*)buff) = data;
+}
+
+static tt_void_t tt_element_str_pooled_nfree(tt_element_ref_t e, tt_pointer_t buff, tt_size_t size)
+{
+    // check
+    tt_assert_and_check_return(e && buff);
+
+    // free
+    tt_size_t n = size;
+    while(n--) tt_element_str_pooled_free(e, (tt_byte_t*)buff + n * sizeof(tt_char_t*));
+}
+
+static tt_void_t tt_element_str_pooled_ncopy(tt_element_ref_t e, tt_pointer_t buff, tt_cpointer_t data, tt_size_t size)
+{
+    // check
+    tt_assert_and_check_return(buff);
+
+    // memset
+    if(size) tt_memset_ptr(buff, data, size);
+}
+
+static tt_void_t tt_element_str_pooled_ndupl(tt_element_ref_t e, tt_pointer_t buff, tt_cpointer_t data, tt_size_t size)
+{
+    // check
+    tt_assert_and_check_return(e && buff);
+    tt_check_return(size);
+
+    // insert it once and retain the handle for others
+    tt_element_str_pooled_dupl(e, buff, data);
+    tt_char_t const* handle = *((tt_char_t const**)buff);
+    while(--size) *((tt_char_t const**)buff + size) = handle? tt_string_pool_retain((tt_string_pool_ref_t)e->priv, handle) : tt_null;
+}
+
+static tt_void_t tt_element_str_pooled_nrepl(tt_element_ref_t e, tt_pointer_t buff, tt_cpointer_t data, tt_size_t size)
+{
+    // check
+    tt_assert_and_check_return(e && buff);
+
+    // replace
+    while(size--) tt_element_str_pooled_repl(e, (tt_byte_t*)buff + size * sizeof(tt_char_t*), data);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tt_element_t        tt_element_str_pooled(tt_string_pool_ref_t pool)
+{
+    tt_element_t e = {0};
+    tt_assert_and_check_return_val(pool, e);
+
+    e.type   = TT_ELEMENT_TYPE_STR;
+    e.flag   = 1;
+    e.size   = sizeof(tt_char_t*);
+    e.priv   = pool;
+    e.hash   = tt_element_str_pooled_hash;
+    e.comp   = tt_element_str_pooled_comp;
+    e.data   = tt_element_str_pooled_data;
+    e.cstr   = tt_element_str_pooled_cstr;
+    e.free   = tt_element_str_pooled_free;
+    e.dupl   = tt_element_str_pooled_dupl;
+    e.repl   = tt_element_str_pooled_repl;
+    e.copy   = tt_element_str_pooled_copy;
+    e.nfree  = tt_element_str_pooled_nfree;
+    e.ndupl  = tt_element_str_pooled_ndupl;
+    e.nrepl  = tt_element_str_pooled_nrepl;
+    e.ncopy  = tt_element_str_pooled_ncopy;
+
+    return e;
+}
@@ -0,0 +1,521 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       hash_map.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-18
+ * @brief      hash_map.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_HASH_MAP"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "element/element.h"
+#include "hash_map.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the hash mask for computing the cached hash, the top bit is reserved for the used flag
+#define TT_HASH_MAP_HASH_MASK           ((~(tt_size_t)0) >> 1)
+
+// the used flag of the cached hash, the empty slot hash is zero
+#define TT_HASH_MAP_HASH_USED           (~TT_HASH_MAP_HASH_MASK)
+
+// the load factor: 3/4
+#define TT_HASH_MAP_LOAD_NUMER          (3)
+#define TT_HASH_MAP_LOAD_DENOM          (4)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+typedef struct __tt_hash_map_t
+{
+    // iterator
+    tt_iterator_t       itor;
+
+    // the item names
+    tt_byte_t*          names;
+
+    // the item datas
+    tt_byte_t*          datas;
+
+    // the cached item hashs, zero: empty slot
+    tt_size_t*          hashs;
+
+    // the item count
+    tt_size_t           size;
+
+    // the slot count, pow2
+    tt_size_t           maxn;
+
+    // the slot mask
+    tt_size_t           mask;
+
+    // the item for iterator
+    tt_hash_map_item_t  item;
+
+    // the element of name
+    tt_element_t        element_name;
+
+    // the element of data
+    tt_element_t        element_data;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_hash_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tt_inline__ tt_size_t tt_hash_map_hash(tt_hash_map_t* hash_map, tt_cpointer_t name)
+{
+    return hash_map->element_name.hash(&hash_map->element_name, name, TT_HASH_MAP_HASH_MASK, 0) | TT_HASH_MAP_HASH_USED;
+}
+
+static __tt_inline__ tt_bool_t tt_hash_map_overload(tt_size_t size, tt_size_t maxn)
+{
+    return size * TT_HASH_MAP_LOAD_DENOM > maxn * TT_HASH_MAP_LOAD_NUMER;
+}
+
+/*! find the slot of the given name
+ *
+ * @param hash_map      the hash map
+ * @param name          the item name
+ * @param hash          the item hash
+ * @param found         the found result
+ *
+ * @return              the found slot or the first empty slot of the probe sequence
+ */
+static tt_size_t tt_hash_map_slot(tt_hash_map_t* hash_map, tt_cpointer_t name, tt_size_t hash, tt_bool_t* found)
+{
+    tt_element_ref_t e = &hash_map->element_name;
+    tt_size_t        i = hash & hash_map->mask;
+
+    // probe it, there is always an empty slot because of the load factor
+    *found = tt_false;
+    while (hash_map->hashs[i])
+    {
+        if (hash_map->hashs[i] == hash && !e->comp(e, e->data(e, hash_map->names + i * e->size), name))
+        {
+            *found = tt_true;
+            break;
+        }
+        i = (i + 1) & hash_map->mask;
+    }
+
+    return i;
+}
+
+static tt_bool_t tt_hash_map_rehash(tt_hash_map_t* hash_map, tt_size_t maxn)
+{
+    // check
+    tt_assert_and_check_return_val(tt_ispow2(maxn) && maxn > hash_map->size, tt_false);
+
+    tt_size_t  nsize = hash_map->element_name.size;
+    tt_size_t  dsize = hash_map->element_data.size;
+    tt_byte_t* names = tt_allocator_nalloc0(hash_map->allocator, maxn, nsize);
+    tt_byte_t* datas = tt_allocator_nalloc0(hash_map->allocator, maxn, dsize);
+    tt_size_t* hashs = tt_allocator_nalloc0(hash_map->allocator, maxn, sizeof(tt_size_t));
+    if (!names || !datas || !hashs)
+    {
+        if (names) tt_allocator_free(hash_map->allocator, names);
+        if (datas) tt_allocator_free(hash_map->allocator, datas);
+        if (hashs) tt_allocator_free(hash_map->allocator, hashs);
+        return tt_false;
+    }
+
+    // move items, the element buffers are moved directly without dupl and free
+    tt_size_t i = 0;
+    tt_size_t mask = maxn - 1;
+    for (i = 0; i < hash_map->maxn; i++)
+    {
+        tt_size_t hash = hash_map->hashs[i];
+        tt_check_continue(hash);
+
+        tt_size_t j = hash & mask;
+        while (hashs[j]) j = (j + 1) & mask;
+
+        tt_memcpy(names + j * nsize, hash_map->names + i * nsize, nsize);
+        tt_memcpy(datas + j * dsize, hash_map->datas + i * dsize, dsize);
+        hashs[j] = hash;
+    }
+
+    // update slots
+    tt_allocator_free(hash_map->allocator, hash_map->names);
+    tt_allocator_free(hash_map->allocator, hash_map->datas);
+    tt_allocator_free(hash_map->allocator, hash_map->hashs);
+    hash_map->names = names;
+    hash_map->datas = datas;
+    hash_map->hashs = hashs;
+    hash_map->maxn  = maxn;
+    hash_map->mask  = mask;
+
+    return tt_true;
+}
+
+static tt_void_t tt_hash_map_slot_free(tt_hash_map_t* hash_map, tt_size_t i)
+{
+    tt_element_ref_t en = &hash_map->element_name;
+    tt_element_ref_t ed = &hash_map->element_data;
+
+    if (en->free) en->free(en, hash_map->names + i * en->size);
+    if (ed->free) ed->free(ed, hash_map->datas + i * ed->size);
+}
+
+/*! remove the slot and shift the following items backward, no tombstone is needed
+ *
+ * @param hash_map      the hash map
+ * @param i             the removed slot
+ */
+static tt_void_t tt_hash_map_slot_remove(tt_hash_map_t* hash_map, tt_size_t i)
+{
+    tt_size_t nsize = hash_map->element_name.size;
+    tt_size_t dsize = hash_map->element_data.size;
+    tt_size_t mask  = hash_map->mask;
+
+    // free item
+    tt_hash_map_slot_free(hash_map, i);
+
+    // shift backward
+    tt_size_t j = i;
+    while (1)
+    {
+        j = (j + 1) & mask;
+        tt_check_break(hash_map->hashs[j]);
+
+        // the item at j can stay if its home slot is in (i, j] cyclically
+        tt_size_t k = hash_map->hashs[j] & mask;
+        if (i <= j ? (i < k && k <= j) : (i < k || k <= j)) continue;
+
+        // move j to i
+        tt_memcpy(hash_map->names + i * nsize, hash_map->names + j * nsize, nsize);
+        tt_memcpy(hash_map->datas + i * dsize, hash_map->datas + j * dsize, dsize);
+        hash_map->hashs[i] = hash_map->hashs[j];
+        i = j;
+    }
+
+    // clear the last hole
+    tt_memset(hash_map->names + i * nsize, 0, nsize);
+    tt_memset(hash_map->datas + i * dsize, 0, dsize);
+    hash_map->hashs[i] = 0;
+    hash_map->size--;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * iterator implementation
+ */
+static tt_size_t tt_hash_map_itor_size(tt_iterator_ref_t iterator)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert(hash_map);
+
+    return hash_map->size;
+}
+
+static tt_size_t tt_hash_map_itor_next(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert(hash_map);
+
+    // find the next used slot
+    tt_size_t i = itor + 1;
+    while (i < hash_map->maxn && !hash_map->hashs[i]) i++;
+
+    return i < hash_map->maxn ? i : hash_map->maxn;
+}
+
+static tt_size_t tt_hash_map_itor_prev(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert(hash_map && itor <= hash_map->maxn);
+
+    // find the prev used slot
+    tt_size_t i = itor;
+    while (i && !hash_map->hashs[i - 1]) i--;
+
+    return i ? i - 1 : hash_map->maxn;
+}
+
+static tt_size_t tt_hash_map_itor_head(tt_iterator_ref_t iterator)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert(hash_map);
+
+    // head
+    return hash_map->hashs[0] ? 0 : tt_hash_map_itor_next(iterator, 0);
+}
+
+static tt_size_t tt_hash_map_itor_last(tt_iterator_ref_t iterator)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert(hash_map);
+
+    // last
+    return tt_hash_map_itor_prev(iterator, hash_map->maxn);
+}
+
+static tt_size_t tt_hash_map_itor_tail(tt_iterator_ref_t iterator)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert(hash_map);
+
+    // tail, must't access
+    return hash_map->maxn;
+}
+
+static tt_pointer_t tt_hash_map_itor_item(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert_and_check_return_val(hash_map && itor < hash_map->maxn && hash_map->hashs[itor], tt_null);
+
+    // save item
+    hash_map->item.name = hash_map->element_name.data(&hash_map->element_name, hash_map->names + itor * hash_map->element_name.size);
+    hash_map->item.data = hash_map->element_data.data(&hash_map->element_data, hash_map->datas + itor * hash_map->element_data.size);
+
+    return &hash_map->item;
+}
+
+static tt_void_t tt_hash_map_itor_copy(tt_iterator_ref_t iterator, tt_size_t itor, tt_cpointer_t data)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert_and_check_return(hash_map && itor < hash_map->maxn && hash_map->hashs[itor]);
+
+    // only copy the item data, the name is the key
+    hash_map->element_data.copy(&hash_map->element_data, hash_map->datas + itor * hash_map->element_data.size, data);
+}
+
+static tt_int32_t tt_hash_map_itor_comp(tt_iterator_ref_t iterator, tt_cpointer_t litem, tt_cpointer_t ritem)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert(hash_map && hash_map->element_name.comp && litem && ritem);
+
+    // compare name
+    return hash_map->element_name.comp(&hash_map->element_name, ((tt_hash_map_item_ref_t)litem)->name, ((tt_hash_map_item_ref_t)ritem)->name);
+}
+
+static tt_void_t tt_hash_map_itor_remove(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)iterator;
+    tt_assert_and_check_return(hash_map && itor < hash_map->maxn && hash_map->hashs[itor]);
+
+    // remove
+    tt_hash_map_slot_remove(hash_map, itor);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_hash_map_ref_t tt_hash_map_init(tt_size_t bucket_size, tt_element_t element_name, tt_element_t element_data)
+{
+    return tt_hash_map_init_with_allocator(bucket_size, element_name, element_data, tt_null);
+}
+
+tt_hash_map_ref_t tt_hash_map_init_with_allocator(tt_size_t bucket_size, tt_element_t element_name, tt_element_t element_data, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(element_name.size && element_name.hash && element_name.comp && element_name.data && element_name.dupl, tt_null);
+    tt_assert_and_check_return_val(element_data.size && element_data.data && element_data.dupl && element_data.repl, tt_null);
+
+    // done
+    tt_bool_t      ok = tt_false;
+    tt_hash_map_t* hash_map = tt_null;
+    do
+    {
+        if (!bucket_size) bucket_size = TT_HASH_MAP_BUCKET_SIZE_MICRO;
+
+        hash_map = tt_allocator_malloc0(allocator, sizeof(tt_hash_map_t));
+        tt_assert_and_check_break(hash_map);
+        hash_map->allocator = allocator;
+
+        // init hash map
+        hash_map->size          = 0;
+        hash_map->maxn          = tt_align_pow2(bucket_size);
+        hash_map->mask          = hash_map->maxn - 1;
+        hash_map->element_name  = element_name;
+        hash_map->element_data  = element_data;
+        tt_assert_and_check_break(hash_map->maxn > 1);
+
+        // init iterator operation
+        static tt_iterator_op_t op =
+        {
+            tt_hash_map_itor_size,
+            tt_hash_map_itor_head,
+            tt_hash_map_itor_last,
+            tt_hash_map_itor_tail,
+            tt_hash_map_itor_prev,
+            tt_hash_map_itor_next,
+            tt_hash_map_itor_item,
+            tt_hash_map_itor_comp,
+            tt_hash_map_itor_copy,
+            tt_hash_map_itor_remove,
+            tt_null
+        };
+
+        // init itor
+        hash_map->itor.mode = TT_ITERATOR_MODE_FORWARD | TT_ITERATOR_MODE_REVERSE | TT_ITERATOR_MODE_MUTABLE;
+        hash_map->itor.priv = tt_null;
+        hash_map->itor.step = sizeof(tt_hash_map_item_t);
+        hash_map->itor.op   = &op;
+
+        // make slots
+        hash_map->names = tt_allocator_nalloc0(allocator, hash_map->maxn, element_name.size);
+        hash_map->datas = tt_allocator_nalloc0(allocator, hash_map->maxn, element_data.size);
+        hash_map->hashs = tt_allocator_nalloc0(allocator, hash_map->maxn, sizeof(tt_size_t));
+        tt_assert_and_check_break(hash_map->names && hash_map->datas && hash_map->hashs);
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && hash_map)
+    {
+        if (hash_map->names) tt_allocator_free(allocator, hash_map->names);
+        if (hash_map->datas) tt_allocator_free(allocator, hash_map->datas);
+        if (hash_map->hashs) tt_allocator_free(allocator, hash_map->hashs);
+        tt_allocator_free(allocator, hash_map);
+        hash_map = tt_null;
+    }
+
+    return (tt_hash_map_ref_t)hash_map;
+}
+
+tt_void_t tt_hash_map_exit(tt_hash_map_ref_t self)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)self;
+    tt_assert_and_check_return(hash_map);
+
+    // clear items
+    tt_hash_map_clear(self);
+
+    // free slots
+    if (hash_map->names) tt_allocator_free(hash_map->allocator, hash_map->names);
+    if (hash_map->datas) tt_allocator_free(hash_map->allocator, hash_map->datas);
+    if (hash_map->hashs) tt_allocator_free(hash_map->allocator, hash_map->hashs);
+
+    tt_allocator_free(hash_map->allocator, hash_map);
+}
+
+tt_void_t tt_hash_map_clear(tt_hash_map_ref_t self)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)self;
+    tt_assert_and_check_return(hash_map);
+
+    // free items
+    tt_size_t i = 0;
+    for (i = 0; i < hash_map->maxn && hash_map->size; i++)
+    {
+        tt_check_continue(hash_map->hashs[i]);
+
+        tt_hash_map_slot_free(hash_map, i);
+        hash_map->hashs[i] = 0;
+        hash_map->size--;
+    }
+
+    hash_map->size = 0;
+}
+
+tt_pointer_t tt_hash_map_get(tt_hash_map_ref_t self, tt_cpointer_t name)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)self;
+    tt_assert_and_check_return_val(hash_map, tt_null);
+
+    // find it
+    tt_bool_t found = tt_false;
+    tt_size_t i = tt_hash_map_slot(hash_map, name, tt_hash_map_hash(hash_map, name), &found);
+    tt_check_return_val(found, tt_null);
+
+    return hash_map->element_data.data(&hash_map->element_data, hash_map->datas + i * hash_map->element_data.size);
+}
+
+tt_size_t tt_hash_map_find(tt_hash_map_ref_t self, tt_cpointer_t name)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)self;
+    tt_assert_and_check_return_val(hash_map, 0);
+
+    // find it
+    tt_bool_t found = tt_false;
+    tt_size_t i = tt_hash_map_slot(hash_map, name, tt_hash_map_hash(hash_map, name), &found);
+
+    return found ? i : hash_map->maxn;
+}
+
+tt_size_t tt_hash_map_insert(tt_hash_map_ref_t self, tt_cpointer_t name, tt_cpointer_t data)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)self;
+    tt_assert_and_check_return_val(hash_map, 0);
+
+    // find it
+    tt_bool_t found = tt_false;
+    tt_size_t hash  = tt_hash_map_hash(hash_map, name);
+    tt_size_t i     = tt_hash_map_slot(hash_map, name, hash, &found);
+
+    // replace the data if the name has been existed
+    if (found)
+    {
+        hash_map->element_data.repl(&hash_map->element_data, hash_map->datas + i * hash_map->element_data.size, data);
+        return i;
+    }
+
+    // grow it
+    if (tt_hash_map_overload(hash_map->size + 1, hash_map->maxn))
+    {
+        if (!tt_hash_map_rehash(hash_map, hash_map->maxn << 1))
+        {
+            tt_trace_d("hash map rehash failed");
+            return hash_map->maxn;
+        }
+
+        // the empty slot has been changed
+        i = tt_hash_map_slot(hash_map, name, hash, &found);
+    }
+
+    // dupl item
+    hash_map->element_name.dupl(&hash_map->element_name, hash_map->names + i * hash_map->element_name.size, name);
+    hash_map->element_data.dupl(&hash_map->element_data, hash_map->datas + i * hash_map->element_data.size, data);
+    hash_map->hashs[i] = hash;
+    hash_map->size++;
+
+    return i;
+}
+
+tt_void_t tt_hash_map_remove(tt_hash_map_ref_t self, tt_cpointer_t name)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)self;
+    tt_assert_and_check_return(hash_map);
+
+    // find it
+    tt_bool_t found = tt_false;
+    tt_size_t i = tt_hash_map_slot(hash_map, name, tt_hash_map_hash(hash_map, name), &found);
+    tt_check_return(found);
+
+    // remove it
+    tt_hash_map_slot_remove(hash_map, i);
+}
+
+tt_size_t tt_hash_map_size(tt_hash_map_ref_t self)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)self;
+    tt_assert_and_check_return_val(hash_map, 0);
+
+    return hash_map->size;
+}
+
+tt_size_t tt_hash_map_maxn(tt_hash_map_ref_t self)
+{
+    tt_hash_map_t* hash_map = (tt_hash_map_t*)self;
+    tt_assert_and_check_return_val(hash_map, 0);
+
+    return hash_map->maxn;
+}
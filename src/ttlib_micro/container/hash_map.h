@@ -0,0 +1,183 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       hash_map.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-18
+ * @brief      hash_map.h file
+ */
+
+#ifndef TT_CONTAINER_HASH_MAP_H
+#define TT_CONTAINER_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+#include "element/element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the micro hash map bucket size
+#define TT_HASH_MAP_BUCKET_SIZE_MICRO                 (64)
+
+/// the small hash map bucket size
+#define TT_HASH_MAP_BUCKET_SIZE_SMALL                 (256)
+
+/// the large hash map bucket size
+#define TT_HASH_MAP_BUCKET_SIZE_LARGE                 (65536)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the hash map item type
+typedef struct __tt_hash_map_item_t
+{
+    /// the item name
+    tt_pointer_t        name;
+
+    /// the item data
+    tt_pointer_t        data;
+
+}tt_hash_map_item_t, *tt_hash_map_item_ref_t;
+
+/*! the hash map ref type
+ *
+ * <pre>
+ * slots: |-----|--------|-----|-----|--------|-----|--------|
+ *         name0   null   name1 name2   null   name3   null
+ *         data0          data1 data2          data3
+ *
+ * open addressing with linear probing, the slot count is pow2 and
+ * the slot index is (hash & mask), the table grows twice when the
+ * load factor reach 3/4, the item hash is cached in the slot, so
+ * rehash will not call the element hash function again.
+ *
+ * performance:
+ *
+ * insert: fast, O(1)
+ * remove: fast, O(1)
+ * find:   fast, O(1)
+ *
+ * iterator:
+ * next: fast
+ * prev: fast
+ * </pre>
+ *
+ * @note the itor of the same item is mutable, it will be changed after inserting or removing
+ *
+ */
+typedef tt_iterator_ref_t tt_hash_map_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init hash map
+ *
+ * @param bucket_size   the initial bucket size, will be aligned by pow2, using the default size if be zero
+ * @param element_name  the element of item name
+ * @param element_data  the element of item data
+ *
+ * @return              the hash map
+ */
+tt_hash_map_ref_t       tt_hash_map_init(tt_size_t bucket_size, tt_element_t element_name, tt_element_t element_data);
+
+/*! init hash map with the allocator
+ *
+ * @param bucket_size   the initial bucket size, will be aligned by pow2, using the default size if be zero
+ * @param element_name  the element of item name
+ * @param element_data  the element of item data
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the hash map
+ */
+tt_hash_map_ref_t       tt_hash_map_init_with_allocator(tt_size_t bucket_size, tt_element_t element_name, tt_element_t element_data, tt_allocator_ref_t allocator);
+
+/*! exit hash map
+ *
+ * @param hash_map      the hash map
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_hash_map_exit(tt_hash_map_ref_t hash_map);
+
+/*! clear hash map
+ *
+ * @param hash_map      the hash map
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_hash_map_clear(tt_hash_map_ref_t hash_map);
+
+/*! get the item data from name
+ *
+ * @param hash_map      the hash map
+ * @param name          the item name
+ *
+ * @return              the item data, tt_null if not found
+ */
+tt_pointer_t            tt_hash_map_get(tt_hash_map_ref_t hash_map, tt_cpointer_t name);
+
+/*! find the item from name
+ *
+ * @param hash_map      the hash map
+ * @param name          the item name
+ *
+ * @return              the item itor, tt_iterator_tail(hash_map) if not found
+ */
+tt_size_t               tt_hash_map_find(tt_hash_map_ref_t hash_map, tt_cpointer_t name);
+
+/*! insert item data from name, replace the data if the name has been existed
+ *
+ * @param hash_map      the hash map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              the item itor, tt_iterator_tail(hash_map) if failed
+ */
+tt_size_t               tt_hash_map_insert(tt_hash_map_ref_t hash_map, tt_cpointer_t name, tt_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param hash_map      the hash map
+ * @param name          the item name
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_hash_map_remove(tt_hash_map_ref_t hash_map, tt_cpointer_t name);
+
+/*! the hash map size
+ *
+ * @param hash_map      the hash map
+ *
+ * @return              the hash map size
+ */
+tt_size_t               tt_hash_map_size(tt_hash_map_ref_t hash_map);
+
+/*! the hash map maxn, the slot count
+ *
+ * @param hash_map      the hash map
+ *
+ * @return              the hash map maxn
+ */
+tt_size_t               tt_hash_map_maxn(tt_hash_map_ref_t hash_map);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
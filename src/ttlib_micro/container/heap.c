@@ -0,0 +1,545 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       heap.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-25
+ * @brief      heap.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_HEAP"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "element/element.h"
+#include "heap.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the heap grow
+#define TT_HEAP_GROW            (64)
+
+// the heap maxn, limited by the addressable bytes of the data and the temp item
+#define TT_HEAP_MAXN(isize)     (((~(tt_size_t)0) / tt_max(isize, sizeof(tt_size_t))) - 1)
+
+// the item buffer at the position
+#define tt_heap_buff(heap, pos) ((heap)->data + (pos) * (heap)->element.size)
+
+// the temp item buffer for sifting, it is the extra item after maxn items
+#define tt_heap_temp(heap)      tt_heap_buff(heap, (heap)->maxn)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+typedef struct __tt_heap_t
+{
+    // iterator
+    tt_iterator_t       itor;
+
+    // the heap data, maxn + 1 items, the last item is the temp item
+    tt_byte_t*          data;
+
+    // the item handles of the positions
+    tt_size_t*          hdls;
+
+    // the item positions of the handles, or the next free handle if the handle is free
+    tt_size_t*          poss;
+
+    // the heap size
+    tt_size_t           size;
+
+    // the heap maxn
+    tt_size_t           maxn;
+
+    // the heap grow
+    tt_size_t           grow;
+
+    // the children count of one item
+    tt_size_t           arity;
+
+    // the used handle count
+    tt_size_t           hused;
+
+    // the free handle list head
+    tt_size_t           hfree;
+
+    // the element
+    tt_element_t        element;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_heap_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tt_bool_t tt_heap_reserve(tt_heap_t* heap, tt_size_t maxn)
+{
+    // enough?
+    tt_check_return_val(maxn > heap->maxn, tt_true);
+    tt_assert_and_check_return_val(maxn <= TT_HEAP_MAXN(heap->element.size), tt_false);
+
+    // realloc data, the temp item is not in use now
+    tt_byte_t* data = (tt_byte_t*)tt_allocator_ralloc(heap->allocator, heap->data, (maxn + 1) * heap->element.size);
+    tt_assert_and_check_return_val(data, tt_false);
+    heap->data = data;
+
+    // realloc handles
+    tt_size_t* hdls = (tt_size_t*)tt_allocator_ralloc(heap->allocator, heap->hdls, maxn * sizeof(tt_size_t));
+    tt_assert_and_check_return_val(hdls, tt_false);
+    heap->hdls = hdls;
+
+    tt_size_t* poss = (tt_size_t*)tt_allocator_ralloc(heap->allocator, heap->poss, maxn * sizeof(tt_size_t));
+    tt_assert_and_check_return_val(poss, tt_false);
+    heap->poss = poss;
+
+    heap->maxn = maxn;
+    return tt_true;
+}
+
+static tt_bool_t tt_heap_resize(tt_heap_t* heap, tt_size_t size)
+{
+    // enough?
+    tt_check_return_val(size > heap->maxn, tt_true);
+
+    // grow twice for the amortized O(1) push
+    tt_size_t maxn = heap->maxn + tt_max(heap->maxn, heap->grow);
+    if (maxn < heap->maxn || maxn > TT_HEAP_MAXN(heap->element.size)) maxn = TT_HEAP_MAXN(heap->element.size);
+    return tt_heap_reserve(heap, tt_max(maxn, size));
+}
+
+static __tt_inline__ tt_long_t tt_heap_comp(tt_heap_t* heap, tt_cpointer_t lbuff, tt_cpointer_t rbuff)
+{
+    return heap->element.comp(&heap->element, heap->element.data(&heap->element, lbuff), heap->element.data(&heap->element, rbuff));
+}
+
+static __tt_inline__ tt_void_t tt_heap_move(tt_heap_t* heap, tt_size_t pos, tt_cpointer_t buff, tt_size_t hdl)
+{
+    tt_memcpy(tt_heap_buff(heap, pos), buff, heap->element.size);
+    heap->hdls[pos] = hdl;
+    heap->poss[hdl - 1] = pos;
+}
+
+static tt_size_t tt_heap_hdl_make(tt_heap_t* heap)
+{
+    tt_size_t hdl = 0;
+    if (heap->hfree)
+    {
+        hdl = heap->hfree;
+        heap->hfree = heap->poss[hdl - 1];
+    }
+    // the live handle count is the size, so the used count is always less than maxn here
+    else hdl = ++heap->hused;
+
+    return hdl;
+}
+
+static __tt_inline__ tt_void_t tt_heap_hdl_free(tt_heap_t* heap, tt_size_t hdl)
+{
+    heap->poss[hdl - 1] = heap->hfree;
+    heap->hfree = hdl;
+}
+
+static __tt_inline__ tt_bool_t tt_heap_hdl_check(tt_heap_t* heap, tt_size_t hdl)
+{
+    return hdl && hdl <= heap->hused && heap->poss[hdl - 1] < heap->size && heap->hdls[heap->poss[hdl - 1]] == hdl;
+}
+
+// sift up the temp item from the hole of the position
+static tt_void_t tt_heap_sift_up(tt_heap_t* heap, tt_size_t pos, tt_size_t hdl)
+{
+    tt_byte_t* temp = tt_heap_temp(heap);
+    while (pos)
+    {
+        tt_size_t parent = (pos - 1) / heap->arity;
+        if (tt_heap_comp(heap, tt_heap_buff(heap, parent), temp) <= 0) break;
+
+        // move the parent down to the hole
+        tt_heap_move(heap, pos, tt_heap_buff(heap, parent), heap->hdls[parent]);
+        pos = parent;
+    }
+    tt_heap_move(heap, pos, temp, hdl);
+}
+
+// sift down the temp item from the hole of the position
+static tt_void_t tt_heap_sift_down(tt_heap_t* heap, tt_size_t pos, tt_size_t hdl)
+{
+    tt_byte_t* temp = tt_heap_temp(heap);
+    while (1)
+    {
+        // no children?
+        tt_size_t head = pos * heap->arity + 1;
+        if (head >= heap->size || head <= pos) break;
+
+        // find the minimum child
+        tt_size_t tail = tt_min(head + heap->arity, heap->size);
+        tt_size_t child = head;
+        tt_size_t itor = head + 1;
+        for (; itor < tail; itor++)
+        {
+            if (tt_heap_comp(heap, tt_heap_buff(heap, itor), tt_heap_buff(heap, child)) < 0) child = itor;
+        }
+        if (tt_heap_comp(heap, tt_heap_buff(heap, child), temp) >= 0) break;
+
+        // move the child up to the hole
+        tt_heap_move(heap, pos, tt_heap_buff(heap, child), heap->hdls[child]);
+        pos = child;
+    }
+    tt_heap_move(heap, pos, temp, hdl);
+}
+
+// sift the temp item from the hole of the position to the right direction
+static tt_void_t tt_heap_sift(tt_heap_t* heap, tt_size_t pos, tt_size_t hdl)
+{
+    if (pos && tt_heap_comp(heap, tt_heap_temp(heap), tt_heap_buff(heap, (pos - 1) / heap->arity)) < 0)
+        tt_heap_sift_up(heap, pos, hdl);
+    else tt_heap_sift_down(heap, pos, hdl);
+}
+
+static tt_void_t tt_heap_remove_at(tt_heap_t* heap, tt_size_t pos)
+{
+    tt_assert_and_check_return(pos < heap->size);
+
+    // free item and handle
+    if (heap->element.free) heap->element.free(&heap->element, tt_heap_buff(heap, pos));
+    tt_heap_hdl_free(heap, heap->hdls[pos]);
+
+    // the last item fills the hole
+    heap->size--;
+    if (pos != heap->size)
+    {
+        tt_memcpy(tt_heap_temp(heap), tt_heap_buff(heap, heap->size), heap->element.size);
+        tt_heap_sift(heap, pos, heap->hdls[heap->size]);
+    }
+}
+
+static tt_size_t tt_heap_itor_size(tt_iterator_ref_t iterator)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert(heap);
+
+    return heap->size;
+}
+
+static tt_size_t tt_heap_itor_head(tt_iterator_ref_t iterator)
+{
+    // head
+    return 0;
+}
+
+static tt_size_t tt_heap_itor_last(tt_iterator_ref_t iterator)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert(heap);
+
+    // last
+    return heap->size ? heap->size - 1 : 0;
+}
+
+static tt_size_t tt_heap_itor_tail(tt_iterator_ref_t iterator)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert(heap);
+
+    // tail, must't access
+    return heap->size;
+}
+
+static tt_size_t tt_heap_itor_next(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert(heap);
+
+    tt_assert_and_check_return_val(itor < heap->size, heap->size);
+
+    return itor + 1;
+}
+
+static tt_size_t tt_heap_itor_prev(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert(heap);
+
+    tt_assert_and_check_return_val(itor && itor <= heap->size, 0);
+
+    return itor - 1;
+}
+
+static tt_pointer_t tt_heap_itor_item(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert_and_check_return_val(heap && itor < heap->size, tt_null);
+
+    return heap->element.data(&heap->element, tt_heap_buff(heap, itor));
+}
+
+static tt_void_t tt_heap_itor_copy(tt_iterator_ref_t iterator, tt_size_t itor, tt_cpointer_t data)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert_and_check_return(heap && itor < heap->size);
+
+    // replace and sift it, the item will be moved
+    tt_heap_replace(iterator, heap->hdls[itor], data);
+}
+
+static tt_int32_t tt_heap_itor_comp(tt_iterator_ref_t iterator, tt_cpointer_t ldata, tt_cpointer_t rdata)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert(heap && heap->element.comp);
+
+    return heap->element.comp(&heap->element, ldata, rdata);
+}
+
+static tt_void_t tt_heap_itor_remove(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert(heap);
+
+    // remove
+    tt_heap_remove_at(heap, itor);
+}
+
+static tt_void_t tt_heap_itor_nremove(tt_iterator_ref_t iterator, tt_size_t prev, tt_size_t next, tt_size_t size)
+{
+    tt_heap_t* heap = (tt_heap_t*)iterator;
+    tt_assert(heap);
+
+    // no size?
+    tt_check_return(size && heap->size);
+
+    // remove items in range(prev, next), prev is tail if removing from head
+    tt_size_t itor = (prev >= heap->size) ? 0 : prev + 1;
+    if (next > itor && next <= heap->size) size = tt_min(size, next - itor);
+    size = tt_min(size, heap->size - itor);
+
+    // remove from the last, the moved items are not in the range
+    while (size--) tt_heap_remove_at(heap, itor + size);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_heap_ref_t tt_heap_init(tt_size_t grow, tt_size_t arity, tt_element_t e)
+{
+    return tt_heap_init_with_allocator(grow, arity, e, tt_null);
+}
+
+tt_heap_ref_t tt_heap_init_with_allocator(tt_size_t grow, tt_size_t arity, tt_element_t e, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(e.size && e.data && e.dupl && e.repl && e.comp, tt_null);
+
+    // done
+    tt_bool_t  ok = tt_false;
+    tt_heap_t* heap = tt_null;
+    do
+    {
+        heap = tt_allocator_malloc0(allocator, sizeof(tt_heap_t));
+        tt_assert_and_check_break(heap);
+        heap->allocator = allocator;
+
+        // init heap
+        heap->element = e;
+        heap->grow    = grow ? grow : TT_HEAP_GROW;
+        heap->arity   = arity ? arity : TT_HEAP_ARITY_BINARY;
+        tt_assert_and_check_break(heap->arity > 1);
+
+        // init iterator operation
+        static tt_iterator_op_t op =
+        {
+            tt_heap_itor_size,
+            tt_heap_itor_head,
+            tt_heap_itor_last,
+            tt_heap_itor_tail,
+            tt_heap_itor_prev,
+            tt_heap_itor_next,
+            tt_heap_itor_item,
+            tt_heap_itor_comp,
+            tt_heap_itor_copy,
+            tt_heap_itor_remove,
+            tt_heap_itor_nremove
+        };
+
+        // init itor
+        heap->itor.mode = TT_ITERATOR_MODE_FORWARD | TT_ITERATOR_MODE_REVERSE | TT_ITERATOR_MODE_RACCESS | TT_ITERATOR_MODE_READONLY;
+        heap->itor.priv = tt_null;
+        heap->itor.step = e.size;
+        heap->itor.op   = &op;
+
+        // make data
+        if (!tt_heap_reserve(heap, heap->grow)) break;
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && heap)
+    {
+        tt_heap_exit((tt_heap_ref_t)heap);
+        heap = tt_null;
+    }
+
+    return (tt_heap_ref_t)heap;
+}
+
+tt_void_t tt_heap_exit(tt_heap_ref_t self)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return(heap);
+
+    // clear data
+    tt_heap_clear(self);
+
+    // free data
+    if (heap->data) tt_allocator_free(heap->allocator, heap->data);
+    if (heap->hdls) tt_allocator_free(heap->allocator, heap->hdls);
+    if (heap->poss) tt_allocator_free(heap->allocator, heap->poss);
+
+    tt_allocator_free(heap->allocator, heap);
+}
+
+tt_void_t tt_heap_clear(tt_heap_ref_t self)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return(heap);
+
+    // free heap items
+    if (heap->element.nfree) heap->element.nfree(&heap->element, heap->data, heap->size);
+    else if (heap->element.free)
+    {
+        tt_size_t i = 0;
+        for (i = 0; i < heap->size; i++) heap->element.free(&heap->element, tt_heap_buff(heap, i));
+    }
+
+    heap->size  = 0;
+    heap->hused = 0;
+    heap->hfree = 0;
+}
+
+tt_pointer_t tt_heap_top(tt_heap_ref_t self)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return_val(heap && heap->size, tt_null);
+
+    return heap->element.data(&heap->element, heap->data);
+}
+
+tt_size_t tt_heap_push(tt_heap_ref_t self, tt_cpointer_t data)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return_val(heap, 0);
+
+    // resize
+    if (!tt_heap_resize(heap, heap->size + 1))
+    {
+        tt_trace_d("heap resize failed");
+        return 0;
+    }
+
+    // dupl to the temp item and sift up from the tail
+    tt_size_t hdl = tt_heap_hdl_make(heap);
+    heap->element.dupl(&heap->element, tt_heap_temp(heap), data);
+    tt_heap_sift_up(heap, heap->size++, hdl);
+
+    return hdl;
+}
+
+tt_void_t tt_heap_pop(tt_heap_ref_t self)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return(heap && heap->size);
+
+    tt_heap_remove_at(heap, 0);
+}
+
+tt_bool_t tt_heap_heapify(tt_heap_ref_t self, tt_iterator_ref_t iterator)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return_val(heap && iterator && iterator != self, tt_false);
+
+    // resize
+    tt_size_t size = tt_iterator_size(iterator);
+    tt_check_return_val(size, tt_true);
+    if (size > TT_HEAP_MAXN(heap->element.size) - heap->size || !tt_heap_resize(heap, heap->size + size))
+    {
+        tt_trace_d("heap resize failed");
+        return tt_false;
+    }
+
+    // append items
+    tt_size_t itor = tt_iterator_head(iterator);
+    tt_size_t tail = tt_iterator_tail(iterator);
+    for (; itor != tail; itor = tt_iterator_next(iterator, itor))
+    {
+        tt_size_t hdl = tt_heap_hdl_make(heap);
+        heap->element.dupl(&heap->element, tt_heap_buff(heap, heap->size), tt_iterator_item(iterator, itor));
+        heap->hdls[heap->size] = hdl;
+        heap->poss[hdl - 1] = heap->size;
+        heap->size++;
+    }
+
+    // sift down all parents from the last parent, O(n)
+    tt_size_t pos = heap->size > 1 ? (heap->size - 2) / heap->arity + 1 : 0;
+    while (pos--)
+    {
+        tt_memcpy(tt_heap_temp(heap), tt_heap_buff(heap, pos), heap->element.size);
+        tt_heap_sift_down(heap, pos, heap->hdls[pos]);
+    }
+
+    return tt_true;
+}
+
+tt_pointer_t tt_heap_item(tt_heap_ref_t self, tt_size_t handle)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return_val(heap && tt_heap_hdl_check(heap, handle), tt_null);
+
+    return heap->element.data(&heap->element, tt_heap_buff(heap, heap->poss[handle - 1]));
+}
+
+tt_void_t tt_heap_replace(tt_heap_ref_t self, tt_size_t handle, tt_cpointer_t data)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return(heap && tt_heap_hdl_check(heap, handle));
+
+    // replace the item in the temp item and sift it from its hole
+    tt_size_t pos = heap->poss[handle - 1];
+    tt_memcpy(tt_heap_temp(heap), tt_heap_buff(heap, pos), heap->element.size);
+    heap->element.repl(&heap->element, tt_heap_temp(heap), data);
+    tt_heap_sift(heap, pos, handle);
+}
+
+tt_void_t tt_heap_remove(tt_heap_ref_t self, tt_size_t handle)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return(heap && tt_heap_hdl_check(heap, handle));
+
+    tt_heap_remove_at(heap, heap->poss[handle - 1]);
+}
+
+tt_size_t tt_heap_size(tt_heap_ref_t self)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return_val(heap, 0);
+
+    return heap->size;
+}
+
+tt_size_t tt_heap_maxn(tt_heap_ref_t self)
+{
+    tt_heap_t* heap = (tt_heap_t*)self;
+    tt_assert_and_check_return_val(heap, 0);
+
+    return heap->maxn;
+}
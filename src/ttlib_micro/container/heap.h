@@ -0,0 +1,198 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       heap.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-25
+ * @brief      heap.h file
+ */
+
+#ifndef TT_CONTAINER_HEAP_H
+#define TT_CONTAINER_HEAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+#include "element/element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the binary heap arity
+#define TT_HEAP_ARITY_BINARY            (2)
+
+/// the 4-ary heap arity, the children of one item are more likely in the same cache line
+#define TT_HEAP_ARITY_QUATERNARY        (4)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the min-heap ref type
+ *
+ * <pre>
+ * heap:    1      4      2      6      9      7      8     ...
+ *         [0]    [1]    [2]    [3]    [4]    [5]    [6]
+ *
+ * d-ary:   the children of [i] are [d * i + 1, d * i + d], the parent of [i] is [(i - 1) / d]
+ *
+ * the top item is the minimum item by the element comp, the item is sifted
+ * with a hole instead of swapping, and the heap keeps a handle for each item,
+ * the handle is not changed after sifting, so the item can be replaced or removed
+ * by the handle, .e.g decrease-key.
+ *
+ * performance:
+ *
+ * push:    O(log(n))
+ * pop:     O(log(n))
+ * top:     O(1)
+ * replace: O(log(n))
+ * remove:  O(log(n))
+ * heapify: O(n)
+ *
+ * iterator:
+ * next: fast
+ * prev: fast
+ * </pre>
+ *
+ * @note the iterator walks the items in the heap order, not the sorted order, and it is readonly
+ *
+ */
+typedef tt_iterator_ref_t tt_heap_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init heap
+ *
+ * @param grow          the item grow, using the default grow if be zero
+ * @param arity         the children count of one item, using TT_HEAP_ARITY_BINARY if be zero
+ * @param e             the element
+ *
+ * @return              the heap
+ */
+tt_heap_ref_t           tt_heap_init(tt_size_t grow, tt_size_t arity, tt_element_t e);
+
+/*! init heap with the allocator
+ *
+ * @param grow          the item grow, using the default grow if be zero
+ * @param arity         the children count of one item, using TT_HEAP_ARITY_BINARY if be zero
+ * @param e             the element
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the heap
+ */
+tt_heap_ref_t           tt_heap_init_with_allocator(tt_size_t grow, tt_size_t arity, tt_element_t e, tt_allocator_ref_t allocator);
+
+/*! exit heap
+ *
+ * @param heap          the heap
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_heap_exit(tt_heap_ref_t heap);
+
+/*! clear heap, all handles will be invalid
+ *
+ * @param heap          the heap
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_heap_clear(tt_heap_ref_t heap);
+
+/*! the heap top item, the minimum item
+ *
+ * @param heap          the heap
+ *
+ * @return              the top item, tt_null if the heap is empty
+ */
+tt_pointer_t            tt_heap_top(tt_heap_ref_t heap);
+
+/*! push the heap item
+ *
+ * @param heap          the heap
+ * @param data          the item data
+ *
+ * @return              the item handle, zero if failed
+ */
+tt_size_t               tt_heap_push(tt_heap_ref_t heap, tt_cpointer_t data);
+
+/*! pop the heap top item
+ *
+ * @param heap          the heap
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_heap_pop(tt_heap_ref_t heap);
+
+/*! push the items of the iterator and rebuild the heap in O(n)
+ *
+ * @param heap          the heap
+ * @param iterator      the iterator of the pushed items, .e.g the vector, must not be the heap self
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_heap_heapify(tt_heap_ref_t heap, tt_iterator_ref_t iterator);
+
+/*! the heap item of the handle
+ *
+ * @param heap          the heap
+ * @param handle        the item handle
+ *
+ * @return              the item
+ */
+tt_pointer_t            tt_heap_item(tt_heap_ref_t heap, tt_size_t handle);
+
+/*! replace the heap item of the handle and sift it, .e.g decrease-key
+ *
+ * @param heap          the heap
+ * @param handle        the item handle
+ * @param data          the item data
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_heap_replace(tt_heap_ref_t heap, tt_size_t handle, tt_cpointer_t data);
+
+/*! remove the heap item of the handle
+ *
+ * @param heap          the heap
+ * @param handle        the item handle
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_heap_remove(tt_heap_ref_t heap, tt_size_t handle);
+
+/*! the heap size
+ *
+ * @param heap          the heap
+ *
+ * @return              the heap size
+ */
+tt_size_t               tt_heap_size(tt_heap_ref_t heap);
+
+/*! the heap maxn
+ *
+ * @param heap          the heap
+ *
+ * @return              the heap maxn
+ */
+tt_size_t               tt_heap_maxn(tt_heap_ref_t heap);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
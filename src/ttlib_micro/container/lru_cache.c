@@ -0,0 +1,506 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       lru_cache.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-27
+ * @brief      lru_cache.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_LRU_CACHE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "element/element.h"
+#include "list_entry.h"
+#include "lru_cache.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the initial bucket count
+#define TT_LRU_CACHE_BUCKET_MAXN        (64)
+
+// the full hash mask
+#define TT_LRU_CACHE_HASH_MASK          (~(tt_size_t)0)
+
+// the node key buffer
+#define tt_lru_cache_node_key(node)             ((tt_byte_t*)((node) + 1))
+
+// the node data buffer
+#define tt_lru_cache_node_data(cache, node)     (tt_lru_cache_node_key(node) + tt_align_cpu((cache)->element_key.size))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the lru cache node type, the key and data buffers are placed after it
+typedef struct __tt_lru_cache_node_t
+{
+    // the recency list entry
+    tt_list_entry_t                     entry;
+
+    // the next node of the same bucket
+    struct __tt_lru_cache_node_t*       next;
+
+    // the key hash
+    tt_size_t                           hash;
+
+    // the item cost
+    tt_size_t                           cost;
+
+}tt_lru_cache_node_t;
+
+typedef struct __tt_lru_cache_t
+{
+    // iterator
+    tt_iterator_t           itor;
+
+    // the recency order, the head is the most recent
+    tt_list_entry_head_t    order;
+
+    // the buckets
+    tt_lru_cache_node_t**   buckets;
+
+    // the bucket count, pow2
+    tt_size_t               bucket_maxn;
+
+    // the total cost
+    tt_size_t               cost;
+
+    // the capacity
+    tt_size_t               capacity;
+
+    // the hit count
+    tt_hize_t               hits;
+
+    // the miss count
+    tt_hize_t               misses;
+
+    // the evict func
+    tt_lru_cache_evict_func_t func;
+
+    // the evict func private data
+    tt_cpointer_t           priv;
+
+    // the iterator item
+    tt_lru_cache_item_t     item;
+
+    // the element of key
+    tt_element_t            element_key;
+
+    // the element of data
+    tt_element_t            element_data;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_lru_cache_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tt_lru_cache_node_t** tt_lru_cache_find(tt_lru_cache_t* cache, tt_cpointer_t key, tt_size_t hash)
+{
+    // find the link of the node in the bucket chain
+    tt_lru_cache_node_t** link = &cache->buckets[hash & (cache->bucket_maxn - 1)];
+    while (*link)
+    {
+        tt_lru_cache_node_t* node = *link;
+        if (node->hash == hash && !cache->element_key.comp(&cache->element_key, cache->element_key.data(&cache->element_key, tt_lru_cache_node_key(node)), key))
+            break;
+        link = &node->next;
+    }
+    return link;
+}
+
+static tt_void_t tt_lru_cache_grow(tt_lru_cache_t* cache)
+{
+    // make the new buckets, keep the old buckets if failed
+    tt_size_t               bucket_maxn = cache->bucket_maxn << 1;
+    tt_lru_cache_node_t**   buckets = (tt_lru_cache_node_t**)tt_allocator_nalloc0(cache->allocator, sizeof(tt_lru_cache_node_t*), bucket_maxn);
+    tt_check_return(buckets);
+
+    // rehash by the cached hash
+    tt_size_t i = 0;
+    for (i = 0; i < cache->bucket_maxn; i++)
+    {
+        tt_lru_cache_node_t* node = cache->buckets[i];
+        while (node)
+        {
+            tt_lru_cache_node_t*    next = node->next;
+            tt_lru_cache_node_t**   link = &buckets[node->hash & (bucket_maxn - 1)];
+            node->next = *link;
+            *link = node;
+            node = next;
+        }
+    }
+
+    tt_allocator_free(cache->allocator, cache->buckets);
+    cache->buckets     = buckets;
+    cache->bucket_maxn = bucket_maxn;
+}
+
+static tt_void_t tt_lru_cache_node_exit(tt_lru_cache_t* cache, tt_lru_cache_node_t** link, tt_bool_t evict)
+{
+    tt_lru_cache_node_t* node = *link;
+
+    // evict it
+    if (evict && cache->func)
+    {
+        cache->func(cache->element_key.data(&cache->element_key, tt_lru_cache_node_key(node))
+                ,   cache->element_data.data(&cache->element_data, tt_lru_cache_node_data(cache, node))
+                ,   cache->priv);
+    }
+
+    // remove it from the bucket and the order
+    *link = node->next;
+    tt_list_entry_remove(&cache->order, &node->entry);
+    cache->cost -= node->cost;
+
+    // free it
+    if (cache->element_key.free) cache->element_key.free(&cache->element_key, tt_lru_cache_node_key(node));
+    if (cache->element_data.free) cache->element_data.free(&cache->element_data, tt_lru_cache_node_data(cache, node));
+    tt_allocator_free(cache->allocator, node);
+}
+
+static tt_void_t tt_lru_cache_evict(tt_lru_cache_t* cache, tt_size_t capacity)
+{
+    // evict the least recent items
+    while (cache->cost > capacity && tt_list_entry_size(&cache->order))
+    {
+        tt_lru_cache_node_t* node = (tt_lru_cache_node_t*)tt_list_entry(&cache->order, tt_list_entry_last(&cache->order));
+        tt_lru_cache_node_exit(cache, tt_lru_cache_find(cache, cache->element_key.data(&cache->element_key, tt_lru_cache_node_key(node)), node->hash), tt_true);
+    }
+}
+
+static tt_size_t tt_lru_cache_itor_size(tt_iterator_ref_t iterator)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)iterator;
+    tt_assert(cache);
+
+    return tt_list_entry_size(&cache->order);
+}
+
+static tt_size_t tt_lru_cache_itor_head(tt_iterator_ref_t iterator)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)iterator;
+    tt_assert(cache);
+
+    return (tt_size_t)tt_list_entry_head(&cache->order);
+}
+
+static tt_size_t tt_lru_cache_itor_last(tt_iterator_ref_t iterator)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)iterator;
+    tt_assert(cache);
+
+    return (tt_size_t)tt_list_entry_last(&cache->order);
+}
+
+static tt_size_t tt_lru_cache_itor_tail(tt_iterator_ref_t iterator)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)iterator;
+    tt_assert(cache);
+
+    // tail, must't access
+    return (tt_size_t)tt_list_entry_tail(&cache->order);
+}
+
+static tt_size_t tt_lru_cache_itor_next(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_assert(itor);
+
+    return (tt_size_t)tt_list_entry_next((tt_list_entry_ref_t)itor);
+}
+
+static tt_size_t tt_lru_cache_itor_prev(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_assert(itor);
+
+    return (tt_size_t)tt_list_entry_prev((tt_list_entry_ref_t)itor);
+}
+
+static tt_pointer_t tt_lru_cache_itor_item(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)iterator;
+    tt_assert_and_check_return_val(cache && itor, tt_null);
+
+    tt_lru_cache_node_t* node = (tt_lru_cache_node_t*)tt_list_entry(&cache->order, itor);
+    cache->item.key  = cache->element_key.data(&cache->element_key, tt_lru_cache_node_key(node));
+    cache->item.data = cache->element_data.data(&cache->element_data, tt_lru_cache_node_data(cache, node));
+    return &cache->item;
+}
+
+static tt_int32_t tt_lru_cache_itor_comp(tt_iterator_ref_t iterator, tt_cpointer_t litem, tt_cpointer_t ritem)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)iterator;
+    tt_assert(cache && litem && ritem);
+
+    // compare the item key
+    return cache->element_key.comp(&cache->element_key, ((tt_lru_cache_item_ref_t)litem)->key, ((tt_lru_cache_item_ref_t)ritem)->key);
+}
+
+static tt_void_t tt_lru_cache_itor_copy(tt_iterator_ref_t iterator, tt_size_t itor, tt_cpointer_t item)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)iterator;
+    tt_assert_and_check_return(cache && itor && item);
+
+    // copy the item data
+    tt_lru_cache_node_t* node = (tt_lru_cache_node_t*)tt_list_entry(&cache->order, itor);
+    cache->element_data.copy(&cache->element_data, tt_lru_cache_node_data(cache, node), ((tt_lru_cache_item_ref_t)item)->data);
+}
+
+static tt_void_t tt_lru_cache_itor_remove(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)iterator;
+    tt_assert_and_check_return(cache && itor);
+
+    tt_lru_cache_node_t* node = (tt_lru_cache_node_t*)tt_list_entry(&cache->order, itor);
+    tt_lru_cache_node_exit(cache, tt_lru_cache_find(cache, cache->element_key.data(&cache->element_key, tt_lru_cache_node_key(node)), node->hash), tt_false);
+}
+
+static tt_void_t tt_lru_cache_itor_nremove(tt_iterator_ref_t iterator, tt_size_t prev, tt_size_t next, tt_size_t size)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)iterator;
+    tt_assert_and_check_return(cache && prev && next);
+
+    // remove items in range(prev, next)
+    tt_size_t itor = tt_lru_cache_itor_next(iterator, prev);
+    while (size-- && itor != next)
+    {
+        tt_size_t itor_next = tt_lru_cache_itor_next(iterator, itor);
+        tt_lru_cache_itor_remove(iterator, itor);
+        itor = itor_next;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_lru_cache_ref_t tt_lru_cache_init(tt_size_t capacity, tt_element_t element_key, tt_element_t element_data, tt_lru_cache_evict_func_t func, tt_cpointer_t priv)
+{
+    return tt_lru_cache_init_with_allocator(capacity, element_key, element_data, func, priv, tt_null);
+}
+
+tt_lru_cache_ref_t tt_lru_cache_init_with_allocator(tt_size_t capacity, tt_element_t element_key, tt_element_t element_data, tt_lru_cache_evict_func_t func, tt_cpointer_t priv, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(element_key.size && element_key.hash && element_key.comp && element_key.data && element_key.dupl, tt_null);
+    tt_assert_and_check_return_val(element_data.size && element_data.data && element_data.dupl && element_data.repl, tt_null);
+
+    // done
+    tt_bool_t       ok = tt_false;
+    tt_lru_cache_t* cache = tt_null;
+    do
+    {
+        cache = tt_allocator_malloc0(allocator, sizeof(tt_lru_cache_t));
+        tt_assert_and_check_break(cache);
+        cache->allocator = allocator;
+
+        // init cache
+        cache->capacity     = capacity;
+        cache->func         = func;
+        cache->priv         = priv;
+        cache->element_key  = element_key;
+        cache->element_data = element_data;
+        tt_list_entry_init(&cache->order, tt_lru_cache_node_t, entry, tt_null);
+
+        // init iterator operation
+        static tt_iterator_op_t op =
+        {
+            tt_lru_cache_itor_size,
+            tt_lru_cache_itor_head,
+            tt_lru_cache_itor_last,
+            tt_lru_cache_itor_tail,
+            tt_lru_cache_itor_prev,
+            tt_lru_cache_itor_next,
+            tt_lru_cache_itor_item,
+            tt_lru_cache_itor_comp,
+            tt_lru_cache_itor_copy,
+            tt_lru_cache_itor_remove,
+            tt_lru_cache_itor_nremove
+        };
+
+        // init itor
+        cache->itor.mode = TT_ITERATOR_MODE_FORWARD | TT_ITERATOR_MODE_REVERSE | TT_ITERATOR_MODE_READONLY;
+        cache->itor.priv = tt_null;
+        cache->itor.step = sizeof(tt_lru_cache_item_t);
+        cache->itor.op   = &op;
+
+        // make buckets
+        cache->bucket_maxn = TT_LRU_CACHE_BUCKET_MAXN;
+        cache->buckets = (tt_lru_cache_node_t**)tt_allocator_nalloc0(allocator, sizeof(tt_lru_cache_node_t*), cache->bucket_maxn);
+        tt_assert_and_check_break(cache->buckets);
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && cache)
+    {
+        tt_allocator_free(allocator, cache);
+        cache = tt_null;
+    }
+
+    return (tt_lru_cache_ref_t)cache;
+}
+
+tt_void_t tt_lru_cache_exit(tt_lru_cache_ref_t self)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return(cache);
+
+    // clear data
+    tt_lru_cache_clear(self);
+
+    // free buckets
+    if (cache->buckets)
+    {
+        tt_allocator_free(cache->allocator, cache->buckets);
+        cache->buckets = tt_null;
+    }
+    tt_list_entry_exit(&cache->order);
+
+    tt_allocator_free(cache->allocator, cache);
+}
+
+tt_void_t tt_lru_cache_clear(tt_lru_cache_ref_t self)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return(cache && cache->buckets);
+
+    // free all nodes by buckets
+    tt_size_t i = 0;
+    for (i = 0; i < cache->bucket_maxn; i++)
+    {
+        while (cache->buckets[i]) tt_lru_cache_node_exit(cache, &cache->buckets[i], tt_false);
+    }
+}
+
+tt_pointer_t tt_lru_cache_get(tt_lru_cache_ref_t self, tt_cpointer_t key)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return_val(cache, tt_null);
+
+    // find it
+    tt_lru_cache_node_t* node = *tt_lru_cache_find(cache, key, cache->element_key.hash(&cache->element_key, key, TT_LRU_CACHE_HASH_MASK, 0));
+    if (!node)
+    {
+        cache->misses++;
+        return tt_null;
+    }
+    cache->hits++;
+
+    // make it be the most recent item
+    if (!tt_list_entry_is_head(&cache->order, &node->entry))
+    {
+        tt_list_entry_remove(&cache->order, &node->entry);
+        tt_list_entry_insert_head(&cache->order, &node->entry);
+    }
+
+    return cache->element_data.data(&cache->element_data, tt_lru_cache_node_data(cache, node));
+}
+
+tt_bool_t tt_lru_cache_put(tt_lru_cache_ref_t self, tt_cpointer_t key, tt_cpointer_t data, tt_size_t cost)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return_val(cache, tt_false);
+
+    // too large?
+    tt_check_return_val(cost <= cache->capacity, tt_false);
+
+    // replace it if the key has been existed
+    tt_size_t               hash = cache->element_key.hash(&cache->element_key, key, TT_LRU_CACHE_HASH_MASK, 0);
+    tt_lru_cache_node_t**   link = tt_lru_cache_find(cache, key, hash);
+    tt_lru_cache_node_t*    node = *link;
+    if (node)
+    {
+        cache->element_data.repl(&cache->element_data, tt_lru_cache_node_data(cache, node), data);
+        cache->cost -= node->cost;
+        tt_list_entry_remove(&cache->order, &node->entry);
+    }
+    else
+    {
+        // make node
+        node = (tt_lru_cache_node_t*)tt_allocator_malloc0(cache->allocator, sizeof(tt_lru_cache_node_t) + tt_align_cpu(cache->element_key.size) + cache->element_data.size);
+        tt_assert_and_check_return_val(node, tt_false);
+
+        cache->element_key.dupl(&cache->element_key, tt_lru_cache_node_key(node), key);
+        cache->element_data.dupl(&cache->element_data, tt_lru_cache_node_data(cache, node), data);
+        node->hash = hash;
+        node->next = *link;
+        *link = node;
+    }
+
+    // make it be the most recent item, and evict the least recent items
+    node->cost = cost;
+    cache->cost += cost;
+    tt_list_entry_insert_head(&cache->order, &node->entry);
+    tt_lru_cache_evict(cache, cache->capacity);
+
+    // grow the buckets if the load factor > 1
+    if (tt_list_entry_size(&cache->order) > cache->bucket_maxn) tt_lru_cache_grow(cache);
+
+    return tt_true;
+}
+
+tt_void_t tt_lru_cache_remove(tt_lru_cache_ref_t self, tt_cpointer_t key)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return(cache);
+
+    tt_lru_cache_node_t** link = tt_lru_cache_find(cache, key, cache->element_key.hash(&cache->element_key, key, TT_LRU_CACHE_HASH_MASK, 0));
+    if (*link) tt_lru_cache_node_exit(cache, link, tt_false);
+}
+
+tt_size_t tt_lru_cache_size(tt_lru_cache_ref_t self)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return_val(cache, 0);
+
+    return tt_list_entry_size(&cache->order);
+}
+
+tt_size_t tt_lru_cache_cost(tt_lru_cache_ref_t self)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return_val(cache, 0);
+
+    return cache->cost;
+}
+
+tt_size_t tt_lru_cache_capacity(tt_lru_cache_ref_t self)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return_val(cache, 0);
+
+    return cache->capacity;
+}
+
+tt_void_t tt_lru_cache_capacity_set(tt_lru_cache_ref_t self, tt_size_t capacity)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return(cache);
+
+    cache->capacity = capacity;
+    tt_lru_cache_evict(cache, capacity);
+}
+
+tt_void_t tt_lru_cache_stat(tt_lru_cache_ref_t self, tt_hize_t* hits, tt_hize_t* misses)
+{
+    tt_lru_cache_t* cache = (tt_lru_cache_t*)self;
+    tt_assert_and_check_return(cache);
+
+    if (hits) *hits = cache->hits;
+    if (misses) *misses = cache->misses;
+}
@@ -0,0 +1,204 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       lru_cache.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-27
+ * @brief      lru_cache.h file
+ */
+
+#ifndef TT_CONTAINER_LRU_CACHE_H
+#define TT_CONTAINER_LRU_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+#include "element/element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the lru cache item type
+typedef struct __tt_lru_cache_item_t
+{
+    /// the item key
+    tt_pointer_t        key;
+
+    /// the item data
+    tt_pointer_t        data;
+
+}tt_lru_cache_item_t, *tt_lru_cache_item_ref_t;
+
+/*! the lru cache evict func type
+ *
+ * @param key           the evicted item key
+ * @param data          the evicted item data
+ * @param priv          the user private data
+ */
+typedef tt_void_t       (*tt_lru_cache_evict_func_t)(tt_cpointer_t key, tt_cpointer_t data, tt_cpointer_t priv);
+
+/*! the lru cache ref type
+ *
+ * <pre>
+ * index: |--------|--------|--------|--------|   buckets, chained by the node hash next
+ *             |                 |
+ *           node1 ----------> node0
+ *             |                 |
+ * order: list <-> node0 <-> node1 <-> ... <-> nodeN   (most recent ... least recent)
+ *
+ * each item has a cost in bytes given by the caller, the least recent items
+ * are evicted when the total cost exceeds the capacity.
+ *
+ * performance:
+ *
+ * get:    fast, O(1)
+ * put:    fast, O(1)
+ * remove: fast, O(1)
+ * evict:  fast, O(1)
+ *
+ * iterator:
+ * next: fast, from the most recent item
+ * prev: fast
+ * </pre>
+ *
+ * @note the iterator is readonly and the iterator walking does not update the recency
+ *
+ */
+typedef tt_iterator_ref_t tt_lru_cache_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init lru cache
+ *
+ * @param capacity      the total cost capacity in bytes
+ * @param element_key   the element of item key, the hash function is required
+ * @param element_data  the element of item data
+ * @param func          the evict func, may be tt_null
+ * @param priv          the user private data of the evict func
+ *
+ * @return              the lru cache
+ */
+tt_lru_cache_ref_t      tt_lru_cache_init(tt_size_t capacity, tt_element_t element_key, tt_element_t element_data, tt_lru_cache_evict_func_t func, tt_cpointer_t priv);
+
+/*! init lru cache with the allocator
+ *
+ * @param capacity      the total cost capacity in bytes
+ * @param element_key   the element of item key, the hash function is required
+ * @param element_data  the element of item data
+ * @param func          the evict func, may be tt_null
+ * @param priv          the user private data of the evict func
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the lru cache
+ */
+tt_lru_cache_ref_t      tt_lru_cache_init_with_allocator(tt_size_t capacity, tt_element_t element_key, tt_element_t element_data, tt_lru_cache_evict_func_t func, tt_cpointer_t priv, tt_allocator_ref_t allocator);
+
+/*! exit lru cache
+ *
+ * @param cache         the lru cache
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_lru_cache_exit(tt_lru_cache_ref_t cache);
+
+/*! clear lru cache, the evict func will not be called
+ *
+ * @param cache         the lru cache
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_lru_cache_clear(tt_lru_cache_ref_t cache);
+
+/*! get the item data and make it be the most recent item
+ *
+ * @param cache         the lru cache
+ * @param key           the item key
+ *
+ * @return              the item data, tt_null if not found
+ */
+tt_pointer_t            tt_lru_cache_get(tt_lru_cache_ref_t cache, tt_cpointer_t key);
+
+/*! put the item as the most recent item, replace the data if the key has been existed
+ *
+ * the least recent items will be evicted if the total cost exceeds the capacity
+ *
+ * @param cache         the lru cache
+ * @param key           the item key
+ * @param data          the item data
+ * @param cost          the item cost in bytes
+ *
+ * @return              tt_true or tt_false if the cost exceeds the capacity
+ */
+tt_bool_t               tt_lru_cache_put(tt_lru_cache_ref_t cache, tt_cpointer_t key, tt_cpointer_t data, tt_size_t cost);
+
+/*! remove the item, the evict func will not be called
+ *
+ * @param cache         the lru cache
+ * @param key           the item key
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_lru_cache_remove(tt_lru_cache_ref_t cache, tt_cpointer_t key);
+
+/*! the lru cache item count
+ *
+ * @param cache         the lru cache
+ *
+ * @return              the item count
+ */
+tt_size_t               tt_lru_cache_size(tt_lru_cache_ref_t cache);
+
+/*! the total cost of the lru cache items
+ *
+ * @param cache         the lru cache
+ *
+ * @return              the total cost in bytes
+ */
+tt_size_t               tt_lru_cache_cost(tt_lru_cache_ref_t cache);
+
+/*! the lru cache capacity
+ *
+ * @param cache         the lru cache
+ *
+ * @return              the capacity in bytes
+ */
+tt_size_t               tt_lru_cache_capacity(tt_lru_cache_ref_t cache);
+
+/*! set the lru cache capacity, the least recent items will be evicted if the total cost exceeds it
+ *
+ * @param cache         the lru cache
+ * @param capacity      the capacity in bytes
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_lru_cache_capacity_set(tt_lru_cache_ref_t cache, tt_size_t capacity);
+
+/*! the lru cache hit and miss counts of tt_lru_cache_get
+ *
+ * @param cache         the lru cache
+ * @param hits          the hit count, may be tt_null
+ * @param misses        the miss count, may be tt_null
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_lru_cache_stat(tt_lru_cache_ref_t cache, tt_hize_t* hits, tt_hize_t* misses);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
@@ -0,0 +1,1092 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       radix_tree.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-30
+ * @brief      radix_tree.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_RADIX_TREE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "element/element.h"
+#include "radix_tree.h"
+#include "list_entry.h"
+#include "../utils/bits.h"
+#include "../platform/port.h"
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the node types
+#define TT_RADIX_TREE_NODE4                     (0)
+#define TT_RADIX_TREE_NODE16                    (1)
+#define TT_RADIX_TREE_NODE48                    (2)
+#define TT_RADIX_TREE_NODE256                   (3)
+
+// the child is leaf? the leaf pointer is tagged by the lowest bit
+#define tt_radix_tree_is_leaf(p)                ((tt_size_t)(p) & 1)
+
+// the leaf of the child
+#define tt_radix_tree_leaf(p)                   ((tt_radix_tree_leaf_t*)((tt_size_t)(p) & ~(tt_size_t)1))
+
+// the child of the leaf
+#define tt_radix_tree_leaf_tag(leaf)            ((tt_pointer_t)((tt_size_t)(leaf) | 1))
+
+// the leaf data buffer
+#define tt_radix_tree_leaf_data(leaf)           ((tt_byte_t*)((leaf) + 1))
+
+// the leaf key
+#define tt_radix_tree_leaf_key(tree, leaf)      (tt_radix_tree_leaf_data(leaf) + (tree)->data_size)
+
+// the node prefix, it is placed after the node
+#define tt_radix_tree_node_prefix(node)         ((tt_byte_t*)(node) + g_radix_tree_node_sizes[(node)->type])
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the leaf type, the data buffer and the key are placed after it
+typedef struct __tt_radix_tree_leaf_t
+{
+    // the ordered list entry
+    tt_list_entry_t                 entry;
+
+    // the key size
+    tt_size_t                       size;
+
+}tt_radix_tree_leaf_t;
+
+// the node type
+typedef struct __tt_radix_tree_node_t
+{
+    // the leaf which key ends at this node
+    tt_radix_tree_leaf_t*           leaf;
+
+    // the prefix size
+    tt_uint32_t                     plen;
+
+    // the child count
+    tt_uint16_t                     count;
+
+    // the node type
+    tt_uint8_t                      type;
+
+}tt_radix_tree_node_t;
+
+// the node4 type, the keys are sorted
+typedef struct __tt_radix_tree_node4_t
+{
+    tt_radix_tree_node_t            base;
+    tt_byte_t                       keys[4];
+    tt_pointer_t                    childs[4];
+
+}tt_radix_tree_node4_t;
+
+// the node16 type, the keys are sorted
+typedef struct __tt_radix_tree_node16_t
+{
+    tt_radix_tree_node_t            base;
+    tt_byte_t                       keys[16];
+    tt_pointer_t                    childs[16];
+
+}tt_radix_tree_node16_t;
+
+// the node48 type, the index is the child slot + 1, the slots [0, count) are used
+typedef struct __tt_radix_tree_node48_t
+{
+    tt_radix_tree_node_t            base;
+    tt_byte_t                       index[256];
+    tt_pointer_t                    childs[48];
+
+}tt_radix_tree_node48_t;
+
+// the node256 type
+typedef struct __tt_radix_tree_node256_t
+{
+    tt_radix_tree_node_t            base;
+    tt_pointer_t                    childs[256];
+
+}tt_radix_tree_node256_t;
+
+typedef struct __tt_radix_tree_t
+{
+    // iterator
+    tt_iterator_t           itor;
+
+    // the root, node or tagged leaf
+    tt_pointer_t            root;
+
+    // the ordered leaves
+    tt_list_entry_head_t    leaves;
+
+    // the data buffer size
+    tt_size_t               data_size;
+
+    // the iterator item
+    tt_radix_tree_item_t    item;
+
+    // the element of data
+    tt_element_t            element_data;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_radix_tree_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the node sizes
+static tt_size_t const g_radix_tree_node_sizes[] =
+{
+    sizeof(tt_radix_tree_node4_t)
+,   sizeof(tt_radix_tree_node16_t)
+,   sizeof(tt_radix_tree_node48_t)
+,   sizeof(tt_radix_tree_node256_t)
+};
+
+// the node child maxn
+static tt_size_t const g_radix_tree_node_maxn[] = { 4, 16, 48, 256 };
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tt_radix_tree_leaf_t* tt_radix_tree_leaf_make(tt_radix_tree_t* tree, tt_byte_t const* key, tt_size_t size, tt_cpointer_t data)
+{
+    tt_radix_tree_leaf_t* leaf = (tt_radix_tree_leaf_t*)tt_allocator_malloc(tree->allocator, sizeof(tt_radix_tree_leaf_t) + tree->data_size + size + 1);
+    tt_assert_and_check_return_val(leaf, tt_null);
+
+    leaf->size = size;
+    tt_memcpy(tt_radix_tree_leaf_key(tree, leaf), key, size);
+    tt_radix_tree_leaf_key(tree, leaf)[size] = '\0';
+    tree->element_data.dupl(&tree->element_data, tt_radix_tree_leaf_data(leaf), data);
+    return leaf;
+}
+
+static tt_void_t tt_radix_tree_leaf_free(tt_radix_tree_t* tree, tt_radix_tree_leaf_t* leaf)
+{
+    tt_list_entry_remove(&tree->leaves, &leaf->entry);
+    if (tree->element_data.free) tree->element_data.free(&tree->element_data, tt_radix_tree_leaf_data(leaf));
+    tt_allocator_free(tree->allocator, leaf);
+}
+
+static tt_radix_tree_node_t* tt_radix_tree_node_make(tt_radix_tree_t* tree, tt_size_t type, tt_byte_t const* prefix, tt_size_t plen)
+{
+    tt_radix_tree_node_t* node = (tt_radix_tree_node_t*)tt_allocator_malloc(tree->allocator, g_radix_tree_node_sizes[type] + plen);
+    tt_assert_and_check_return_val(node, tt_null);
+
+    tt_memset(node, 0, g_radix_tree_node_sizes[type]);
+    node->type = (tt_uint8_t)type;
+    node->plen = (tt_uint32_t)plen;
+    if (plen) tt_memcpy(tt_radix_tree_node_prefix(node), prefix, plen);
+    return node;
+}
+
+static tt_void_t tt_radix_tree_free(tt_radix_tree_t* tree, tt_pointer_t p);
+static tt_void_t tt_radix_tree_node_free(tt_radix_tree_t* tree, tt_radix_tree_node_t* node)
+{
+    tt_size_t i = 0;
+    switch (node->type)
+    {
+    case TT_RADIX_TREE_NODE4:
+        for (i = 0; i < node->count; i++) tt_radix_tree_free(tree, ((tt_radix_tree_node4_t*)node)->childs[i]);
+        break;
+    case TT_RADIX_TREE_NODE16:
+        for (i = 0; i < node->count; i++) tt_radix_tree_free(tree, ((tt_radix_tree_node16_t*)node)->childs[i]);
+        break;
+    case TT_RADIX_TREE_NODE48:
+        for (i = 0; i < node->count; i++) tt_radix_tree_free(tree, ((tt_radix_tree_node48_t*)node)->childs[i]);
+        break;
+    case TT_RADIX_TREE_NODE256:
+        for (i = 0; i < 256; i++) if (((tt_radix_tree_node256_t*)node)->childs[i]) tt_radix_tree_free(tree, ((tt_radix_tree_node256_t*)node)->childs[i]);
+        break;
+    default:
+        break;
+    }
+    if (node->leaf) tt_radix_tree_leaf_free(tree, node->leaf);
+    tt_allocator_free(tree->allocator, node);
+}
+
+static tt_void_t tt_radix_tree_free(tt_radix_tree_t* tree, tt_pointer_t p)
+{
+    if (tt_radix_tree_is_leaf(p)) tt_radix_tree_leaf_free(tree, tt_radix_tree_leaf(p));
+    else tt_radix_tree_node_free(tree, (tt_radix_tree_node_t*)p);
+}
+
+static tt_pointer_t* tt_radix_tree_node_find(tt_radix_tree_node_t* node, tt_byte_t c)
+{
+    tt_size_t i = 0;
+    switch (node->type)
+    {
+    case TT_RADIX_TREE_NODE4:
+        {
+            tt_radix_tree_node4_t* node4 = (tt_radix_tree_node4_t*)node;
+            for (i = 0; i < node->count; i++) if (node4->keys[i] == c) return &node4->childs[i];
+        }
+        break;
+    case TT_RADIX_TREE_NODE16:
+        {
+            tt_radix_tree_node16_t* node16 = (tt_radix_tree_node16_t*)node;
+#if defined(__SSE2__)
+            // compare all keys at once
+            __m128i   cmp = _mm_cmpeq_epi8(_mm_set1_epi8((tt_char_t)c), _mm_loadu_si128((__m128i const*)node16->keys));
+            tt_uint32_t mask = (tt_uint32_t)_mm_movemask_epi8(cmp) & ((1u << node->count) - 1);
+            if (mask) return &node16->childs[tt_bits_cl0_u64_le(mask)];
+#else
+            for (i = 0; i < node->count; i++) if (node16->keys[i] == c) return &node16->childs[i];
+#endif
+        }
+        break;
+    case TT_RADIX_TREE_NODE48:
+        {
+            tt_radix_tree_node48_t* node48 = (tt_radix_tree_node48_t*)node;
+            if (node48->index[c]) return &node48->childs[node48->index[c] - 1];
+        }
+        break;
+    case TT_RADIX_TREE_NODE256:
+        {
+            tt_radix_tree_node256_t* node256 = (tt_radix_tree_node256_t*)node;
+            if (node256->childs[c]) return &node256->childs[c];
+        }
+        break;
+    default:
+        break;
+    }
+    return tt_null;
+}
+
+// get all children and the keys in the key order
+static tt_size_t tt_radix_tree_node_childs(tt_radix_tree_node_t* node, tt_byte_t* keys, tt_pointer_t* childs)
+{
+    tt_size_t i = 0;
+    tt_size_t n = 0;
+    switch (node->type)
+    {
+    case TT_RADIX_TREE_NODE4:
+        n = node->count;
+        tt_memcpy(keys, ((tt_radix_tree_node4_t*)node)->keys, n);
+        tt_memcpy(childs, ((tt_radix_tree_node4_t*)node)->childs, n * sizeof(tt_pointer_t));
+        break;
+    case TT_RADIX_TREE_NODE16:
+        n = node->count;
+        tt_memcpy(keys, ((tt_radix_tree_node16_t*)node)->keys, n);
+        tt_memcpy(childs, ((tt_radix_tree_node16_t*)node)->childs, n * sizeof(tt_pointer_t));
+        break;
+    case TT_RADIX_TREE_NODE48:
+        for (i = 0; i < 256; i++)
+        {
+            tt_size_t slot = ((tt_radix_tree_node48_t*)node)->index[i];
+            if (slot)
+            {
+                keys[n]     = (tt_byte_t)i;
+                childs[n++] = ((tt_radix_tree_node48_t*)node)->childs[slot - 1];
+            }
+        }
+        break;
+    case TT_RADIX_TREE_NODE256:
+        for (i = 0; i < 256; i++)
+        {
+            if (((tt_radix_tree_node256_t*)node)->childs[i])
+            {
+                keys[n]     = (tt_byte_t)i;
+                childs[n++] = ((tt_radix_tree_node256_t*)node)->childs[i];
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return n;
+}
+
+// the child which key is the maximum key < c, the minimum child if c is 256
+static tt_pointer_t tt_radix_tree_node_before(tt_radix_tree_node_t* node, tt_size_t c)
+{
+    tt_size_t i = 0;
+    switch (node->type)
+    {
+    case TT_RADIX_TREE_NODE4:
+        for (i = node->count; i > 0; i--) if (((tt_radix_tree_node4_t*)node)->keys[i - 1] < c) return ((tt_radix_tree_node4_t*)node)->childs[i - 1];
+        break;
+    case TT_RADIX_TREE_NODE16:
+        for (i = node->count; i > 0; i--) if (((tt_radix_tree_node16_t*)node)->keys[i - 1] < c) return ((tt_radix_tree_node16_t*)node)->childs[i - 1];
+        break;
+    case TT_RADIX_TREE_NODE48:
+        for (i = c; i > 0; i--)
+        {
+            tt_size_t slot = ((tt_radix_tree_node48_t*)node)->index[i - 1];
+            if (slot) return ((tt_radix_tree_node48_t*)node)->childs[slot - 1];
+        }
+        break;
+    case TT_RADIX_TREE_NODE256:
+        for (i = c; i > 0; i--) if (((tt_radix_tree_node256_t*)node)->childs[i - 1]) return ((tt_radix_tree_node256_t*)node)->childs[i - 1];
+        break;
+    default:
+        break;
+    }
+    return tt_null;
+}
+
+// the minimum child
+static tt_pointer_t tt_radix_tree_node_first(tt_radix_tree_node_t* node)
+{
+    tt_size_t i = 0;
+    switch (node->type)
+    {
+    case TT_RADIX_TREE_NODE4:
+        return node->count ? ((tt_radix_tree_node4_t*)node)->childs[0] : tt_null;
+    case TT_RADIX_TREE_NODE16:
+        return node->count ? ((tt_radix_tree_node16_t*)node)->childs[0] : tt_null;
+    case TT_RADIX_TREE_NODE48:
+        for (i = 0; i < 256; i++)
+        {
+            tt_size_t slot = ((tt_radix_tree_node48_t*)node)->index[i];
+            if (slot) return ((tt_radix_tree_node48_t*)node)->childs[slot - 1];
+        }
+        break;
+    case TT_RADIX_TREE_NODE256:
+        for (i = 0; i < 256; i++) if (((tt_radix_tree_node256_t*)node)->childs[i]) return ((tt_radix_tree_node256_t*)node)->childs[i];
+        break;
+    default:
+        break;
+    }
+    return tt_null;
+}
+
+// the leaf of the minimum key in the subtree
+static tt_radix_tree_leaf_t* tt_radix_tree_leaf_min(tt_pointer_t p)
+{
+    while (p && !tt_radix_tree_is_leaf(p))
+    {
+        tt_radix_tree_node_t* node = (tt_radix_tree_node_t*)p;
+        if (node->leaf) return node->leaf;
+        p = tt_radix_tree_node_first(node);
+    }
+    return p ? tt_radix_tree_leaf(p) : tt_null;
+}
+
+// the leaf of the maximum key in the subtree
+static tt_radix_tree_leaf_t* tt_radix_tree_leaf_max(tt_pointer_t p)
+{
+    while (p && !tt_radix_tree_is_leaf(p))
+    {
+        tt_radix_tree_node_t* node = (tt_radix_tree_node_t*)p;
+        if (!node->count) return node->leaf;
+        p = tt_radix_tree_node_before(node, 256);
+    }
+    return p ? tt_radix_tree_leaf(p) : tt_null;
+}
+
+// change the node type, the node may be grown or shrunk
+static tt_radix_tree_node_t* tt_radix_tree_node_resize(tt_radix_tree_t* tree, tt_radix_tree_node_t** pnode, tt_size_t type)
+{
+    tt_radix_tree_node_t* node = *pnode;
+    tt_radix_tree_node_t* node_new = tt_radix_tree_node_make(tree, type, tt_radix_tree_node_prefix(node), node->plen);
+    tt_assert_and_check_return_val(node_new, tt_null);
+
+    // copy children
+    tt_size_t       i = 0;
+    tt_byte_t       keys[256];
+    tt_pointer_t    childs[256];
+    tt_size_t       n = tt_radix_tree_node_childs(node, keys, childs);
+    switch (type)
+    {
+    case TT_RADIX_TREE_NODE4:
+        tt_memcpy(((tt_radix_tree_node4_t*)node_new)->keys, keys, n);
+        tt_memcpy(((tt_radix_tree_node4_t*)node_new)->childs, childs, n * sizeof(tt_pointer_t));
+        break;
+    case TT_RADIX_TREE_NODE16:
+        tt_memcpy(((tt_radix_tree_node16_t*)node_new)->keys, keys, n);
+        tt_memcpy(((tt_radix_tree_node16_t*)node_new)->childs, childs, n * sizeof(tt_pointer_t));
+        break;
+    case TT_RADIX_TREE_NODE48:
+        for (i = 0; i < n; i++)
+        {
+            ((tt_radix_tree_node48_t*)node_new)->index[keys[i]] = (tt_byte_t)(i + 1);
+            ((tt_radix_tree_node48_t*)node_new)->childs[i] = childs[i];
+        }
+        break;
+    case TT_RADIX_TREE_NODE256:
+        for (i = 0; i < n; i++) ((tt_radix_tree_node256_t*)node_new)->childs[keys[i]] = childs[i];
+        break;
+    default:
+        break;
+    }
+    node_new->count = (tt_uint16_t)n;
+    node_new->leaf  = node->leaf;
+
+    tt_allocator_free(tree->allocator, node);
+    *pnode = node_new;
+    return node_new;
+}
+
+static tt_bool_t tt_radix_tree_node_add(tt_radix_tree_t* tree, tt_radix_tree_node_t** pnode, tt_byte_t c, tt_pointer_t child)
+{
+    // grow it if full
+    tt_radix_tree_node_t* node = *pnode;
+    if (node->count == g_radix_tree_node_maxn[node->type])
+    {
+        node = tt_radix_tree_node_resize(tree, pnode, node->type + 1);
+        tt_assert_and_check_return_val(node, tt_false);
+    }
+
+    // insert child
+    tt_size_t i = 0;
+    switch (node->type)
+    {
+    case TT_RADIX_TREE_NODE4:
+        {
+            tt_radix_tree_node4_t* node4 = (tt_radix_tree_node4_t*)node;
+            while (i < node->count && node4->keys[i] < c) i++;
+            tt_memmov(node4->keys + i + 1, node4->keys + i, node->count - i);
+            tt_memmov(node4->childs + i + 1, node4->childs + i, (node->count - i) * sizeof(tt_pointer_t));
+            node4->keys[i]   = c;
+            node4->childs[i] = child;
+        }
+        break;
+    case TT_RADIX_TREE_NODE16:
+        {
+            tt_radix_tree_node16_t* node16 = (tt_radix_tree_node16_t*)node;
+            while (i < node->count && node16->keys[i] < c) i++;
+            tt_memmov(node16->keys + i + 1, node16->keys + i, node->count - i);
+            tt_memmov(node16->childs + i + 1, node16->childs + i, (node->count - i) * sizeof(tt_pointer_t));
+            node16->keys[i]   = c;
+            node16->childs[i] = child;
+        }
+        break;
+    case TT_RADIX_TREE_NODE48:
+        ((tt_radix_tree_node48_t*)node)->index[c] = (tt_byte_t)(node->count + 1);
+        ((tt_radix_tree_node48_t*)node)->childs[node->count] = child;
+        break;
+    case TT_RADIX_TREE_NODE256:
+        ((tt_radix_tree_node256_t*)node)->childs[c] = child;
+        break;
+    default:
+        break;
+    }
+    node->count++;
+    return tt_true;
+}
+
+static tt_void_t tt_radix_tree_node_del(tt_radix_tree_t* tree, tt_radix_tree_node_t** pnode, tt_byte_t c)
+{
+    tt_size_t i = 0;
+    tt_radix_tree_node_t* node = *pnode;
+    switch (node->type)
+    {
+    case TT_RADIX_TREE_NODE4:
+        {
+            tt_radix_tree_node4_t* node4 = (tt_radix_tree_node4_t*)node;
+            while (i < node->count && node4->keys[i] != c) i++;
+            tt_memmov(node4->keys + i, node4->keys + i + 1, node->count - i - 1);
+            tt_memmov(node4->childs + i, node4->childs + i + 1, (node->count - i - 1) * sizeof(tt_pointer_t));
+        }
+        break;
+    case TT_RADIX_TREE_NODE16:
+        {
+            tt_radix_tree_node16_t* node16 = (tt_radix_tree_node16_t*)node;
+            while (i < node->count && node16->keys[i] != c) i++;
+            tt_memmov(node16->keys + i, node16->keys + i + 1, node->count - i - 1);
+            tt_memmov(node16->childs + i, node16->childs + i + 1, (node->count - i - 1) * sizeof(tt_pointer_t));
+        }
+        break;
+    case TT_RADIX_TREE_NODE48:
+        {
+            // move the last slot to the removed slot
+            tt_radix_tree_node48_t* node48 = (tt_radix_tree_node48_t*)node;
+            tt_size_t slot = node48->index[c] - 1;
+            tt_size_t last = node->count - 1;
+            node48->index[c] = 0;
+            if (slot != last)
+            {
+                node48->childs[slot] = node48->childs[last];
+                for (i = 0; i < 256; i++)
+                {
+                    if (node48->index[i] == last + 1)
+                    {
+                        node48->index[i] = (tt_byte_t)(slot + 1);
+                        break;
+                    }
+                }
+            }
+            node48->childs[last] = tt_null;
+        }
+        break;
+    case TT_RADIX_TREE_NODE256:
+        ((tt_radix_tree_node256_t*)node)->childs[c] = tt_null;
+        break;
+    default:
+        break;
+    }
+    node->count--;
+
+    // shrink it, keep the old node if no memory
+    if (    (node->type == TT_RADIX_TREE_NODE256 && node->count <= 37)
+        ||  (node->type == TT_RADIX_TREE_NODE48 && node->count <= 12)
+        ||  (node->type == TT_RADIX_TREE_NODE16 && node->count <= 3))
+        tt_radix_tree_node_resize(tree, pnode, node->type - 1);
+}
+
+// free the empty node or merge the single child to it after removing
+static tt_void_t tt_radix_tree_node_trim(tt_radix_tree_t* tree, tt_radix_tree_node_t** pnode)
+{
+    tt_radix_tree_node_t* node = *pnode;
+    if (!node->count)
+    {
+        *((tt_pointer_t*)pnode) = node->leaf ? tt_radix_tree_leaf_tag(node->leaf) : tt_null;
+        tt_allocator_free(tree->allocator, node);
+    }
+    else if (node->count == 1 && !node->leaf)
+    {
+        tt_byte_t       keys[256];
+        tt_pointer_t    childs[256];
+        tt_radix_tree_node_childs(node, keys, childs);
+        if (tt_radix_tree_is_leaf(childs[0]))
+        {
+            *((tt_pointer_t*)pnode) = childs[0];
+            tt_allocator_free(tree->allocator, node);
+            return;
+        }
+
+        // the child prefix: node prefix + key + child prefix
+        tt_radix_tree_node_t* child = (tt_radix_tree_node_t*)childs[0];
+        tt_size_t             plen = node->plen + 1 + child->plen;
+        child = (tt_radix_tree_node_t*)tt_allocator_ralloc(tree->allocator, child, g_radix_tree_node_sizes[child->type] + plen);
+        tt_assert_and_check_return(child);
+
+        tt_byte_t* prefix = tt_radix_tree_node_prefix(child);
+        tt_memmov(prefix + node->plen + 1, prefix, child->plen);
+        tt_memcpy(prefix, tt_radix_tree_node_prefix(node), node->plen);
+        prefix[node->plen] = keys[0];
+        child->plen = (tt_uint32_t)plen;
+
+        *pnode = child;
+        tt_allocator_free(tree->allocator, node);
+    }
+}
+
+// insert the leaf to the ordered leaves after the maximum leaf of the given subtree
+static tt_void_t tt_radix_tree_link(tt_radix_tree_t* tree, tt_pointer_t pred, tt_radix_tree_leaf_t* leaf)
+{
+    tt_radix_tree_leaf_t* prev = pred ? tt_radix_tree_leaf_max(pred) : tt_null;
+    if (prev) tt_list_entry_insert(&tree->leaves, &prev->entry, &leaf->entry);
+    else tt_list_entry_insert_head(&tree->leaves, &leaf->entry);
+}
+
+static tt_radix_tree_leaf_t* tt_radix_tree_seek(tt_radix_tree_t* tree, tt_byte_t const* key, tt_size_t size)
+{
+    tt_size_t    depth = 0;
+    tt_pointer_t p = tree->root;
+    while (p && !tt_radix_tree_is_leaf(p))
+    {
+        tt_radix_tree_node_t* node = (tt_radix_tree_node_t*)p;
+        if (node->plen)
+        {
+            tt_check_return_val(depth + node->plen <= size && !tt_memcmp(tt_radix_tree_node_prefix(node), key + depth, node->plen), tt_null);
+            depth += node->plen;
+        }
+        if (depth == size) return node->leaf;
+
+        tt_pointer_t* child = tt_radix_tree_node_find(node, key[depth++]);
+        p = child ? *child : tt_null;
+    }
+    tt_check_return_val(p, tt_null);
+
+    // compare the whole key
+    tt_radix_tree_leaf_t* leaf = tt_radix_tree_leaf(p);
+    return (leaf->size == size && !tt_memcmp(tt_radix_tree_leaf_key(tree, leaf), key, size)) ? leaf : tt_null;
+}
+
+static tt_bool_t tt_radix_tree_remove_impl(tt_radix_tree_t* tree, tt_pointer_t* ref, tt_byte_t const* key, tt_size_t size, tt_size_t depth)
+{
+    tt_pointer_t p = *ref;
+    tt_check_return_val(p, tt_false);
+
+    // remove the leaf
+    if (tt_radix_tree_is_leaf(p))
+    {
+        tt_radix_tree_leaf_t* leaf = tt_radix_tree_leaf(p);
+        tt_check_return_val(leaf->size == size && !tt_memcmp(tt_radix_tree_leaf_key(tree, leaf), key, size), tt_false);
+
+        tt_radix_tree_leaf_free(tree, leaf);
+        *ref = tt_null;
+        return tt_true;
+    }
+
+    tt_radix_tree_node_t* node = (tt_radix_tree_node_t*)p;
+    tt_check_return_val(depth + node->plen <= size && !tt_memcmp(tt_radix_tree_node_prefix(node), key + depth, node->plen), tt_false);
+    depth += node->plen;
+
+    // remove the leaf of the node
+    if (depth == size)
+    {
+        tt_check_return_val(node->leaf, tt_false);
+        tt_radix_tree_leaf_free(tree, node->leaf);
+        node->leaf = tt_null;
+    }
+    else
+    {
+        // the key may be freed after removing, so save the child key first
+        tt_byte_t       c = key[depth];
+        tt_pointer_t*   child = tt_radix_tree_node_find(node, c);
+        tt_check_return_val(child && tt_radix_tree_remove_impl(tree, child, key, size, depth + 1), tt_false);
+        if (!*child) tt_radix_tree_node_del(tree, (tt_radix_tree_node_t**)ref, c);
+    }
+
+    tt_radix_tree_node_trim(tree, (tt_radix_tree_node_t**)ref);
+    return tt_true;
+}
+
+static tt_size_t tt_radix_tree_itor_size(tt_iterator_ref_t iterator)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)iterator;
+    tt_assert(tree);
+
+    return tt_list_entry_size(&tree->leaves);
+}
+
+static tt_size_t tt_radix_tree_itor_head(tt_iterator_ref_t iterator)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)iterator;
+    tt_assert(tree);
+
+    return (tt_size_t)tt_list_entry_head(&tree->leaves);
+}
+
+static tt_size_t tt_radix_tree_itor_last(tt_iterator_ref_t iterator)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)iterator;
+    tt_assert(tree);
+
+    return (tt_size_t)tt_list_entry_last(&tree->leaves);
+}
+
+static tt_size_t tt_radix_tree_itor_tail(tt_iterator_ref_t iterator)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)iterator;
+    tt_assert(tree);
+
+    // tail, must't access
+    return (tt_size_t)tt_list_entry_tail(&tree->leaves);
+}
+
+static tt_size_t tt_radix_tree_itor_next(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_assert(itor);
+
+    return (tt_size_t)tt_list_entry_next((tt_list_entry_ref_t)itor);
+}
+
+static tt_size_t tt_radix_tree_itor_prev(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_assert(itor);
+
+    return (tt_size_t)tt_list_entry_prev((tt_list_entry_ref_t)itor);
+}
+
+static tt_pointer_t tt_radix_tree_itor_item(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)iterator;
+    tt_assert_and_check_return_val(tree && itor, tt_null);
+
+    tt_radix_tree_leaf_t* leaf = (tt_radix_tree_leaf_t*)tt_list_entry(&tree->leaves, itor);
+    tree->item.key  = (tt_char_t const*)tt_radix_tree_leaf_key(tree, leaf);
+    tree->item.data = tree->element_data.data(&tree->element_data, tt_radix_tree_leaf_data(leaf));
+    return &tree->item;
+}
+
+static tt_int32_t tt_radix_tree_itor_comp(tt_iterator_ref_t iterator, tt_cpointer_t litem, tt_cpointer_t ritem)
+{
+    tt_assert(litem && ritem);
+
+    // compare the item key by the byte order
+    tt_byte_t const* l = (tt_byte_t const*)((tt_radix_tree_item_ref_t)litem)->key;
+    tt_byte_t const* r = (tt_byte_t const*)((tt_radix_tree_item_ref_t)ritem)->key;
+    while (*l && *l == *r) { l++; r++; }
+    return (tt_int32_t)*l - (tt_int32_t)*r;
+}
+
+static tt_void_t tt_radix_tree_itor_copy(tt_iterator_ref_t iterator, tt_size_t itor, tt_cpointer_t item)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)iterator;
+    tt_assert_and_check_return(tree && itor && item);
+
+    // copy the item data
+    tt_radix_tree_leaf_t* leaf = (tt_radix_tree_leaf_t*)tt_list_entry(&tree->leaves, itor);
+    tree->element_data.copy(&tree->element_data, tt_radix_tree_leaf_data(leaf), ((tt_radix_tree_item_ref_t)item)->data);
+}
+
+static tt_void_t tt_radix_tree_itor_remove(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)iterator;
+    tt_assert_and_check_return(tree && itor);
+
+    tt_radix_tree_leaf_t* leaf = (tt_radix_tree_leaf_t*)tt_list_entry(&tree->leaves, itor);
+    tt_radix_tree_remove_impl(tree, &tree->root, tt_radix_tree_leaf_key(tree, leaf), leaf->size, 0);
+}
+
+static tt_void_t tt_radix_tree_itor_nremove(tt_iterator_ref_t iterator, tt_size_t prev, tt_size_t next, tt_size_t size)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)iterator;
+    tt_assert_and_check_return(tree && prev && next);
+
+    // remove items in range(prev, next)
+    tt_size_t itor = tt_radix_tree_itor_next(iterator, prev);
+    while (size-- && itor != next)
+    {
+        tt_size_t itor_next = tt_radix_tree_itor_next(iterator, itor);
+        tt_radix_tree_itor_remove(iterator, itor);
+        itor = itor_next;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_radix_tree_ref_t tt_radix_tree_init(tt_element_t element_data)
+{
+    return tt_radix_tree_init_with_allocator(element_data, tt_null);
+}
+
+tt_radix_tree_ref_t tt_radix_tree_init_with_allocator(tt_element_t element_data, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(element_data.size && element_data.data && element_data.dupl && element_data.repl, tt_null);
+
+    // done
+    tt_bool_t           ok = tt_false;
+    tt_radix_tree_t*    tree = tt_null;
+    do
+    {
+        tree = tt_allocator_malloc0(allocator, sizeof(tt_radix_tree_t));
+        tt_assert_and_check_break(tree);
+        tree->allocator = allocator;
+
+        // init tree
+        tree->element_data = element_data;
+        tree->data_size    = tt_align_cpu(element_data.size);
+        tt_list_entry_init(&tree->leaves, tt_radix_tree_leaf_t, entry, tt_null);
+
+        // init iterator operation
+        static tt_iterator_op_t op =
+        {
+            tt_radix_tree_itor_size,
+            tt_radix_tree_itor_head,
+            tt_radix_tree_itor_last,
+            tt_radix_tree_itor_tail,
+            tt_radix_tree_itor_prev,
+            tt_radix_tree_itor_next,
+            tt_radix_tree_itor_item,
+            tt_radix_tree_itor_comp,
+            tt_radix_tree_itor_copy,
+            tt_radix_tree_itor_remove,
+            tt_radix_tree_itor_nremove
+        };
+
+        // init itor
+        tree->itor.mode = TT_ITERATOR_MODE_FORWARD | TT_ITERATOR_MODE_REVERSE | TT_ITERATOR_MODE_MUTABLE;
+        tree->itor.priv = tt_null;
+        tree->itor.step = sizeof(tt_radix_tree_item_t);
+        tree->itor.op   = &op;
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && tree)
+    {
+        tt_allocator_free(allocator, tree);
+        tree = tt_null;
+    }
+
+    return (tt_radix_tree_ref_t)tree;
+}
+
+tt_void_t tt_radix_tree_exit(tt_radix_tree_ref_t self)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)self;
+    tt_assert_and_check_return(tree);
+
+    tt_radix_tree_clear(self);
+    tt_list_entry_exit(&tree->leaves);
+
+    tt_allocator_free(tree->allocator, tree);
+}
+
+tt_void_t tt_radix_tree_clear(tt_radix_tree_ref_t self)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)self;
+    tt_assert_and_check_return(tree);
+
+    if (tree->root) tt_radix_tree_free(tree, tree->root);
+    tree->root = tt_null;
+}
+
+tt_pointer_t tt_radix_tree_get(tt_radix_tree_ref_t self, tt_char_t const* key)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)self;
+    tt_assert_and_check_return_val(tree && key, tt_null);
+
+    tt_radix_tree_leaf_t* leaf = tt_radix_tree_seek(tree, (tt_byte_t const*)key, tt_strlen(key));
+    return leaf ? tree->element_data.data(&tree->element_data, tt_radix_tree_leaf_data(leaf)) : tt_null;
+}
+
+tt_size_t tt_radix_tree_find(tt_radix_tree_ref_t self, tt_char_t const* key)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)self;
+    tt_assert_and_check_return_val(tree && key, 0);
+
+    tt_radix_tree_leaf_t* leaf = tt_radix_tree_seek(tree, (tt_byte_t const*)key, tt_strlen(key));
+    return leaf ? (tt_size_t)&leaf->entry : (tt_size_t)tt_list_entry_tail(&tree->leaves);
+}
+
+tt_size_t tt_radix_tree_match(tt_radix_tree_ref_t self, tt_char_t const* key)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)self;
+    tt_assert_and_check_return_val(tree && key, 0);
+
+    // walk the path of the key and save the last leaf on it
+    tt_byte_t const*        k = (tt_byte_t const*)key;
+    tt_size_t               size = tt_strlen(key);
+    tt_size_t               depth = 0;
+    tt_pointer_t            p = tree->root;
+    tt_radix_tree_leaf_t*   best = tt_null;
+    while (p && !tt_radix_tree_is_leaf(p))
+    {
+        tt_radix_tree_node_t* node = (tt_radix_tree_node_t*)p;
+        if (node->plen)
+        {
+            if (depth + node->plen > size || tt_memcmp(tt_radix_tree_node_prefix(node), k + depth, node->plen)) break;
+            depth += node->plen;
+        }
+        if (node->leaf) best = node->leaf;
+        if (depth == size) break;
+
+        tt_pointer_t* child = tt_radix_tree_node_find(node, k[depth++]);
+        p = child ? *child : tt_null;
+    }
+
+    // the leaf key is the prefix?
+    if (p && tt_radix_tree_is_leaf(p))
+    {
+        tt_radix_tree_leaf_t* leaf = tt_radix_tree_leaf(p);
+        if (leaf->size <= size && !tt_memcmp(tt_radix_tree_leaf_key(tree, leaf), k, leaf->size)) best = leaf;
+    }
+    return best ? (tt_size_t)&best->entry : (tt_size_t)tt_list_entry_tail(&tree->leaves);
+}
+
+tt_size_t tt_radix_tree_prefix(tt_radix_tree_ref_t self, tt_char_t const* prefix, tt_size_t* ptail)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)self;
+    tt_assert_and_check_return_val(tree && prefix, 0);
+
+    // seek the subtree of the prefix
+    tt_byte_t const*    k = (tt_byte_t const*)prefix;
+    tt_size_t           size = tt_strlen(prefix);
+    tt_size_t           depth = 0;
+    tt_pointer_t        p = tree->root;
+    while (p && !tt_radix_tree_is_leaf(p) && depth < size)
+    {
+        tt_radix_tree_node_t* node = (tt_radix_tree_node_t*)p;
+        tt_size_t             n = tt_min(node->plen, size - depth);
+        if (tt_memcmp(tt_radix_tree_node_prefix(node), k + depth, n))
+        {
+            p = tt_null;
+            break;
+        }
+        if (depth + node->plen >= size) break;
+        depth += node->plen;
+
+        tt_pointer_t* child = tt_radix_tree_node_find(node, k[depth++]);
+        p = child ? *child : tt_null;
+    }
+    if (p && tt_radix_tree_is_leaf(p))
+    {
+        tt_radix_tree_leaf_t* leaf = tt_radix_tree_leaf(p);
+        if (leaf->size < size || tt_memcmp(tt_radix_tree_leaf_key(tree, leaf), k, size)) p = tt_null;
+    }
+
+    // all leaves of the subtree
+    tt_size_t head = (tt_size_t)tt_list_entry_tail(&tree->leaves);
+    tt_size_t tail = head;
+    if (p)
+    {
+        head = (tt_size_t)&tt_radix_tree_leaf_min(p)->entry;
+        tail = (tt_size_t)tt_list_entry_next(&tt_radix_tree_leaf_max(p)->entry);
+    }
+    if (ptail) *ptail = tail;
+    return head;
+}
+
+tt_bool_t tt_radix_tree_insert(tt_radix_tree_ref_t self, tt_char_t const* key, tt_cpointer_t data)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)self;
+    tt_assert_and_check_return_val(tree && key, tt_false);
+
+    /* walk the path of the key, and save the subtree of the maximum keys < the key,
+     * the new leaf will be linked after the maximum leaf of it
+     */
+    tt_byte_t const*        k = (tt_byte_t const*)key;
+    tt_size_t               size = tt_strlen(key);
+    tt_size_t               depth = 0;
+    tt_pointer_t*           ref = &tree->root;
+    tt_pointer_t            pred = tt_null;
+    tt_radix_tree_leaf_t*   leaf = tt_null;
+    while (1)
+    {
+        tt_pointer_t p = *ref;
+
+        // empty? insert the leaf
+        if (!p)
+        {
+            leaf = tt_radix_tree_leaf_make(tree, k, size, data);
+            tt_assert_and_check_return_val(leaf, tt_false);
+            *ref = tt_radix_tree_leaf_tag(leaf);
+            break;
+        }
+
+        // the leaf? replace it or split it
+        if (tt_radix_tree_is_leaf(p))
+        {
+            tt_radix_tree_leaf_t*   old = tt_radix_tree_leaf(p);
+            tt_byte_t const*        okey = tt_radix_tree_leaf_key(tree, old);
+            if (old->size == size && !tt_memcmp(okey, k, size))
+            {
+                tree->element_data.repl(&tree->element_data, tt_radix_tree_leaf_data(old), data);
+                return tt_true;
+            }
+
+            // the common prefix
+            tt_size_t i = depth;
+            while (i < old->size && i < size && okey[i] == k[i]) i++;
+
+            // make the new node with the two leaves
+            tt_radix_tree_node_t* node = tt_radix_tree_node_make(tree, TT_RADIX_TREE_NODE4, k + depth, i - depth);
+            tt_assert_and_check_return_val(node, tt_false);
+
+            leaf = tt_radix_tree_leaf_make(tree, k, size, data);
+            if (!leaf)
+            {
+                tt_allocator_free(tree->allocator, node);
+                return tt_false;
+            }
+            if (i == old->size) node->leaf = old;
+            else tt_radix_tree_node_add(tree, &node, okey[i], p);
+            if (i == size) node->leaf = leaf;
+            else tt_radix_tree_node_add(tree, &node, k[i], tt_radix_tree_leaf_tag(leaf));
+
+            // the old key < the key?
+            if (i == old->size || (i < size && okey[i] < k[i])) pred = p;
+            *ref = node;
+            break;
+        }
+
+        // the prefix is mismatched? split it
+        tt_radix_tree_node_t*   node = (tt_radix_tree_node_t*)p;
+        tt_byte_t*              prefix = tt_radix_tree_node_prefix(node);
+        tt_size_t               i = 0;
+        while (i < node->plen && depth + i < size && prefix[i] == k[depth + i]) i++;
+        if (i < node->plen)
+        {
+            tt_radix_tree_node_t* split = tt_radix_tree_node_make(tree, TT_RADIX_TREE_NODE4, prefix, i);
+            tt_assert_and_check_return_val(split, tt_false);
+
+            leaf = tt_radix_tree_leaf_make(tree, k, size, data);
+            if (!leaf)
+            {
+                tt_allocator_free(tree->allocator, split);
+                return tt_false;
+            }
+
+            // the old node is the child of the split node, the prefix is shortened in place
+            tt_byte_t c = prefix[i];
+            tt_memmov(prefix, prefix + i + 1, node->plen - i - 1);
+            node->plen -= (tt_uint32_t)(i + 1);
+            tt_radix_tree_node_add(tree, &split, c, node);
+            if (depth + i == size) split->leaf = leaf;
+            else
+            {
+                tt_radix_tree_node_add(tree, &split, k[depth + i], tt_radix_tree_leaf_tag(leaf));
+                if (c < k[depth + i]) pred = node;
+            }
+            *ref = split;
+            break;
+        }
+        depth += node->plen;
+
+        // the key ends at this node?
+        if (depth == size)
+        {
+            if (node->leaf)
+            {
+                tree->element_data.repl(&tree->element_data, tt_radix_tree_leaf_data(node->leaf), data);
+                return tt_true;
+            }
+            leaf = tt_radix_tree_leaf_make(tree, k, size, data);
+            tt_assert_and_check_return_val(leaf, tt_false);
+            node->leaf = leaf;
+            break;
+        }
+
+        // the keys before the child
+        tt_byte_t       c = k[depth];
+        tt_pointer_t    before = tt_radix_tree_node_before(node, c);
+        if (before) pred = before;
+        else if (node->leaf) pred = tt_radix_tree_leaf_tag(node->leaf);
+
+        // walk to the child
+        tt_pointer_t* child = tt_radix_tree_node_find(node, c);
+        if (child)
+        {
+            ref = child;
+            depth++;
+            continue;
+        }
+
+        // add the new child
+        leaf = tt_radix_tree_leaf_make(tree, k, size, data);
+        tt_assert_and_check_return_val(leaf, tt_false);
+        if (!tt_radix_tree_node_add(tree, (tt_radix_tree_node_t**)ref, c, tt_radix_tree_leaf_tag(leaf)))
+        {
+            if (tree->element_data.free) tree->element_data.free(&tree->element_data, tt_radix_tree_leaf_data(leaf));
+            tt_allocator_free(tree->allocator, leaf);
+            return tt_false;
+        }
+        break;
+    }
+
+    // link the leaf in the key order
+    tt_radix_tree_link(tree, pred, leaf);
+    return tt_true;
+}
+
+tt_void_t tt_radix_tree_remove(tt_radix_tree_ref_t self, tt_char_t const* key)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)self;
+    tt_assert_and_check_return(tree && key);
+
+    tt_radix_tree_remove_impl(tree, &tree->root, (tt_byte_t const*)key, tt_strlen(key), 0);
+}
+
+tt_size_t tt_radix_tree_size(tt_radix_tree_ref_t self)
+{
+    tt_radix_tree_t* tree = (tt_radix_tree_t*)self;
+    tt_assert_and_check_return_val(tree, 0);
+
+    return tt_list_entry_size(&tree->leaves);
+}
@@ -0,0 +1,215 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       radix_tree.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-30
+ * @brief      radix_tree.h file
+ */
+
+#ifndef TT_CONTAINER_RADIX_TREE_H
+#define TT_CONTAINER_RADIX_TREE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+#include "element/element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the radix tree item type
+typedef struct __tt_radix_tree_item_t
+{
+    /// the item key
+    tt_char_t const*    key;
+
+    /// the item data
+    tt_pointer_t        data;
+
+}tt_radix_tree_item_t, *tt_radix_tree_item_ref_t;
+
+/*! the adaptive radix tree ref type for the string keys
+ *
+ * <pre>
+ *                  node4 ["topic/"]                     the compressed prefix
+ *                   /            \
+ *                 'a'            'b'
+ *                 /                \
+ *    node4 ["larm"] => leaf    leaf "topic/bus"        the key ends at node
+ *       /       \
+ *     '/'       's'
+ *     /           \
+ * leaf "topic/alarm/x"  leaf "topic/alarms"
+ *
+ * leaves: topic/alarm <-> topic/alarm/x <-> topic/alarms <-> topic/bus   sorted
+ * </pre>
+ *
+ * the inner node is node4, node16, node48 or node256 by the child count,
+ * it grows or shrinks when the children are inserted or removed.
+ * the single-child path is compressed to the node prefix.
+ *
+ * all leaves are linked in the key order, so the iterator is a leaf and
+ * the items with the same prefix are one range of the leaves.
+ *
+ * performance:
+ *
+ * find:   O(k), k is the key length
+ * insert: O(k)
+ * remove: O(k)
+ * match:  O(k), the longest prefix
+ * prefix: O(k), seek the item range with the prefix
+ *
+ * iterator:
+ * next: fast
+ * prev: fast
+ *
+ * @note the key is the c-string and the itor is invalid after removing it
+ *
+ */
+typedef tt_iterator_ref_t tt_radix_tree_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init radix tree
+ *
+ * @param element_data  the element of item data
+ *
+ * @return              the radix tree
+ */
+tt_radix_tree_ref_t     tt_radix_tree_init(tt_element_t element_data);
+
+/*! init radix tree with the allocator
+ *
+ * @param element_data  the element of item data
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the radix tree
+ */
+tt_radix_tree_ref_t     tt_radix_tree_init_with_allocator(tt_element_t element_data, tt_allocator_ref_t allocator);
+
+/*! exit radix tree
+ *
+ * @param tree          the radix tree
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_radix_tree_exit(tt_radix_tree_ref_t tree);
+
+/*! clear radix tree
+ *
+ * @param tree          the radix tree
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_radix_tree_clear(tt_radix_tree_ref_t tree);
+
+/*! get the item data from key
+ *
+ * @param tree          the radix tree
+ * @param key           the item key
+ *
+ * @return              the item data, tt_null if not found
+ */
+tt_pointer_t            tt_radix_tree_get(tt_radix_tree_ref_t tree, tt_char_t const* key);
+
+/*! find the item from key
+ *
+ * @param tree          the radix tree
+ * @param key           the item key
+ *
+ * @return              the item itor, tt_iterator_tail(tree) if not found
+ */
+tt_size_t               tt_radix_tree_find(tt_radix_tree_ref_t tree, tt_char_t const* key);
+
+/*! find the item which key is the longest prefix of the given key
+ *
+ * @code
+ *
+ * // the keys: "topic/", "topic/alarm"
+ * tt_size_t itor = tt_radix_tree_match(tree, "topic/alarm/fire");
+ *
+ * // => "topic/alarm"
+ * if (itor != tt_iterator_tail(tree))
+ * {
+ *     tt_radix_tree_item_ref_t item = (tt_radix_tree_item_ref_t)tt_iterator_item(tree, itor);
+ *     // ...
+ * }
+ *
+ * @endcode
+ *
+ * @param tree          the radix tree
+ * @param key           the given key
+ *
+ * @return              the item itor, tt_iterator_tail(tree) if not found
+ */
+tt_size_t               tt_radix_tree_match(tt_radix_tree_ref_t tree, tt_char_t const* key);
+
+/*! seek the ordered items which keys start with the prefix
+ *
+ * @code
+ *
+ * tt_size_t tail = 0;
+ * tt_size_t itor = tt_radix_tree_prefix(tree, "topic/", &tail);
+ * for (; itor != tail; itor = tt_iterator_next(tree, itor))
+ * {
+ *     tt_radix_tree_item_ref_t item = (tt_radix_tree_item_ref_t)tt_iterator_item(tree, itor);
+ *     // ...
+ * }
+ *
+ * @endcode
+ *
+ * @param tree          the radix tree
+ * @param prefix        the key prefix
+ * @param ptail         the tail itor of the item range
+ *
+ * @return              the head itor of the item range, equal to the tail if not found
+ */
+tt_size_t               tt_radix_tree_prefix(tt_radix_tree_ref_t tree, tt_char_t const* prefix, tt_size_t* ptail);
+
+/*! insert item data from key, replace the data if the key has been existed
+ *
+ * @param tree          the radix tree
+ * @param key           the item key
+ * @param data          the item data
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_radix_tree_insert(tt_radix_tree_ref_t tree, tt_char_t const* key, tt_cpointer_t data);
+
+/*! remove item from key
+ *
+ * @param tree          the radix tree
+ * @param key           the item key
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_radix_tree_remove(tt_radix_tree_ref_t tree, tt_char_t const* key);
+
+/*! the radix tree size
+ *
+ * @param tree          the radix tree
+ *
+ * @return              the item count
+ */
+tt_size_t               tt_radix_tree_size(tt_radix_tree_ref_t tree);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
@@ -0,0 +1,480 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       slot_map.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-08-01
+ * @brief      slot_map.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_SLOT_MAP"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "element/element.h"
+#include "slot_map.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the slot map grow
+#define TT_SLOT_MAP_GROW            64
+
+// the end of the free slot list
+#define TT_SLOT_MAP_NONE            (0xffffffff)
+
+// the slot map maxn, limited by the 32-bits slot index
+#define TT_SLOT_MAP_MAXN            (0xfffffffe)
+
+// make handle
+#define tt_slot_map_handle_make(index, generation) (((tt_slot_map_handle_t)(generation) << 32) | (tt_slot_map_handle_t)(index))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the slot type
+typedef struct __tt_slot_map_slot_t
+{
+    // the dense index if be used, the next free slot if be free
+    tt_uint32_t         index;
+
+    // the generation, increased after removing, never be zero
+    tt_uint32_t         generation;
+
+}tt_slot_map_slot_t;
+
+typedef struct __tt_slot_map_t
+{
+    // iterator
+    tt_iterator_t       itor;
+
+    // the dense items
+    tt_byte_t*          data;
+
+    // the slot of each dense item
+    tt_uint32_t*        owners;
+
+    // the item count
+    tt_size_t           size;
+
+    // the item maxn
+    tt_size_t           maxn;
+
+    // the slots
+    tt_slot_map_slot_t* slots;
+
+    // the slot count
+    tt_size_t           slot_size;
+
+    // the slot maxn
+    tt_size_t           slot_maxn;
+
+    // the free slot list head
+    tt_uint32_t         free;
+
+    // the grow
+    tt_size_t           grow;
+
+    // the element
+    tt_element_t        element;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_slot_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tt_inline__ tt_size_t tt_slot_map_index(tt_slot_map_t* map, tt_slot_map_handle_t handle)
+{
+    tt_uint32_t         slot = tt_slot_map_handle_index(handle);
+    tt_slot_map_slot_t* s    = map->slots + slot;
+
+    // the stale handle?
+    if (slot >= map->slot_size || s->generation != tt_slot_map_handle_generation(handle)) return map->size;
+    if (s->index >= map->size || map->owners[s->index] != slot) return map->size;
+
+    return s->index;
+}
+
+static tt_bool_t tt_slot_map_grow(tt_slot_map_t* map)
+{
+    // maxn = maxn + max(grow, maxn), grow geometrically for the amortized O(1) insert
+    tt_size_t maxn = map->maxn + tt_max(map->grow, map->maxn);
+    if (maxn > TT_SLOT_MAP_MAXN) maxn = TT_SLOT_MAP_MAXN;
+    tt_check_return_val(maxn > map->maxn, tt_false);
+
+    // grow data
+    tt_byte_t* data = (tt_byte_t*)tt_allocator_ralloc(map->allocator, map->data, maxn * map->element.size);
+    tt_assert_and_check_return_val(data, tt_false);
+    map->data = data;
+
+    // grow owners
+    tt_uint32_t* owners = (tt_uint32_t*)tt_allocator_ralloc(map->allocator, map->owners, maxn * sizeof(tt_uint32_t));
+    tt_assert_and_check_return_val(owners, tt_false);
+    map->owners = owners;
+
+    map->maxn = maxn;
+    return tt_true;
+}
+
+static tt_uint32_t tt_slot_map_slot_alloc(tt_slot_map_t* map)
+{
+    // reuse the free slot first
+    if (map->free != TT_SLOT_MAP_NONE)
+    {
+        tt_uint32_t slot = map->free;
+        map->free = map->slots[slot].index;
+        return slot;
+    }
+
+    // grow slots
+    if (map->slot_size >= map->slot_maxn)
+    {
+        tt_size_t slot_maxn = map->slot_maxn + tt_max(map->grow, map->slot_maxn);
+        if (slot_maxn > TT_SLOT_MAP_MAXN) slot_maxn = TT_SLOT_MAP_MAXN;
+        tt_check_return_val(slot_maxn > map->slot_maxn, TT_SLOT_MAP_NONE);
+
+        tt_slot_map_slot_t* slots = (tt_slot_map_slot_t*)tt_allocator_ralloc(map->allocator, map->slots, slot_maxn * sizeof(tt_slot_map_slot_t));
+        tt_assert_and_check_return_val(slots, TT_SLOT_MAP_NONE);
+        map->slots     = slots;
+        map->slot_maxn = slot_maxn;
+    }
+
+    // the new slot
+    tt_uint32_t slot = (tt_uint32_t)map->slot_size++;
+    map->slots[slot].generation = 1;
+    return slot;
+}
+
+static __tt_inline__ tt_void_t tt_slot_map_slot_free(tt_slot_map_t* map, tt_uint32_t slot)
+{
+    // increase the generation and skip zero, the older handles will be stale
+    tt_slot_map_slot_t* s = map->slots + slot;
+    if (!++s->generation) s->generation = 1;
+
+    // push it to the free list
+    s->index  = map->free;
+    map->free = slot;
+}
+
+static tt_void_t tt_slot_map_remove_at(tt_slot_map_t* map, tt_size_t index)
+{
+    tt_size_t   step = map->element.size;
+    tt_byte_t*  item = map->data + index * step;
+    tt_uint32_t slot = map->owners[index];
+
+    // free item
+    if (map->element.free) map->element.free(&map->element, item);
+
+    // move the last item to the hole and update its slot
+    tt_size_t last = map->size - 1;
+    if (index != last)
+    {
+        tt_memcpy(item, map->data + last * step, step);
+        map->owners[index] = map->owners[last];
+        map->slots[map->owners[index]].index = (tt_uint32_t)index;
+    }
+    map->size--;
+
+    // free slot
+    tt_slot_map_slot_free(map, slot);
+}
+
+static tt_size_t tt_slot_map_itor_size(tt_iterator_ref_t iterator)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert(map);
+
+    return map->size;
+}
+
+static tt_size_t tt_slot_map_itor_head(tt_iterator_ref_t iterator)
+{
+    // head
+    return 0;
+}
+
+static tt_size_t tt_slot_map_itor_last(tt_iterator_ref_t iterator)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert(map);
+
+    // last
+    return map->size ? map->size - 1 : 0;
+}
+
+static tt_size_t tt_slot_map_itor_tail(tt_iterator_ref_t iterator)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert(map);
+
+    // tail, must't access
+    return map->size;
+}
+
+static tt_size_t tt_slot_map_itor_next(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert(map);
+
+    tt_assert_and_check_return_val(itor < map->size, map->size);
+
+    return itor + 1;
+}
+
+static tt_size_t tt_slot_map_itor_prev(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert(map);
+
+    tt_assert_and_check_return_val(itor && itor <= map->size, 0);
+
+    return itor - 1;
+}
+
+static tt_pointer_t tt_slot_map_itor_item(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert_and_check_return_val(map && itor < map->size, tt_null);
+
+    return map->element.data(&map->element, map->data + itor * iterator->step);
+}
+
+static tt_void_t tt_slot_map_itor_copy(tt_iterator_ref_t iterator, tt_size_t itor, tt_cpointer_t data)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert_and_check_return(map && itor < map->size);
+
+    map->element.copy(&map->element, map->data + itor * iterator->step, data);
+}
+
+static tt_int32_t tt_slot_map_itor_comp(tt_iterator_ref_t iterator, tt_cpointer_t ldata, tt_cpointer_t rdata)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert(map && map->element.comp);
+
+    return map->element.comp(&map->element, ldata, rdata);
+}
+
+static tt_void_t tt_slot_map_itor_remove(tt_iterator_ref_t iterator, tt_size_t itor)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert_and_check_return(map && itor < map->size);
+
+    // remove it, the last item is moved to this itor
+    tt_slot_map_remove_at(map, itor);
+}
+
+static tt_void_t tt_slot_map_itor_nremove(tt_iterator_ref_t iterator, tt_size_t prev, tt_size_t next, tt_size_t size)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)iterator;
+    tt_assert(map);
+
+    // no size?
+    tt_check_return(size && map->size);
+
+    // remove items in range(prev, next), prev is tail if removing from head
+    tt_size_t itor = (prev >= map->size) ? 0 : prev + 1;
+    if (next > itor && next <= map->size) size = tt_min(size, next - itor);
+    size = tt_min(size, map->size - itor);
+
+    // remove them from the range end, the moved last items are never in the range
+    while (size--) tt_slot_map_remove_at(map, itor + size);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_slot_map_ref_t tt_slot_map_init(tt_size_t grow, tt_element_t e)
+{
+    return tt_slot_map_init_with_allocator(grow, e, tt_null);
+}
+
+tt_slot_map_ref_t tt_slot_map_init_with_allocator(tt_size_t grow, tt_element_t e, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(e.size && e.data && e.dupl && e.repl, tt_null);
+
+    // done
+    tt_bool_t       ok = tt_false;
+    tt_slot_map_t*  map = tt_null;
+    do
+    {
+        if (!grow) grow = TT_SLOT_MAP_GROW;
+
+        map = tt_allocator_malloc0(allocator, sizeof(tt_slot_map_t));
+        tt_assert_and_check_break(map);
+        map->allocator = allocator;
+
+        // init map
+        map->grow    = grow;
+        map->free    = TT_SLOT_MAP_NONE;
+        map->element = e;
+
+        // init iterator operation
+        static tt_iterator_op_t op =
+        {
+            tt_slot_map_itor_size,
+            tt_slot_map_itor_head,
+            tt_slot_map_itor_last,
+            tt_slot_map_itor_tail,
+            tt_slot_map_itor_prev,
+            tt_slot_map_itor_next,
+            tt_slot_map_itor_item,
+            tt_slot_map_itor_comp,
+            tt_slot_map_itor_copy,
+            tt_slot_map_itor_remove,
+            tt_slot_map_itor_nremove
+        };
+
+        // init itor
+        map->itor.mode = TT_ITERATOR_MODE_FORWARD | TT_ITERATOR_MODE_REVERSE | TT_ITERATOR_MODE_RACCESS | TT_ITERATOR_MODE_MUTABLE;
+        map->itor.priv = tt_null;
+        map->itor.step = e.size;
+        map->itor.op   = &op;
+
+        // make data
+        if (!tt_slot_map_grow(map)) break;
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && map)
+    {
+        tt_slot_map_exit((tt_slot_map_ref_t)map);
+        map = tt_null;
+    }
+
+    return (tt_slot_map_ref_t)map;
+}
+
+tt_void_t tt_slot_map_exit(tt_slot_map_ref_t self)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)self;
+    tt_assert_and_check_return(map);
+
+    // clear data
+    tt_slot_map_clear(self);
+
+    // free data
+    if (map->data) tt_allocator_free(map->allocator, map->data);
+    map->data = tt_null;
+
+    // free owners
+    if (map->owners) tt_allocator_free(map->allocator, map->owners);
+    map->owners = tt_null;
+
+    // free slots
+    if (map->slots) tt_allocator_free(map->allocator, map->slots);
+    map->slots = tt_null;
+
+    tt_allocator_free(map->allocator, map);
+}
+
+tt_void_t tt_slot_map_clear(tt_slot_map_ref_t self)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)self;
+    tt_assert_and_check_return(map);
+
+    // free items
+    if (map->element.nfree && map->size) map->element.nfree(&map->element, map->data, map->size);
+
+    // free the used slots
+    tt_size_t i = 0;
+    for (i = 0; i < map->size; i++) tt_slot_map_slot_free(map, map->owners[i]);
+
+    map->size = 0;
+}
+
+tt_slot_map_handle_t tt_slot_map_insert(tt_slot_map_ref_t self, tt_cpointer_t data)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)self;
+    tt_assert_and_check_return_val(map, TT_SLOT_MAP_HANDLE_NULL);
+
+    // grow data
+    if (map->size >= map->maxn && !tt_slot_map_grow(map)) return TT_SLOT_MAP_HANDLE_NULL;
+
+    // alloc slot
+    tt_uint32_t slot = tt_slot_map_slot_alloc(map);
+    tt_check_return_val(slot != TT_SLOT_MAP_NONE, TT_SLOT_MAP_HANDLE_NULL);
+
+    // append item
+    tt_size_t index = map->size++;
+    map->element.dupl(&map->element, map->data + index * map->element.size, data);
+    map->owners[index]      = slot;
+    map->slots[slot].index  = (tt_uint32_t)index;
+
+    return tt_slot_map_handle_make(slot, map->slots[slot].generation);
+}
+
+tt_void_t tt_slot_map_remove(tt_slot_map_ref_t self, tt_slot_map_handle_t handle)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)self;
+    tt_assert_and_check_return(map);
+
+    tt_size_t index = tt_slot_map_index(map, handle);
+    tt_check_return(index < map->size);
+
+    tt_slot_map_remove_at(map, index);
+}
+
+tt_bool_t tt_slot_map_replace(tt_slot_map_ref_t self, tt_slot_map_handle_t handle, tt_cpointer_t data)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)self;
+    tt_assert_and_check_return_val(map, tt_false);
+
+    tt_size_t index = tt_slot_map_index(map, handle);
+    tt_check_return_val(index < map->size, tt_false);
+
+    map->element.repl(&map->element, map->data + index * map->element.size, data);
+    return tt_true;
+}
+
+tt_pointer_t tt_slot_map_get(tt_slot_map_ref_t self, tt_slot_map_handle_t handle)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)self;
+    tt_assert_and_check_return_val(map, tt_null);
+
+    tt_size_t index = tt_slot_map_index(map, handle);
+    tt_check_return_val(index < map->size, tt_null);
+
+    return map->element.data(&map->element, map->data + index * map->element.size);
+}
+
+tt_size_t tt_slot_map_find(tt_slot_map_ref_t self, tt_slot_map_handle_t handle)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)self;
+    tt_assert_and_check_return_val(map, 0);
+
+    return tt_slot_map_index(map, handle);
+}
+
+tt_slot_map_handle_t tt_slot_map_handle(tt_slot_map_ref_t self, tt_size_t itor)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)self;
+    tt_assert_and_check_return_val(map && itor < map->size, TT_SLOT_MAP_HANDLE_NULL);
+
+    tt_uint32_t slot = map->owners[itor];
+    return tt_slot_map_handle_make(slot, map->slots[slot].generation);
+}
+
+tt_size_t tt_slot_map_size(tt_slot_map_ref_t self)
+{
+    tt_slot_map_t* map = (tt_slot_map_t*)self;
+    tt_assert_and_check_return_val(map, 0);
+
+    return map->size;
+}
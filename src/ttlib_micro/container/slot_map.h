@@ -0,0 +1,189 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       slot_map.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-08-01
+ * @brief      slot_map.h file
+ */
+
+#ifndef TT_CONTAINER_SLOT_MAP_H
+#define TT_CONTAINER_SLOT_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+#include "element/element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the invalid handle
+#define TT_SLOT_MAP_HANDLE_NULL             ((tt_slot_map_handle_t)0)
+
+/// the slot index of the handle
+#define tt_slot_map_handle_index(handle)    ((tt_uint32_t)(handle))
+
+/// the generation of the handle
+#define tt_slot_map_handle_generation(handle) ((tt_uint32_t)((handle) >> 32))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the slot map handle type, (generation << 32) | slot index
+typedef tt_uint64_t tt_slot_map_handle_t;
+
+/*! the slot map ref type
+ *
+ * <pre>
+ * handle: (generation << 32) | index
+ *                               |
+ * slots:  |gen,dense|gen,dense|gen,next free|gen,dense| ...
+ *              |         |                      |
+ *              |    -----|----------------------
+ *              |   |     |
+ * items:  |  item0  |  item1  |  item2  |  ...          dense, for iteration
+ * owners: |  slot0  |  slot3  |  slot1  |  ...          the slot of each item
+ *
+ * the items are stored densely, the last item is moved to the hole after
+ * removing, and its slot is updated, so the handle is still valid.
+ *
+ * the slot generation is increased after removing, so the stale handle
+ * will not be found even if the slot has been reused.
+ *
+ * performance:
+ *
+ * insert: O(1)
+ * remove: O(1)
+ * get:    O(1)
+ *
+ * iterator:
+ * next: fast, the dense items
+ * prev: fast
+ * </pre>
+ *
+ * @note the itor is the dense index and it may point to other item after removing
+ *
+ */
+typedef tt_iterator_ref_t tt_slot_map_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init slot map
+ *
+ * @param grow          the item grow
+ * @param element       the element
+ *
+ * @return              the slot map
+ */
+tt_slot_map_ref_t       tt_slot_map_init(tt_size_t grow, tt_element_t element);
+
+/*! init slot map with the allocator
+ *
+ * @param grow          the item grow
+ * @param element       the element
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the slot map
+ */
+tt_slot_map_ref_t       tt_slot_map_init_with_allocator(tt_size_t grow, tt_element_t element, tt_allocator_ref_t allocator);
+
+/*! exit slot map
+ *
+ * @param map           the slot map
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_slot_map_exit(tt_slot_map_ref_t map);
+
+/*! clear slot map, all handles will be stale
+ *
+ * @param map           the slot map
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_slot_map_clear(tt_slot_map_ref_t map);
+
+/*! insert the item
+ *
+ * @param map           the slot map
+ * @param data          the item data
+ *
+ * @return              the item handle, TT_SLOT_MAP_HANDLE_NULL if failed
+ */
+tt_slot_map_handle_t    tt_slot_map_insert(tt_slot_map_ref_t map, tt_cpointer_t data);
+
+/*! remove the item, do nothing if the handle is stale
+ *
+ * @param map           the slot map
+ * @param handle        the item handle
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_slot_map_remove(tt_slot_map_ref_t map, tt_slot_map_handle_t handle);
+
+/*! replace the item data
+ *
+ * @param map           the slot map
+ * @param handle        the item handle
+ * @param data          the item data
+ *
+ * @return              tt_true or tt_false if the handle is stale
+ */
+tt_bool_t               tt_slot_map_replace(tt_slot_map_ref_t map, tt_slot_map_handle_t handle, tt_cpointer_t data);
+
+/*! get the item data
+ *
+ * @param map           the slot map
+ * @param handle        the item handle
+ *
+ * @return              the item data, tt_null if the handle is stale
+ */
+tt_pointer_t            tt_slot_map_get(tt_slot_map_ref_t map, tt_slot_map_handle_t handle);
+
+/*! find the item itor
+ *
+ * @param map           the slot map
+ * @param handle        the item handle
+ *
+ * @return              the item itor, tt_iterator_tail(map) if the handle is stale
+ */
+tt_size_t               tt_slot_map_find(tt_slot_map_ref_t map, tt_slot_map_handle_t handle);
+
+/*! the item handle of the itor
+ *
+ * @param map           the slot map
+ * @param itor          the item itor
+ *
+ * @return              the item handle
+ */
+tt_slot_map_handle_t    tt_slot_map_handle(tt_slot_map_ref_t map, tt_size_t itor);
+
+/*! the item count
+ *
+ * @param map           the slot map
+ *
+ * @return              the item count
+ */
+tt_size_t               tt_slot_map_size(tt_slot_map_ref_t map);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
@@ -0,0 +1,376 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       string_pool.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-31
+ * @brief      string_pool.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_STRING_POOL"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "string_pool.h"
+#include "element/hash.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default chunk size
+#define TT_STRING_POOL_CHUNK_SIZE           (65536)
+
+// the minimum chunk size
+#define TT_STRING_POOL_CHUNK_SIZE_MIN       (4096)
+
+// the initial bucket count
+#define TT_STRING_POOL_BUCKET_MAXN          (256)
+
+// the entry size class shift, the entry bytes are aligned by 16
+#define TT_STRING_POOL_CLASS_SHIFT          (4)
+
+// the maximum class, the larger entry is allocated alone
+#define TT_STRING_POOL_CLASS_MAXN           (64)
+
+// the full hash mask
+#define TT_STRING_POOL_HASH_MASK            (~(tt_size_t)0)
+
+// the entry of the handle
+#define tt_string_pool_entry(handle)        ((tt_string_pool_entry_t*)(handle) - 1)
+
+// the handle of the entry
+#define tt_string_pool_handle(entry)        ((tt_char_t const*)((entry) + 1))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the entry type, the string is placed after it
+typedef struct __tt_string_pool_entry_t
+{
+    // the next entry of the same bucket or the free list
+    struct __tt_string_pool_entry_t*    next;
+
+    // the string hash
+    tt_size_t                           hash;
+
+    // the string size
+    tt_uint32_t                         size;
+
+    // the reference count
+    tt_uint32_t                         refn;
+
+    // the size class, zero if it is allocated alone
+    tt_uint32_t                         cls;
+
+}tt_string_pool_entry_t;
+
+// the chunk type
+typedef struct __tt_string_pool_chunk_t
+{
+    // the next chunk
+    struct __tt_string_pool_chunk_t*    next;
+
+}tt_string_pool_chunk_t;
+
+typedef struct __tt_string_pool_t
+{
+    // the buckets
+    tt_string_pool_entry_t**    buckets;
+
+    // the bucket count, pow2
+    tt_size_t                   bucket_maxn;
+
+    // the string count
+    tt_size_t                   size;
+
+    // the chunks
+    tt_string_pool_chunk_t*     chunks;
+
+    // the chunk size
+    tt_size_t                   chunk_size;
+
+    // the free space of the current chunk
+    tt_byte_t*                  head;
+    tt_byte_t*                  tail;
+
+    // the free entries of each class
+    tt_string_pool_entry_t*     frees[TT_STRING_POOL_CLASS_MAXN + 1];
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_string_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tt_string_pool_entry_t** tt_string_pool_seek(tt_string_pool_t* pool, tt_char_t const* cstr, tt_size_t size, tt_size_t hash)
+{
+    tt_string_pool_entry_t** link = &pool->buckets[hash & (pool->bucket_maxn - 1)];
+    while (*link)
+    {
+        tt_string_pool_entry_t* entry = *link;
+        if (entry->hash == hash && entry->size == size && !tt_memcmp(tt_string_pool_handle(entry), cstr, size)) break;
+        link = &entry->next;
+    }
+    return link;
+}
+
+static tt_void_t tt_string_pool_grow(tt_string_pool_t* pool)
+{
+    tt_size_t                   bucket_maxn = pool->bucket_maxn << 1;
+    tt_string_pool_entry_t**    buckets = (tt_string_pool_entry_t**)tt_allocator_nalloc0(pool->allocator, sizeof(tt_string_pool_entry_t*), bucket_maxn);
+    tt_check_return(buckets);
+
+    // rehash entries
+    tt_size_t i = 0;
+    for (i = 0; i < pool->bucket_maxn; i++)
+    {
+        tt_string_pool_entry_t* entry = pool->buckets[i];
+        while (entry)
+        {
+            tt_string_pool_entry_t* next = entry->next;
+            tt_string_pool_entry_t** link = &buckets[entry->hash & (bucket_maxn - 1)];
+            entry->next = *link;
+            *link = entry;
+            entry = next;
+        }
+    }
+
+    tt_allocator_free(pool->allocator, pool->buckets);
+    pool->buckets     = buckets;
+    pool->bucket_maxn = bucket_maxn;
+}
+
+static tt_string_pool_entry_t* tt_string_pool_entry_make(tt_string_pool_t* pool, tt_size_t size)
+{
+    // the large entry is allocated alone
+    tt_size_t bytes = tt_align(sizeof(tt_string_pool_entry_t) + size + 1, 1 << TT_STRING_POOL_CLASS_SHIFT);
+    tt_size_t cls = bytes >> TT_STRING_POOL_CLASS_SHIFT;
+    if (cls > TT_STRING_POOL_CLASS_MAXN || bytes > (pool->chunk_size >> 2))
+    {
+        tt_string_pool_entry_t* entry = (tt_string_pool_entry_t*)tt_allocator_malloc(pool->allocator, bytes);
+        tt_assert_and_check_return_val(entry, tt_null);
+        entry->cls = 0;
+        return entry;
+    }
+
+    // reuse the free entry
+    tt_string_pool_entry_t* entry = pool->frees[cls];
+    if (entry)
+    {
+        pool->frees[cls] = entry->next;
+        return entry;
+    }
+
+    // make a new chunk
+    if (pool->head + bytes > pool->tail)
+    {
+        tt_string_pool_chunk_t* chunk = (tt_string_pool_chunk_t*)tt_allocator_malloc(pool->allocator, pool->chunk_size);
+        tt_assert_and_check_return_val(chunk, tt_null);
+
+        chunk->next  = pool->chunks;
+        pool->chunks = chunk;
+        pool->head   = (tt_byte_t*)chunk + tt_align(sizeof(tt_string_pool_chunk_t), 1 << TT_STRING_POOL_CLASS_SHIFT);
+        pool->tail   = (tt_byte_t*)chunk + pool->chunk_size;
+    }
+
+    // bump it
+    entry = (tt_string_pool_entry_t*)pool->head;
+    entry->cls = (tt_uint32_t)cls;
+    pool->head += bytes;
+    return entry;
+}
+
+static tt_void_t tt_string_pool_entry_free(tt_string_pool_t* pool, tt_string_pool_entry_t* entry)
+{
+    if (entry->cls)
+    {
+        entry->next = pool->frees[entry->cls];
+        pool->frees[entry->cls] = entry;
+    }
+    else tt_allocator_free(pool->allocator, entry);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_string_pool_ref_t tt_string_pool_init(tt_size_t chunk_size)
+{
+    return tt_string_pool_init_with_allocator(chunk_size, tt_null);
+}
+
+tt_string_pool_ref_t tt_string_pool_init_with_allocator(tt_size_t chunk_size, tt_allocator_ref_t allocator)
+{
+    // done
+    tt_bool_t           ok = tt_false;
+    tt_string_pool_t*   pool = tt_null;
+    do
+    {
+        pool = tt_allocator_malloc0(allocator, sizeof(tt_string_pool_t));
+        tt_assert_and_check_break(pool);
+        pool->allocator = allocator;
+
+        // init chunk size
+        pool->chunk_size = chunk_size ? tt_max(chunk_size, TT_STRING_POOL_CHUNK_SIZE_MIN) : TT_STRING_POOL_CHUNK_SIZE;
+
+        // make buckets
+        pool->bucket_maxn = TT_STRING_POOL_BUCKET_MAXN;
+        pool->buckets = (tt_string_pool_entry_t**)tt_allocator_nalloc0(allocator, sizeof(tt_string_pool_entry_t*), pool->bucket_maxn);
+        tt_assert_and_check_break(pool->buckets);
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && pool)
+    {
+        tt_allocator_free(allocator, pool);
+        pool = tt_null;
+    }
+
+    return (tt_string_pool_ref_t)pool;
+}
+
+tt_void_t tt_string_pool_exit(tt_string_pool_ref_t self)
+{
+    tt_string_pool_t* pool = (tt_string_pool_t*)self;
+    tt_assert_and_check_return(pool);
+
+    tt_string_pool_clear(self);
+
+    // free buckets
+    if (pool->buckets)
+    {
+        tt_allocator_free(pool->allocator, pool->buckets);
+        pool->buckets = tt_null;
+    }
+
+    tt_allocator_free(pool->allocator, pool);
+}
+
+tt_void_t tt_string_pool_clear(tt_string_pool_ref_t self)
+{
+    tt_string_pool_t* pool = (tt_string_pool_t*)self;
+    tt_assert_and_check_return(pool);
+
+    // free the large entries
+    tt_size_t i = 0;
+    for (i = 0; i < pool->bucket_maxn; i++)
+    {
+        tt_string_pool_entry_t* entry = pool->buckets[i];
+        while (entry)
+        {
+            tt_string_pool_entry_t* next = entry->next;
+            if (!entry->cls) tt_allocator_free(pool->allocator, entry);
+            entry = next;
+        }
+        pool->buckets[i] = tt_null;
+    }
+
+    // free chunks
+    while (pool->chunks)
+    {
+        tt_string_pool_chunk_t* next = pool->chunks->next;
+        tt_allocator_free(pool->allocator, pool->chunks);
+        pool->chunks = next;
+    }
+    pool->head = tt_null;
+    pool->tail = tt_null;
+    pool->size = 0;
+    tt_memset(pool->frees, 0, sizeof(pool->frees));
+}
+
+tt_char_t const* tt_string_pool_insert(tt_string_pool_ref_t self, tt_char_t const* cstr)
+{
+    tt_string_pool_t* pool = (tt_string_pool_t*)self;
+    tt_assert_and_check_return_val(pool && cstr, tt_null);
+
+    // the string is existed? reference it
+    tt_size_t                   size = tt_strlen(cstr);
+    tt_size_t                   hash = tt_element_hash_cstr(cstr, TT_STRING_POOL_HASH_MASK, 0);
+    tt_string_pool_entry_t**    link = tt_string_pool_seek(pool, cstr, size, hash);
+    if (*link) return tt_string_pool_retain(self, tt_string_pool_handle(*link));
+
+    // make entry
+    tt_assert_and_check_return_val(size <= 0xffffffff, tt_null);
+    tt_string_pool_entry_t* entry = tt_string_pool_entry_make(pool, size);
+    tt_assert_and_check_return_val(entry, tt_null);
+
+    entry->hash = hash;
+    entry->size = (tt_uint32_t)size;
+    entry->next = tt_null;
+    entry->refn = 1;
+    tt_memcpy((tt_char_t*)tt_string_pool_handle(entry), cstr, size + 1);
+
+    // the link is still valid before growing
+    *link = entry;
+    if (++pool->size > pool->bucket_maxn) tt_string_pool_grow(pool);
+    return tt_string_pool_handle(entry);
+}
+
+tt_char_t const* tt_string_pool_retain(tt_string_pool_ref_t self, tt_char_t const* handle)
+{
+    tt_assert_and_check_return_val(self && handle, tt_null);
+
+    tt_string_pool_entry_t* entry = tt_string_pool_entry(handle);
+    tt_assert_and_check_return_val(entry->refn && entry->refn < 0xffffffff, tt_null);
+
+    entry->refn++;
+    return handle;
+}
+
+tt_void_t tt_string_pool_remove(tt_string_pool_ref_t self, tt_char_t const* handle)
+{
+    tt_string_pool_t* pool = (tt_string_pool_t*)self;
+    tt_assert_and_check_return(pool && handle);
+
+    tt_string_pool_entry_t* entry = tt_string_pool_entry(handle);
+    tt_assert_and_check_return(entry->refn);
+
+    // referenced yet?
+    if (--entry->refn) return;
+
+    // unlink and free it
+    tt_string_pool_entry_t** link = &pool->buckets[entry->hash & (pool->bucket_maxn - 1)];
+    while (*link && *link != entry) link = &(*link)->next;
+    tt_assert_and_check_return(*link);
+
+    *link = entry->next;
+    tt_string_pool_entry_free(pool, entry);
+    pool->size--;
+}
+
+tt_char_t const* tt_string_pool_find(tt_string_pool_ref_t self, tt_char_t const* cstr)
+{
+    tt_string_pool_t* pool = (tt_string_pool_t*)self;
+    tt_assert_and_check_return_val(pool && cstr, tt_null);
+
+    tt_string_pool_entry_t** link = tt_string_pool_seek(pool, cstr, tt_strlen(cstr), tt_element_hash_cstr(cstr, TT_STRING_POOL_HASH_MASK, 0));
+    return *link ? tt_string_pool_handle(*link) : tt_null;
+}
+
+tt_size_t tt_string_pool_refn(tt_string_pool_ref_t self, tt_char_t const* handle)
+{
+    tt_assert_and_check_return_val(self && handle, 0);
+
+    return tt_string_pool_entry(handle)->refn;
+}
+
+tt_size_t tt_string_pool_size(tt_string_pool_ref_t self)
+{
+    tt_string_pool_t* pool = (tt_string_pool_t*)self;
+    tt_assert_and_check_return_val(pool, 0);
+
+    return pool->size;
+}
@@ -0,0 +1,147 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       string_pool.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-31
+ * @brief      string_pool.h file
+ */
+
+#ifndef TT_CONTAINER_STRING_POOL_H
+#define TT_CONTAINER_STRING_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the string pool ref type
+ *
+ * <pre>
+ * index:  |--------|--------|--------|--------|   buckets, chained by the entry next
+ *              |                 |
+ * chunks: [entry "foo"|entry "bar"|...] -> [entry "baz"|...] -> ...
+ *          |refn|size|hash|"foo\0"|
+ *                          |
+ *                        handle
+ * </pre>
+ *
+ * each unique string is stored once in the arena chunks, the handle is the
+ * string of the entry, so it is stable and the equal strings have the same handle.
+ *
+ * the entry is reference-counted, and its space is reused by the same size
+ * strings after the last reference is removed.
+ *
+ * @note the string pool is not thread-safe
+ *
+ */
+typedef __tt_typeref__(string_pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init string pool
+ *
+ * @param chunk_size    the arena chunk bytes, using the default size if be zero
+ *
+ * @return              the string pool
+ */
+tt_string_pool_ref_t    tt_string_pool_init(tt_size_t chunk_size);
+
+/*! init string pool with the allocator
+ *
+ * @param chunk_size    the arena chunk bytes, using the default size if be zero
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the string pool
+ */
+tt_string_pool_ref_t    tt_string_pool_init_with_allocator(tt_size_t chunk_size, tt_allocator_ref_t allocator);
+
+/*! exit string pool, all handles are invalid
+ *
+ * @param pool          the string pool
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_string_pool_exit(tt_string_pool_ref_t pool);
+
+/*! clear string pool, all handles are invalid
+ *
+ * @param pool          the string pool
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_string_pool_clear(tt_string_pool_ref_t pool);
+
+/*! insert the string and reference it
+ *
+ * @param pool          the string pool
+ * @param cstr          the string
+ *
+ * @return              the string handle, tt_null if failed
+ */
+tt_char_t const*        tt_string_pool_insert(tt_string_pool_ref_t pool, tt_char_t const* cstr);
+
+/*! reference the string handle again, it is faster than inserting the string
+ *
+ * @param pool          the string pool
+ * @param handle        the string handle
+ *
+ * @return              the string handle
+ */
+tt_char_t const*        tt_string_pool_retain(tt_string_pool_ref_t pool, tt_char_t const* handle);
+
+/*! remove the reference of the string handle, the string is freed if not referenced
+ *
+ * @param pool          the string pool
+ * @param handle        the string handle
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_string_pool_remove(tt_string_pool_ref_t pool, tt_char_t const* handle);
+
+/*! find the string handle, the reference count is not changed
+ *
+ * @param pool          the string pool
+ * @param cstr          the string
+ *
+ * @return              the string handle, tt_null if not found
+ */
+tt_char_t const*        tt_string_pool_find(tt_string_pool_ref_t pool, tt_char_t const* cstr);
+
+/*! the reference count of the string handle
+ *
+ * @param pool          the string pool
+ * @param handle        the string handle
+ *
+ * @return              the reference count
+ */
+tt_size_t               tt_string_pool_refn(tt_string_pool_ref_t pool, tt_char_t const* handle);
+
+/*! the unique string count
+ *
+ * @param pool          the string pool
+ *
+ * @return              the string count
+ */
+tt_size_t               tt_string_pool_size(tt_string_pool_ref_t pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
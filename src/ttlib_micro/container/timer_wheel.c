@@ -0,0 +1,351 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       timer_wheel.c
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-08-02
+ * @brief      timer_wheel.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_CONTAINER_TIMER_WHEEL"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "timer_wheel.h"
+#include "../platform/port.h"
+#include "../platform/time.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the level0 bits and buckets
+#define TT_TIMER_WHEEL_ROOT_BITS        (8)
+#define TT_TIMER_WHEEL_ROOT_SIZE        (1 << TT_TIMER_WHEEL_ROOT_BITS)
+#define TT_TIMER_WHEEL_ROOT_MASK        (TT_TIMER_WHEEL_ROOT_SIZE - 1)
+
+// the upper level bits and buckets
+#define TT_TIMER_WHEEL_LEVEL_BITS       (6)
+#define TT_TIMER_WHEEL_LEVEL_SIZE       (1 << TT_TIMER_WHEEL_LEVEL_BITS)
+#define TT_TIMER_WHEEL_LEVEL_MASK       (TT_TIMER_WHEEL_LEVEL_SIZE - 1)
+
+// the upper level count
+#define TT_TIMER_WHEEL_LEVEL_MAXN       (4)
+
+// the maximum ticks of the timeout, the farther timer is put to the last level and cascaded again
+#define TT_TIMER_WHEEL_TICKS_MAXN       ((tt_hize_t)0xffffffff)
+
+// the bucket count
+#define TT_TIMER_WHEEL_BUCKET_MAXN      (TT_TIMER_WHEEL_ROOT_SIZE + TT_TIMER_WHEEL_LEVEL_MAXN * TT_TIMER_WHEEL_LEVEL_SIZE)
+
+// the bits shift of the upper level, level: 1 ~ TT_TIMER_WHEEL_LEVEL_MAXN
+#define TT_TIMER_WHEEL_LEVEL_SHIFT(level)   (TT_TIMER_WHEEL_ROOT_BITS + ((level) - 1) * TT_TIMER_WHEEL_LEVEL_BITS)
+
+// the bucket of the upper level
+#define TT_TIMER_WHEEL_LEVEL_BUCKET(wheel, level, index) \
+    ((wheel)->buckets + TT_TIMER_WHEEL_ROOT_SIZE + ((level) - 1) * TT_TIMER_WHEEL_LEVEL_SIZE + (index))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+typedef struct __tt_timer_wheel_t
+{
+    // the buckets, level0 and the upper levels, the bucket is the sentinel of the timer entries
+    tt_list_entry_t     buckets[TT_TIMER_WHEEL_BUCKET_MAXN];
+
+    // the current tick, all timers before it have been expired
+    tt_hize_t           current;
+
+    // the base clock time
+    tt_hong_t           base;
+
+    // the tick interval
+    tt_size_t           tick;
+
+    // the clock func
+    tt_hong_t           (*clock)(tt_void_t);
+
+    // the pending timer count
+    tt_size_t           size;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_timer_wheel_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tt_inline__ tt_void_t tt_timer_wheel_bucket_init(tt_list_entry_ref_t bucket)
+{
+    bucket->next = bucket;
+    bucket->prev = bucket;
+}
+
+static __tt_inline__ tt_void_t tt_timer_wheel_bucket_insert(tt_list_entry_ref_t bucket, tt_list_entry_ref_t entry)
+{
+    entry->prev         = bucket->prev;
+    entry->next         = bucket;
+    bucket->prev->next  = entry;
+    bucket->prev        = entry;
+}
+
+static __tt_inline__ tt_void_t tt_timer_wheel_bucket_remove(tt_list_entry_ref_t entry)
+{
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    entry->next = tt_null;
+    entry->prev = tt_null;
+}
+
+// move all entries of the bucket to the empty list
+static __tt_inline__ tt_void_t tt_timer_wheel_bucket_move(tt_list_entry_ref_t bucket, tt_list_entry_ref_t list)
+{
+    if (bucket->next != bucket)
+    {
+        list->next          = bucket->next;
+        list->prev          = bucket->prev;
+        list->next->prev    = list;
+        list->prev->next    = list;
+        tt_timer_wheel_bucket_init(bucket);
+    }
+    else tt_timer_wheel_bucket_init(list);
+}
+
+static tt_void_t tt_timer_wheel_insert(tt_timer_wheel_t* wheel, tt_timer_wheel_timer_ref_t timer)
+{
+    tt_hize_t           when = timer->when;
+    tt_hize_t           delta = when - wheel->current;
+    tt_list_entry_ref_t bucket = tt_null;
+
+    // expired? put it to the current bucket
+    if ((tt_hong_t)delta < 0) bucket = wheel->buckets + (wheel->current & TT_TIMER_WHEEL_ROOT_MASK);
+    else if (delta < TT_TIMER_WHEEL_ROOT_SIZE) bucket = wheel->buckets + (when & TT_TIMER_WHEEL_ROOT_MASK);
+    else
+    {
+        // too far? put it to the farthest bucket and it will be cascaded again
+        if (delta > TT_TIMER_WHEEL_TICKS_MAXN)
+        {
+            delta = TT_TIMER_WHEEL_TICKS_MAXN;
+            when  = wheel->current + delta;
+        }
+
+        // find the level which can contain the delta
+        tt_size_t level = 1;
+        while (level < TT_TIMER_WHEEL_LEVEL_MAXN && delta >= ((tt_hize_t)1 << TT_TIMER_WHEEL_LEVEL_SHIFT(level + 1))) level++;
+        bucket = TT_TIMER_WHEEL_LEVEL_BUCKET(wheel, level, (when >> TT_TIMER_WHEEL_LEVEL_SHIFT(level)) & TT_TIMER_WHEEL_LEVEL_MASK);
+    }
+
+    tt_timer_wheel_bucket_insert(bucket, &timer->entry);
+}
+
+// move the timers of the upper level bucket to the lower levels, return the bucket index
+static tt_size_t tt_timer_wheel_cascade(tt_timer_wheel_t* wheel, tt_size_t level)
+{
+    tt_size_t       index = (tt_size_t)(wheel->current >> TT_TIMER_WHEEL_LEVEL_SHIFT(level)) & TT_TIMER_WHEEL_LEVEL_MASK;
+    tt_list_entry_t list;
+    tt_timer_wheel_bucket_move(TT_TIMER_WHEEL_LEVEL_BUCKET(wheel, level, index), &list);
+
+    tt_list_entry_ref_t entry = list.next;
+    while (entry != &list)
+    {
+        tt_list_entry_ref_t next = entry->next;
+        tt_timer_wheel_insert(wheel, (tt_timer_wheel_timer_ref_t)entry);
+        entry = next;
+    }
+    return index;
+}
+
+// expire the timers of the current tick
+static tt_size_t tt_timer_wheel_expire(tt_timer_wheel_t* wheel)
+{
+    // cascade the upper levels if the level0 wraps
+    tt_size_t index = (tt_size_t)(wheel->current & TT_TIMER_WHEEL_ROOT_MASK);
+    if (!index)
+    {
+        tt_size_t level = 1;
+        while (level <= TT_TIMER_WHEEL_LEVEL_MAXN && !tt_timer_wheel_cascade(wheel, level)) level++;
+    }
+
+    // take all timers of this tick
+    tt_list_entry_t list;
+    tt_timer_wheel_bucket_move(wheel->buckets + index, &list);
+    wheel->current++;
+
+    // expire them in one batch, the timer may be added again or the others may be canceled in the func
+    tt_size_t n = 0;
+    while (list.next != &list)
+    {
+        tt_timer_wheel_timer_ref_t timer = (tt_timer_wheel_timer_ref_t)list.next;
+        tt_timer_wheel_bucket_remove(&timer->entry);
+        wheel->size--;
+
+        if (timer->func) timer->func(timer, timer->priv);
+        n++;
+    }
+    return n;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_timer_wheel_ref_t tt_timer_wheel_init(tt_size_t tick, tt_size_t clock)
+{
+    return tt_timer_wheel_init_with_allocator(tick, clock, tt_null);
+}
+
+tt_timer_wheel_ref_t tt_timer_wheel_init_with_allocator(tt_size_t tick, tt_size_t clock, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(clock == TT_TIMER_WHEEL_CLOCK_MCLOCK || clock == TT_TIMER_WHEEL_CLOCK_UCLOCK, tt_null);
+
+    // done
+    tt_bool_t           ok = tt_false;
+    tt_timer_wheel_t*   wheel = tt_null;
+    do
+    {
+        wheel = tt_allocator_malloc0(allocator, sizeof(tt_timer_wheel_t));
+        tt_assert_and_check_break(wheel);
+        wheel->allocator = allocator;
+
+        // init wheel
+        wheel->tick  = tick ? tick : 1;
+        wheel->clock = clock == TT_TIMER_WHEEL_CLOCK_UCLOCK ? tt_uclock : tt_mclock;
+        wheel->base  = wheel->clock();
+
+        // init buckets
+        tt_size_t i = 0;
+        for (i = 0; i < TT_TIMER_WHEEL_BUCKET_MAXN; i++) tt_timer_wheel_bucket_init(wheel->buckets + i);
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && wheel)
+    {
+        tt_allocator_free(allocator, wheel);
+        wheel = tt_null;
+    }
+
+    return (tt_timer_wheel_ref_t)wheel;
+}
+
+tt_void_t tt_timer_wheel_exit(tt_timer_wheel_ref_t self)
+{
+    tt_timer_wheel_t* wheel = (tt_timer_wheel_t*)self;
+    tt_assert_and_check_return(wheel);
+
+    // cancel all timers
+    tt_timer_wheel_clear(self);
+
+    tt_allocator_free(wheel->allocator, wheel);
+}
+
+tt_void_t tt_timer_wheel_clear(tt_timer_wheel_ref_t self)
+{
+    tt_timer_wheel_t* wheel = (tt_timer_wheel_t*)self;
+    tt_assert_and_check_return(wheel);
+
+    // detach all timers, the timers are owned by the user
+    tt_size_t i = 0;
+    for (i = 0; i < TT_TIMER_WHEEL_BUCKET_MAXN && wheel->size; i++)
+    {
+        tt_list_entry_ref_t bucket = wheel->buckets + i;
+        while (bucket->next != bucket)
+        {
+            tt_timer_wheel_bucket_remove(bucket->next);
+            wheel->size--;
+        }
+    }
+    tt_assert(!wheel->size);
+}
+
+tt_void_t tt_timer_wheel_timer_init(tt_timer_wheel_timer_ref_t timer)
+{
+    tt_assert_and_check_return(timer);
+
+    tt_memset(timer, 0, sizeof(tt_timer_wheel_timer_t));
+}
+
+tt_bool_t tt_timer_wheel_timer_pending(tt_timer_wheel_timer_ref_t timer)
+{
+    tt_assert_and_check_return_val(timer, tt_false);
+
+    return timer->entry.next ? tt_true : tt_false;
+}
+
+tt_void_t tt_timer_wheel_add(tt_timer_wheel_ref_t self, tt_timer_wheel_timer_ref_t timer, tt_size_t timeout, tt_timer_wheel_func_t func, tt_cpointer_t priv)
+{
+    tt_timer_wheel_t* wheel = (tt_timer_wheel_t*)self;
+    tt_assert_and_check_return(wheel && timer);
+
+    // restart it if be pending
+    if (timer->entry.next) tt_timer_wheel_bucket_remove(&timer->entry);
+    else wheel->size++;
+
+    // the timeout is from the current tick and rounded up to the tick
+    timer->when = wheel->current + (timeout / wheel->tick) + (timeout % wheel->tick ? 1 : 0);
+    timer->func = func;
+    timer->priv = priv;
+    tt_timer_wheel_insert(wheel, timer);
+}
+
+tt_bool_t tt_timer_wheel_cancel(tt_timer_wheel_ref_t self, tt_timer_wheel_timer_ref_t timer)
+{
+    tt_timer_wheel_t* wheel = (tt_timer_wheel_t*)self;
+    tt_assert_and_check_return_val(wheel && timer, tt_false);
+
+    // not pending?
+    tt_check_return_val(timer->entry.next, tt_false);
+
+    tt_timer_wheel_bucket_remove(&timer->entry);
+    wheel->size--;
+    return tt_true;
+}
+
+tt_size_t tt_timer_wheel_spak(tt_timer_wheel_ref_t self)
+{
+    tt_timer_wheel_t* wheel = (tt_timer_wheel_t*)self;
+    tt_assert_and_check_return_val(wheel, 0);
+
+    return tt_timer_wheel_spak_at(self, wheel->clock());
+}
+
+tt_size_t tt_timer_wheel_spak_at(tt_timer_wheel_ref_t self, tt_hong_t now)
+{
+    tt_timer_wheel_t* wheel = (tt_timer_wheel_t*)self;
+    tt_assert_and_check_return_val(wheel, 0);
+
+    // the ticks from the base time
+    tt_check_return_val(now >= wheel->base, 0);
+    tt_hize_t ticks = (tt_hize_t)(now - wheel->base) / wheel->tick;
+
+    // expire all ticks to now
+    tt_size_t n = 0;
+    while (wheel->current <= ticks)
+    {
+        // no timers? skip the idle ticks at once
+        if (!wheel->size)
+        {
+            wheel->current = ticks + 1;
+            break;
+        }
+        n += tt_timer_wheel_expire(wheel);
+    }
+    return n;
+}
+
+tt_size_t tt_timer_wheel_size(tt_timer_wheel_ref_t self)
+{
+    tt_timer_wheel_t* wheel = (tt_timer_wheel_t*)self;
+    tt_assert_and_check_return_val(wheel, 0);
+
+    return wheel->size;
+}
@@ -0,0 +1,218 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       timer_wheel.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-08-02
+ * @brief      timer_wheel.h file
+ */
+
+#ifndef TT_CONTAINER_TIMER_WHEEL_H
+#define TT_CONTAINER_TIMER_WHEEL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory/allocator.h"
+#include "list_entry.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the timer wheel clock type
+typedef enum __tt_timer_wheel_clock_e
+{
+    TT_TIMER_WHEEL_CLOCK_MCLOCK     = 0     //!< tt_mclock, the tick and timeout are in ms
+,   TT_TIMER_WHEEL_CLOCK_UCLOCK     = 1     //!< tt_uclock, the tick and timeout are in us
+
+}tt_timer_wheel_clock_e;
+
+/*! the hierarchical timer wheel
+ *
+ * <pre>
+ * level0: |0|1|2| ... |255|                              one tick per bucket
+ * level1: |0|1| ... |63|                                 256 ticks per bucket
+ * level2: |0|1| ... |63|                                 2^14 ticks per bucket
+ * level3: |0|1| ... |63|                                 2^20 ticks per bucket
+ * level4: |0|1| ... |63|                                 2^26 ticks per bucket
+ *
+ * the timer is hashed to the bucket of the level by the expired tick,
+ * the bucket of the upper level is moved to the lower levels (cascade)
+ * when the level0 wraps, and all timers of the level0 bucket are expired
+ * in one batch for each tick.
+ *
+ * performance:
+ *
+ * add:    O(1)
+ * cancel: O(1)
+ * tick:   O(1) + the expired timers, the cascade is amortized
+ * </pre>
+ */
+typedef __tt_typeref__(timer_wheel);
+
+/// the timer type
+struct __tt_timer_wheel_timer_t;
+
+/*! the timer func type
+ *
+ * @param timer         the expired timer, it can be added again in this func
+ * @param priv          the user private data
+ */
+typedef tt_void_t       (*tt_timer_wheel_func_t)(struct __tt_timer_wheel_timer_t* timer, tt_cpointer_t priv);
+
+/*! the timer type, be embedded in the user struct
+ *
+ * @code
+ *
+ * typedef struct __tt_conn_t
+ * {
+ *     // the timeout timer
+ *     tt_timer_wheel_timer_t   timer;
+ *
+ *     // ...
+ *
+ * }tt_conn_t;
+ *
+ * tt_timer_wheel_timer_init(&conn->timer);
+ * tt_timer_wheel_add(wheel, &conn->timer, 30000, tt_conn_timeout, conn);
+ *
+ * // the conn is active, restart the timeout
+ * tt_timer_wheel_add(wheel, &conn->timer, 30000, tt_conn_timeout, conn);
+ *
+ * // the conn is closed
+ * tt_timer_wheel_cancel(wheel, &conn->timer);
+ *
+ * @endcode
+ */
+typedef struct __tt_timer_wheel_timer_t
+{
+    /// the bucket entry, the next is null if the timer is not pending
+    tt_list_entry_t         entry;
+
+    /// the expired tick
+    tt_hize_t               when;
+
+    /// the timer func
+    tt_timer_wheel_func_t   func;
+
+    /// the user private data
+    tt_cpointer_t           priv;
+
+}tt_timer_wheel_timer_t, *tt_timer_wheel_timer_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init timer wheel
+ *
+ * @param tick          the tick interval in the clock unit, .e.g 10ms, using 1 if be zero
+ * @param clock         the clock type
+ *
+ * @return              the timer wheel
+ */
+tt_timer_wheel_ref_t    tt_timer_wheel_init(tt_size_t tick, tt_size_t clock);
+
+/*! init timer wheel with the allocator
+ *
+ * @param tick          the tick interval in the clock unit, .e.g 10ms, using 1 if be zero
+ * @param clock         the clock type
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the timer wheel
+ */
+tt_timer_wheel_ref_t    tt_timer_wheel_init_with_allocator(tt_size_t tick, tt_size_t clock, tt_allocator_ref_t allocator);
+
+/*! exit timer wheel, the pending timers are canceled
+ *
+ * @param wheel         the timer wheel
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_timer_wheel_exit(tt_timer_wheel_ref_t wheel);
+
+/*! cancel all pending timers
+ *
+ * @param wheel         the timer wheel
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_timer_wheel_clear(tt_timer_wheel_ref_t wheel);
+
+/*! init timer
+ *
+ * @param timer         the timer
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_timer_wheel_timer_init(tt_timer_wheel_timer_ref_t timer);
+
+/*! the timer is pending?
+ *
+ * @param timer         the timer
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_timer_wheel_timer_pending(tt_timer_wheel_timer_ref_t timer);
+
+/*! add timer, restart it if the timer is pending
+ *
+ * @param wheel         the timer wheel
+ * @param timer         the timer
+ * @param timeout       the timeout in the clock unit, rounded up to the tick
+ * @param func          the timer func
+ * @param priv          the user private data
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_timer_wheel_add(tt_timer_wheel_ref_t wheel, tt_timer_wheel_timer_ref_t timer, tt_size_t timeout, tt_timer_wheel_func_t func, tt_cpointer_t priv);
+
+/*! cancel timer
+ *
+ * @param wheel         the timer wheel
+ * @param timer         the timer
+ *
+ * @return              tt_true or tt_false if the timer is not pending
+ */
+tt_bool_t               tt_timer_wheel_cancel(tt_timer_wheel_ref_t wheel, tt_timer_wheel_timer_ref_t timer);
+
+/*! expire the timers to the current clock time
+ *
+ * @param wheel         the timer wheel
+ *
+ * @return              the expired timer count
+ */
+tt_size_t               tt_timer_wheel_spak(tt_timer_wheel_ref_t wheel);
+
+/*! expire the timers to the given clock time
+ *
+ * @param wheel         the timer wheel
+ * @param now           the clock time, .e.g from tt_mclock()
+ *
+ * @return              the expired timer count
+ */
+tt_size_t               tt_timer_wheel_spak_at(tt_timer_wheel_ref_t wheel, tt_hong_t now);
+
+/*! the pending timer count
+ *
+ * @param wheel         the timer wheel
+ *
+ * @return              the timer count
+ */
+tt_size_t               tt_timer_wheel_size(tt_timer_wheel_ref_t wheel);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
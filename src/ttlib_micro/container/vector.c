@@ -29,8 +29,11 @@
 // the vector grow
 #define TT_VECTOR_GROW          64              
 
-// the vector maxn
-#define TT_VECTOR_MAXN          (1 << 16)              
+// the vector grow factor, percent of the current maxn, 100: 2x
+#define TT_VECTOR_FACTOR        100
+
+// the vector maxn, limited by the addressable bytes
+#define TT_VECTOR_MAXN(isize)   ((~(tt_size_t)0) / (isize))
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -52,9 +55,15 @@ typedef struct __tt_vector_t
     // the vector manx
     tt_size_t           maxn;
 
+    // the vector grow factor
+    tt_size_t           factor;
+
     // the element
     tt_element_t        element;
 
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
 }tt_vector_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -145,11 +154,32 @@ static tt_void_t tt_vector_itor_remove(tt_iterator_ref_t iterator, tt_size_t ito
     tt_vector_remove((tt_vector_ref_t)vector, itor);
 }
 
+static tt_void_t tt_vector_itor_nremove(tt_iterator_ref_t iterator, tt_size_t prev, tt_size_t next, tt_size_t size)
+{
+    tt_vector_t* vector = (tt_vector_t*)iterator;
+    tt_assert(vector);
+
+    // no size?
+    tt_check_return(size && vector->size);
+
+    // remove items in range(prev, next), prev is tail if removing from head
+    tt_size_t itor = (prev >= vector->size) ? 0 : prev + 1;
+    if (next > itor && next <= vector->size) size = tt_min(size, next - itor);
+
+    // remove
+    tt_vector_nremove((tt_vector_ref_t)vector, itor, size);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 
 tt_vector_ref_t tt_vector_init(tt_size_t grow, tt_element_t e)
+{
+    return tt_vector_init_with_allocator(grow, e, tt_null);
+}
+
+tt_vector_ref_t tt_vector_init_with_allocator(tt_size_t grow, tt_element_t e, tt_allocator_ref_t allocator)
 {
     // check
     tt_assert_and_check_return_val(e.size && e.data && e.dupl && e.repl, tt_null);
@@ -161,15 +191,17 @@ tt_vector_ref_t tt_vector_init(tt_size_t grow, tt_element_t e)
     {
         if(!grow) grow = TT_VECTOR_GROW;
 
-        vector = tt_malloc0(sizeof(tt_vector_t));
+        vector = tt_allocator_malloc0(allocator, sizeof(tt_vector_t));
         tt_assert_and_check_break(vector);
 
         // init vector
         vector->size = 0;
         vector->maxn = grow;
         vector->grow = grow;
+        vector->factor = TT_VECTOR_FACTOR;
         vector->element = e;
-        tt_assert_and_check_break(vector->maxn < TT_VECTOR_MAXN);
+        vector->allocator = allocator;
+        tt_assert_and_check_break(vector->maxn < TT_VECTOR_MAXN(e.size));
 
         // init iterator operation
         static tt_iterator_op_t op = 
@@ -184,7 +216,7 @@ tt_vector_ref_t tt_vector_init(tt_size_t grow, tt_element_t e)
             tt_vector_itor_comp,
             tt_vector_itor_copy,
             tt_vector_itor_remove,
-            tt_null
+            tt_vector_itor_nremove
         };
         
         // init itor
@@ -194,23 +226,23 @@ tt_vector_ref_t tt_vector_init(tt_size_t grow, tt_element_t e)
         vector->itor.op   = &op;
 
         // make data
-        vector->data = tt_nalloc0(e.size, vector->maxn);
+        vector->data = tt_allocator_nalloc0(allocator, e.size, vector->maxn);
         tt_assert_and_check_break(vector->data);
 
         ok = tt_true;
 
     } while (0);
 
-    if(!ok) 
+    if(!ok && vector) 
     {
         if(vector->data) 
         {
-            tt_free(vector->data);
+            tt_allocator_free(allocator, vector->data);
             vector->data = tt_null;
         }
         if(vector) 
         {
-            tt_free(vector);
+            tt_allocator_free(allocator, vector);
             vector = tt_null;
         }
     }
@@ -229,11 +261,11 @@ tt_void_t tt_vector_exit(tt_vector_ref_t self)
     // free data
     if(vector->data) 
     {
-        tt_free(vector->data);
+        tt_allocator_free(vector->allocator, vector->data);
         vector->data = tt_null;
     }
 
-    tt_free(vector);
+    tt_allocator_free(vector->allocator, vector);
 }
 
 tt_void_t tt_vector_clear(tt_vector_ref_t self)
@@ -280,22 +312,20 @@ tt_bool_t tt_vector_resize(tt_vector_ref_t self, tt_size_t size)
             if (vector->element.nfree)
                 vector->element.nfree(&vector->element, vector->data + size * vector->element.size, vector->size - size);
         }
-        // size > vector's maxn
+        // size > vector's maxn, grow geometrically for the amortized O(1) insert tail
         if (size > vector->maxn)
         {
-            tt_size_t maxn = tt_align(size, vector->maxn);
-            tt_assert_and_check_break(maxn < TT_VECTOR_MAXN);
+            // step = maxn * factor / 100, avoid overflow
+            tt_size_t step = (vector->maxn / 100) * vector->factor + (vector->maxn % 100) * vector->factor / 100;
+            step = tt_max(step, vector->grow);
 
-            // realloc data
-            vector->data = (tt_byte_t *)tt_ralloc(vector->data, maxn * vector->element.size);
-            tt_assert_and_check_break(vector->data);
-
-            // must be algin by 4-bytes
-            tt_assert_and_check_break(!(((tt_size_t)vector->data) & 3));
+            // maxn = max(size, maxn + step)
+            tt_size_t maxn = vector->maxn + step;
+            if (maxn < vector->maxn || maxn > TT_VECTOR_MAXN(vector->element.size)) maxn = TT_VECTOR_MAXN(vector->element.size);
+            maxn = tt_max(maxn, size);
 
-            // clear new vector item
-            tt_memset(vector->data + vector->size * vector->element.size, 0, (maxn - vector->maxn) * vector->element.size);
-            vector->maxn = maxn;
+            // realloc data
+            if (!tt_vector_reserve(self, maxn)) break;
         }
 
         // update size
@@ -306,6 +336,49 @@ tt_bool_t tt_vector_resize(tt_vector_ref_t self, tt_size_t size)
     return ok;
 }
 
+tt_bool_t tt_vector_reserve(tt_vector_ref_t self, tt_size_t maxn)
+{
+    tt_vector_t* vector = (tt_vector_t*)self;
+    tt_assert_and_check_return_val(vector, tt_false);
+
+    // enough?
+    tt_check_return_val(maxn > vector->maxn, tt_true);
+    tt_assert_and_check_return_val(maxn <= TT_VECTOR_MAXN(vector->element.size), tt_false);
+
+    // realloc data
+    tt_byte_t* data = (tt_byte_t *)tt_allocator_ralloc(vector->allocator, vector->data, maxn * vector->element.size);
+    tt_assert_and_check_return_val(data, tt_false);
+
+    // must be algin by 4-bytes
+    tt_assert(!(((tt_size_t)data) & 3));
+
+    // clear new vector item
+    tt_memset(data + vector->maxn * vector->element.size, 0, (maxn - vector->maxn) * vector->element.size);
+    vector->data = data;
+    vector->maxn = maxn;
+
+    return tt_true;
+}
+
+tt_bool_t tt_vector_shrink(tt_vector_ref_t self)
+{
+    tt_vector_t* vector = (tt_vector_t*)self;
+    tt_assert_and_check_return_val(vector, tt_false);
+
+    // keep grow items at least
+    tt_size_t maxn = tt_max(vector->size, vector->grow);
+    tt_check_return_val(maxn < vector->maxn, tt_true);
+
+    // realloc data
+    tt_byte_t* data = (tt_byte_t *)tt_allocator_ralloc(vector->allocator, vector->data, maxn * vector->element.size);
+    tt_assert_and_check_return_val(data, tt_false);
+
+    vector->data = data;
+    vector->maxn = maxn;
+
+    return tt_true;
+}
+
 tt_void_t tt_vector_copy(tt_vector_ref_t self, tt_vector_ref_t copy)
 {
     tt_vector_t* vector = (tt_vector_t*)self;
@@ -359,6 +432,89 @@ tt_void_t tt_vector_insert_prev(tt_vector_ref_t self, tt_size_t itor, tt_cpointe
     vector->element.dupl(&vector->element, vector->data + itor * vector->element.size, data);
 }
 
+tt_void_t tt_vector_ninsert_prev(tt_vector_ref_t self, tt_size_t itor, tt_cpointer_t data, tt_size_t size)
+{
+    tt_vector_t* vector = (tt_vector_t*)self;
+    tt_assert_and_check_return(vector && vector->data && vector->element.size && itor <= vector->size);
+
+    // no size?
+    tt_check_return(size);
+
+    tt_size_t osize = vector->size;
+    tt_size_t esize = vector->element.size;
+
+    // resize once
+    if(!tt_vector_resize(self, osize + size))
+    {
+        tt_trace_d("vector resize failed");
+        return;
+    }
+
+    // memmov once
+    if(itor != osize) tt_memmov(vector->data + (itor + size) * esize, vector->data + itor * esize, (osize - itor) * esize);
+
+    // dupl items
+    if(vector->element.ndupl) vector->element.ndupl(&vector->element, vector->data + itor * esize, data, size);
+    else
+    {
+        tt_size_t i = 0;
+        for(i = 0; i < size; i++) vector->element.dupl(&vector->element, vector->data + (itor + i) * esize, data);
+    }
+}
+
+tt_void_t tt_vector_ninsert_next(tt_vector_ref_t self, tt_size_t itor, tt_cpointer_t data, tt_size_t size)
+{
+    tt_vector_ninsert_prev(self, tt_iterator_next(self, itor), data, size);
+}
+
+tt_void_t tt_vector_ninsert_head(tt_vector_ref_t self, tt_cpointer_t data, tt_size_t size)
+{
+    tt_vector_ninsert_prev(self, tt_iterator_head(self), data, size);
+}
+
+tt_void_t tt_vector_ninsert_tail(tt_vector_ref_t self, tt_cpointer_t data, tt_size_t size)
+{
+    tt_vector_ninsert_prev(self, tt_iterator_tail(self), data, size);
+}
+
+tt_void_t tt_vector_insert_range(tt_vector_ref_t self, tt_size_t itor, tt_iterator_ref_t iterator, tt_size_t head, tt_size_t tail)
+{
+    tt_vector_t* vector = (tt_vector_t*)self;
+    tt_assert_and_check_return(vector && vector->data && vector->element.size && itor <= vector->size);
+
+    // the items will be moved if inserting self
+    tt_assert_and_check_return(iterator && iterator != self);
+
+    // count items
+    tt_size_t i = 0;
+    tt_size_t size = 0;
+    for(i = head; i != tail; i = tt_iterator_next(iterator, i)) size++;
+    tt_check_return(size);
+
+    tt_size_t osize = vector->size;
+    tt_size_t esize = vector->element.size;
+
+    // resize once
+    if(!tt_vector_resize(self, osize + size))
+    {
+        tt_trace_d("vector resize failed");
+        return;
+    }
+
+    // memmov once
+    if(itor != osize) tt_memmov(vector->data + (itor + size) * esize, vector->data + itor * esize, (osize - itor) * esize);
+
+    // dupl items
+    tt_byte_t* buff = vector->data + itor * esize;
+    for(i = head; i != tail; i = tt_iterator_next(iterator, i), buff += esize)
+        vector->element.dupl(&vector->element, buff, tt_iterator_item(iterator, i));
+}
+
+tt_void_t tt_vector_append(tt_vector_ref_t self, tt_iterator_ref_t iterator)
+{
+    tt_vector_insert_range(self, tt_iterator_tail(self), iterator, tt_iterator_head(iterator), tt_iterator_tail(iterator));
+}
+
 tt_void_t tt_vector_insert_next(tt_vector_ref_t self, tt_size_t itor, tt_cpointer_t data)
 {
     tt_vector_insert_prev(self, tt_iterator_next(self, itor), data);
@@ -412,6 +568,49 @@ tt_void_t tt_vector_remove(tt_vector_ref_t self, tt_size_t itor)
     // update size
     vector->size--;
 }
+
+tt_void_t tt_vector_nremove(tt_vector_ref_t self, tt_size_t itor, tt_size_t size)
+{
+    tt_vector_t* vector = (tt_vector_t*)self;
+    tt_assert_and_check_return(vector && vector->data && vector->element.size && itor <= vector->size);
+
+    // limit size
+    size = tt_min(size, vector->size - itor);
+    tt_check_return(size);
+
+    tt_size_t osize = vector->size;
+    tt_size_t esize = vector->element.size;
+
+    // free items
+    if(vector->element.nfree) vector->element.nfree(&vector->element, vector->data + itor * esize, size);
+    else if(vector->element.free)
+    {
+        tt_size_t i = 0;
+        for(i = 0; i < size; i++) vector->element.free(&vector->element, vector->data + (itor + i) * esize);
+    }
+
+    // memmov once
+    if(itor + size < osize) tt_memmov(vector->data + itor * esize, vector->data + (itor + size) * esize, (osize - itor - size) * esize);
+
+    // update size
+    vector->size -= size;
+}
+
+tt_void_t tt_vector_nremove_head(tt_vector_ref_t self, tt_size_t size)
+{
+    tt_vector_nremove(self, tt_iterator_head(self), size);
+}
+
+tt_void_t tt_vector_nremove_last(tt_vector_ref_t self, tt_size_t size)
+{
+    tt_vector_t* vector = (tt_vector_t*)self;
+    tt_assert_and_check_return(vector);
+
+    // limit size
+    size = tt_min(size, vector->size);
+    tt_vector_nremove(self, vector->size - size, size);
+}
+
 tt_void_t tt_vector_remove_head(tt_vector_ref_t self)
 {
     tt_vector_remove(self, tt_iterator_head(self));
@@ -445,3 +644,19 @@ tt_size_t tt_vector_maxn(tt_vector_ref_t self)
 
     return vector->maxn;
 }
+
+tt_size_t tt_vector_factor(tt_vector_ref_t self)
+{
+    tt_vector_t* vector = (tt_vector_t*)self;
+    tt_assert_and_check_return_val(vector, 0);
+
+    return vector->factor;
+}
+
+tt_void_t tt_vector_factor_set(tt_vector_ref_t self, tt_size_t factor)
+{
+    tt_vector_t* vector = (tt_vector_t*)self;
+    tt_assert_and_check_return(vector);
+
+    vector->factor = factor;
+}
@@ -18,6 +18,7 @@
 #include "prefix.h"
 #include "element/element.h"
 #include "iterator.h"
+#include "../memory/allocator.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -39,7 +40,7 @@ __tt_extern_c_enter__
  * insert:
  * insert midd: slow
  * insert head: slow
- * insert tail: fast
+ * insert tail: fast, amortized O(1)
  *
  * ninsert:
  * ninsert midd: slow
@@ -59,6 +60,10 @@ __tt_extern_c_enter__
  * iterator:
  * next: fast
  * prev: fast
+ *
+ * grow:
+ * the maxn grows geometrically by (maxn * factor / 100) and at least by grow items,
+ * so N tail inserts do only O(log(N)) reallocs, the default factor is 100 (2x).
  * </pre>
  *
  * @note the itor of the same item is mutable
@@ -79,6 +84,16 @@ typedef tt_iterator_ref_t tt_vector_ref_t;
  */
 tt_vector_ref_t         tt_vector_init(tt_size_t grow, tt_element_t e);
 
+/*! init vector with the allocator
+ *
+ * @param grow          the item grow
+ * @param e             the element
+ * @param allocator     the allocator of the vector and its data, using the native allocator if be tt_null
+ *
+ * @return              the vector
+ */
+tt_vector_ref_t         tt_vector_init_with_allocator(tt_size_t grow, tt_element_t e, tt_allocator_ref_t allocator);
+
 /*! exit vector
  *
  * @param vector        the vector
@@ -128,6 +143,23 @@ tt_pointer_t            tt_vector_last(tt_vector_ref_t vector);
  */
 tt_bool_t               tt_vector_resize(tt_vector_ref_t vector, tt_size_t size);
 
+/*! reserve the vector maxn, the size will not be changed
+ *
+ * @param vector        the vector
+ * @param maxn          the vector maxn
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_vector_reserve(tt_vector_ref_t vector, tt_size_t maxn);
+
+/*! shrink the vector maxn to the size, and keep grow items at least
+ *
+ * @param vector        the vector
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_vector_shrink(tt_vector_ref_t vector);
+
 /*! clear vector
  *
  * @param vector        the vector
@@ -183,6 +215,69 @@ tt_void_t               tt_vector_insert_head(tt_vector_ref_t vector, tt_cpointe
  */
 tt_void_t               tt_vector_insert_tail(tt_vector_ref_t vector, tt_cpointer_t data);
 
+/*! insert the vector prev items, do only one resize and one memmov
+ *
+ * @param vector        the vector
+ * @param itor          the itor
+ * @param data          the data
+ * @param size          the data count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_ninsert_prev(tt_vector_ref_t vector, tt_size_t itor, tt_cpointer_t data, tt_size_t size);
+
+/*! insert the vector next items
+ *
+ * @param vector        the vector
+ * @param itor          the itor
+ * @param data          the data
+ * @param size          the data count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_ninsert_next(tt_vector_ref_t vector, tt_size_t itor, tt_cpointer_t data, tt_size_t size);
+
+/*! insert the vector head items
+ *
+ * @param vector        the vector
+ * @param data          the data
+ * @param size          the data count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_ninsert_head(tt_vector_ref_t vector, tt_cpointer_t data, tt_size_t size);
+
+/*! insert the vector tail items
+ *
+ * @param vector        the vector
+ * @param data          the data
+ * @param size          the data count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_ninsert_tail(tt_vector_ref_t vector, tt_cpointer_t data, tt_size_t size);
+
+/*! insert the items of range [head, tail) to the vector prev, do only one resize and one memmov
+ *
+ * @param vector        the vector
+ * @param itor          the itor
+ * @param iterator      the iterator of the inserted items, must not be the vector self
+ * @param head          the head itor of the inserted items
+ * @param tail          the tail itor of the inserted items
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_insert_range(tt_vector_ref_t vector, tt_size_t itor, tt_iterator_ref_t iterator, tt_size_t head, tt_size_t tail);
+
+/*! append all items of the iterator to the vector tail
+ *
+ * @param vector        the vector
+ * @param iterator      the iterator of the appended items, must not be the vector self
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_append(tt_vector_ref_t vector, tt_iterator_ref_t iterator);
+
 /*! replace the vector item
  *
  * @param vector        the vector
@@ -236,6 +331,34 @@ tt_void_t               tt_vector_remove_head(tt_vector_ref_t vector);
  */
 tt_void_t               tt_vector_remove_last(tt_vector_ref_t vector);
 
+/*! remove the vector items, do only one memmov
+ *
+ * @param vector        the vector
+ * @param itor          the item itor
+ * @param size          the removed count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_nremove(tt_vector_ref_t vector, tt_size_t itor, tt_size_t size);
+
+/*! remove the vector head items
+ *
+ * @param vector        the vector
+ * @param size          the removed count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_nremove_head(tt_vector_ref_t vector, tt_size_t size);
+
+/*! remove the vector last items
+ *
+ * @param vector        the vector
+ * @param size          the removed count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_nremove_last(tt_vector_ref_t vector, tt_size_t size);
+
 /*! the vector size
  *
  * @param vector        the vector
@@ -260,6 +383,23 @@ tt_size_t               tt_vector_grow(tt_vector_ref_t vector);
  */
 tt_size_t               tt_vector_maxn(tt_vector_ref_t vector);
 
+/*! the vector grow factor
+ *
+ * @param vector        the vector
+ *
+ * @return              the vector grow factor, percent of the current maxn
+ */
+tt_size_t               tt_vector_factor(tt_vector_ref_t vector);
+
+/*! set the vector grow factor
+ *
+ * @param vector        the vector
+ * @param factor        the grow factor, percent of the current maxn, .e.g 100: 2x, 50: 1.5x, 0: grow items only
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vector_factor_set(tt_vector_ref_t vector, tt_size_t factor);
+
 
 
 /* //////////////////////////////////////////////////////////////////////////////////////
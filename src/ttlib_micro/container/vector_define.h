@@ -0,0 +1,361 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       vector_define.h
+ * @ingroup    container
+ * @author     tango
+ * @date       2021-07-24
+ * @brief      vector_define.h file
+ */
+
+#ifndef TT_CONTAINER_VECTOR_DEFINE_H
+#define TT_CONTAINER_VECTOR_DEFINE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "iterator.h"
+#include "../memory/allocator.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the typed vector grow
+#define TT_VECTOR_DEFINE_GROW                   (64)
+
+/*! the numeric comparator for the scalar items
+ *
+ * @code
+ * static __tt_inline__ tt_long_t tt_vector_u32_comp(tt_uint32_t const* litem, tt_uint32_t const* ritem)
+ * {
+ *     return tt_vector_define_comp_num(litem, ritem);
+ * }
+ * TT_VECTOR_DEFINE_WITH_COMP(tt_vector_u32, tt_uint32_t, tt_vector_u32_comp)
+ * @endcode
+ */
+#define tt_vector_define_comp_num(litem, ritem)     ((*(litem) < *(ritem))? -1 : (*(litem) > *(ritem)))
+
+/*! define a typed vector for the scalar type
+ *
+ * the items are stored and accessed by value, all interfaces are inlined and
+ * there is no element function call for each item, the iterator comp is the
+ * numeric ordering of tt_vector_define_comp_num().
+ *
+ * the struct type has no numeric ordering and memcmp() would compare its padding bytes,
+ * so it must be defined by TT_VECTOR_DEFINE_WITH_COMP with the explicit comparator.
+ *
+ * @code
+ *
+ * // define tt_vector_u32_t and tt_vector_u32_xxx() interfaces
+ * TT_VECTOR_DEFINE(tt_vector_u32, tt_uint32_t)
+ *
+ * tt_vector_u32_ref_t vector = tt_vector_u32_init(0);
+ * tt_vector_u32_insert_tail(vector, 1);
+ * tt_vector_u32_insert_tail(vector, 2);
+ *
+ * // the items of iterator are the item pointers
+ * tt_for_all(tt_uint32_t*, item, tt_vector_u32_iterator(vector))
+ * {
+ *     tt_trace_d("%u", *item);
+ * }
+ *
+ * tt_vector_u32_exit(vector);
+ *
+ * @endcode
+ *
+ * the vector and its data are allocated by the allocator of tt_vector_u32_init_with_allocator(),
+ * or the native allocator of tt_vector_u32_init().
+ *
+ * @param name          the vector name, the prefix of the type and interfaces
+ * @param type          the scalar item type, e.g. the integer, float or pointer
+ */
+#define TT_VECTOR_DEFINE(name, type) \
+    static __tt_inline__ tt_long_t name##_comp_default(type const* litem, type const* ritem) \
+    { \
+        return tt_vector_define_comp_num(litem, ritem); \
+    } \
+    TT_VECTOR_DEFINE_WITH_COMP(name, type, name##_comp_default)
+
+/*! define a typed vector with the item comparator
+ *
+ * @param name          the vector name, the prefix of the type and interfaces
+ * @param type          the item type
+ * @param comp          the item comparator: tt_long_t comp(type const* litem, type const* ritem)
+ */
+#define TT_VECTOR_DEFINE_WITH_COMP(name, type, comp) \
+    /* the vector type */ \
+    typedef struct __##name##_t \
+    { \
+        /* iterator */ \
+        tt_iterator_t       itor; \
+        /* the vector data */ \
+        type*               data; \
+        /* the vector size */ \
+        tt_size_t           size; \
+        /* the vector grow */ \
+        tt_size_t           grow; \
+        /* the vector maxn */ \
+        tt_size_t           maxn; \
+        /* the allocator, using the native allocator if be tt_null */ \
+        tt_allocator_ref_t  allocator; \
+    }name##_t, *name##_ref_t; \
+    \
+    /* reserve the vector maxn */ \
+    static __tt_inline__ tt_bool_t name##_reserve(name##_ref_t vector, tt_size_t maxn) \
+    { \
+        tt_assert_and_check_return_val(vector, tt_false); \
+        tt_check_return_val(maxn > vector->maxn, tt_true); \
+        tt_assert_and_check_return_val(maxn <= (~(tt_size_t)0) / sizeof(type), tt_false); \
+        type* data = (type*)tt_allocator_ralloc(vector->allocator, vector->data, maxn * sizeof(type)); \
+        tt_assert_and_check_return_val(data, tt_false); \
+        vector->data = data; \
+        vector->maxn = maxn; \
+        return tt_true; \
+    } \
+    \
+    /* grow the vector for the size, geometrically */ \
+    static __tt_inline__ tt_bool_t name##_grow_(name##_ref_t vector, tt_size_t size) \
+    { \
+        tt_size_t maxn = vector->maxn + tt_max(vector->maxn, vector->grow); \
+        if (maxn < vector->maxn) maxn = size; \
+        return name##_reserve(vector, tt_max(maxn, size)); \
+    } \
+    \
+    /* resize the vector, the new items are zero */ \
+    static __tt_inline__ tt_bool_t name##_resize(name##_ref_t vector, tt_size_t size) \
+    { \
+        tt_assert_and_check_return_val(vector, tt_false); \
+        if (size > vector->maxn && !name##_grow_(vector, size)) return tt_false; \
+        if (size > vector->size) tt_memset(vector->data + vector->size, 0, (size - vector->size) * sizeof(type)); \
+        vector->size = size; \
+        return tt_true; \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_remove(name##_ref_t vector, tt_size_t itor) \
+    { \
+        tt_assert_and_check_return(vector && itor < vector->size); \
+        if (itor + 1 < vector->size) tt_memmov(vector->data + itor, vector->data + itor + 1, (vector->size - itor - 1) * sizeof(type)); \
+        vector->size--; \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_nremove(name##_ref_t vector, tt_size_t itor, tt_size_t size) \
+    { \
+        tt_assert_and_check_return(vector && itor <= vector->size); \
+        size = tt_min(size, vector->size - itor); \
+        tt_check_return(size); \
+        if (itor + size < vector->size) tt_memmov(vector->data + itor, vector->data + itor + size, (vector->size - itor - size) * sizeof(type)); \
+        vector->size -= size; \
+    } \
+    \
+    /* the iterator implementation */ \
+    static tt_size_t name##_itor_size(tt_iterator_ref_t iterator) \
+    { \
+        return ((name##_ref_t)iterator)->size; \
+    } \
+    static tt_size_t name##_itor_head(tt_iterator_ref_t iterator) \
+    { \
+        return 0; \
+    } \
+    static tt_size_t name##_itor_last(tt_iterator_ref_t iterator) \
+    { \
+        name##_ref_t vector = (name##_ref_t)iterator; \
+        return vector->size ? vector->size - 1 : 0; \
+    } \
+    static tt_size_t name##_itor_tail(tt_iterator_ref_t iterator) \
+    { \
+        return ((name##_ref_t)iterator)->size; \
+    } \
+    static tt_size_t name##_itor_prev(tt_iterator_ref_t iterator, tt_size_t itor) \
+    { \
+        tt_assert_and_check_return_val(itor && itor <= ((name##_ref_t)iterator)->size, 0); \
+        return itor - 1; \
+    } \
+    static tt_size_t name##_itor_next(tt_iterator_ref_t iterator, tt_size_t itor) \
+    { \
+        tt_assert_and_check_return_val(itor < ((name##_ref_t)iterator)->size, ((name##_ref_t)iterator)->size); \
+        return itor + 1; \
+    } \
+    static tt_pointer_t name##_itor_item(tt_iterator_ref_t iterator, tt_size_t itor) \
+    { \
+        name##_ref_t vector = (name##_ref_t)iterator; \
+        tt_assert_and_check_return_val(itor < vector->size, tt_null); \
+        return vector->data + itor; \
+    } \
+    static tt_int32_t name##_itor_comp(tt_iterator_ref_t iterator, tt_cpointer_t litem, tt_cpointer_t ritem) \
+    { \
+        return (tt_int32_t)comp((type const*)litem, (type const*)ritem); \
+    } \
+    static tt_void_t name##_itor_copy(tt_iterator_ref_t iterator, tt_size_t itor, tt_cpointer_t item) \
+    { \
+        name##_ref_t vector = (name##_ref_t)iterator; \
+        tt_assert_and_check_return(itor < vector->size && item); \
+        vector->data[itor] = *((type const*)item); \
+    } \
+    static tt_void_t name##_itor_remove(tt_iterator_ref_t iterator, tt_size_t itor) \
+    { \
+        name##_remove((name##_ref_t)iterator, itor); \
+    } \
+    static tt_void_t name##_itor_nremove(tt_iterator_ref_t iterator, tt_size_t prev, tt_size_t next, tt_size_t size) \
+    { \
+        name##_ref_t vector = (name##_ref_t)iterator; \
+        tt_size_t    itor = (prev >= vector->size) ? 0 : prev + 1; \
+        if (next > itor && next <= vector->size) size = tt_min(size, next - itor); \
+        name##_nremove(vector, itor, size); \
+    } \
+    \
+    static __tt_inline__ name##_ref_t name##_init_with_allocator(tt_size_t grow, tt_allocator_ref_t allocator) \
+    { \
+        static tt_iterator_op_t op = \
+        { \
+            name##_itor_size, \
+            name##_itor_head, \
+            name##_itor_last, \
+            name##_itor_tail, \
+            name##_itor_prev, \
+            name##_itor_next, \
+            name##_itor_item, \
+            name##_itor_comp, \
+            name##_itor_copy, \
+            name##_itor_remove, \
+            name##_itor_nremove \
+        }; \
+        name##_ref_t vector = (name##_ref_t)tt_allocator_malloc0(allocator, sizeof(name##_t)); \
+        tt_assert_and_check_return_val(vector, tt_null); \
+        vector->grow      = grow ? grow : TT_VECTOR_DEFINE_GROW; \
+        vector->allocator = allocator; \
+        vector->itor.mode = TT_ITERATOR_MODE_FORWARD | TT_ITERATOR_MODE_REVERSE | TT_ITERATOR_MODE_RACCESS | TT_ITERATOR_MODE_MUTABLE; \
+        vector->itor.priv = tt_null; \
+        vector->itor.step = sizeof(type); \
+        vector->itor.op   = &op; \
+        if (!name##_reserve(vector, vector->grow)) \
+        { \
+            tt_allocator_free(allocator, vector); \
+            return tt_null; \
+        } \
+        return vector; \
+    } \
+    \
+    static __tt_inline__ name##_ref_t name##_init(tt_size_t grow) \
+    { \
+        return name##_init_with_allocator(grow, tt_null); \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_exit(name##_ref_t vector) \
+    { \
+        tt_assert_and_check_return(vector); \
+        if (vector->data) tt_allocator_free(vector->allocator, vector->data); \
+        tt_allocator_free(vector->allocator, vector); \
+    } \
+    \
+    static __tt_inline__ tt_iterator_ref_t name##_iterator(name##_ref_t vector) \
+    { \
+        tt_assert(vector); \
+        return &vector->itor; \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_clear(name##_ref_t vector) \
+    { \
+        tt_assert_and_check_return(vector); \
+        vector->size = 0; \
+    } \
+    \
+    static __tt_inline__ type* name##_data(name##_ref_t vector) \
+    { \
+        tt_assert_and_check_return_val(vector, tt_null); \
+        return vector->data; \
+    } \
+    \
+    static __tt_inline__ type* name##_item(name##_ref_t vector, tt_size_t itor) \
+    { \
+        tt_assert_and_check_return_val(vector && itor < vector->size, tt_null); \
+        return vector->data + itor; \
+    } \
+    \
+    static __tt_inline__ type* name##_head(name##_ref_t vector) \
+    { \
+        return name##_item(vector, 0); \
+    } \
+    \
+    static __tt_inline__ type* name##_last(name##_ref_t vector) \
+    { \
+        tt_assert_and_check_return_val(vector && vector->size, tt_null); \
+        return vector->data + vector->size - 1; \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_insert_prev(name##_ref_t vector, tt_size_t itor, type data) \
+    { \
+        tt_assert_and_check_return(vector && itor <= vector->size); \
+        if (vector->size == vector->maxn && !name##_grow_(vector, vector->size + 1)) return; \
+        if (itor != vector->size) tt_memmov(vector->data + itor + 1, vector->data + itor, (vector->size - itor) * sizeof(type)); \
+        vector->data[itor] = data; \
+        vector->size++; \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_insert_next(name##_ref_t vector, tt_size_t itor, type data) \
+    { \
+        name##_insert_prev(vector, itor + 1, data); \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_insert_head(name##_ref_t vector, type data) \
+    { \
+        name##_insert_prev(vector, 0, data); \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_insert_tail(name##_ref_t vector, type data) \
+    { \
+        tt_assert(vector); \
+        if (vector->size == vector->maxn && !name##_grow_(vector, vector->size + 1)) return; \
+        vector->data[vector->size++] = data; \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_replace(name##_ref_t vector, tt_size_t itor, type data) \
+    { \
+        tt_assert_and_check_return(vector && itor < vector->size); \
+        vector->data[itor] = data; \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_replace_head(name##_ref_t vector, type data) \
+    { \
+        name##_replace(vector, 0, data); \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_replace_last(name##_ref_t vector, type data) \
+    { \
+        tt_assert_and_check_return(vector && vector->size); \
+        vector->data[vector->size - 1] = data; \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_remove_head(name##_ref_t vector) \
+    { \
+        name##_remove(vector, 0); \
+    } \
+    \
+    static __tt_inline__ tt_void_t name##_remove_last(name##_ref_t vector) \
+    { \
+        tt_assert_and_check_return(vector && vector->size); \
+        vector->size--; \
+    } \
+    \
+    static __tt_inline__ tt_size_t name##_size(name##_ref_t vector) \
+    { \
+        tt_assert_and_check_return_val(vector, 0); \
+        return vector->size; \
+    } \
+    \
+    static __tt_inline__ tt_size_t name##_grow(name##_ref_t vector) \
+    { \
+        tt_assert_and_check_return_val(vector, 0); \
+        return vector->grow; \
+    } \
+    \
+    static __tt_inline__ tt_size_t name##_maxn(name##_ref_t vector) \
+    { \
+        tt_assert_and_check_return_val(vector, 0); \
+        return vector->maxn; \
+    }
+
+#endif
@@ -0,0 +1,143 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       allocator.c
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-04
+ * @brief      allocator.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_MEMORY_ALLOCATOR"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+// for posix_memalign
+#define _POSIX_C_SOURCE               200112L
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "allocator.h"
+#include "malloc_trace.h"
+#include "../platform/port.h"
+#ifdef TT_COMPILER_IS_MSVC
+#   include <malloc.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the native allocations, they are traced by the call site of the allocator
+#ifdef TT_CONFIG_MALLOC_TRACE
+#   define tt_allocator_native_malloc(size)         tt_malloc_trace_malloc(size, file_, line_)
+#   define tt_allocator_native_malloc0(size)        tt_malloc_trace_malloc0(size, file_, line_)
+#   define tt_allocator_native_nalloc0(item, size)  tt_malloc_trace_nalloc0(item, size, file_, line_)
+#   define tt_allocator_native_ralloc(data, size)   tt_malloc_trace_ralloc(data, size, file_, line_)
+#else
+#   define tt_allocator_native_malloc(size)         tt_malloc(size)
+#   define tt_allocator_native_malloc0(size)        tt_malloc0(size)
+#   define tt_allocator_native_nalloc0(item, size)  tt_nalloc0(item, size)
+#   define tt_allocator_native_ralloc(data, size)   tt_ralloc(data, size)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_pointer_t tt_allocator_malloc_(tt_allocator_ref_t allocator, tt_size_t size __tt_malloc_trace_decl__)
+{
+    return allocator ? allocator->malloc(allocator, size) : tt_allocator_native_malloc(size);
+}
+
+tt_pointer_t tt_allocator_malloc0_(tt_allocator_ref_t allocator, tt_size_t size __tt_malloc_trace_decl__)
+{
+    // the native allocator
+    if (!allocator) return tt_allocator_native_malloc0(size);
+
+    tt_pointer_t data = allocator->malloc(allocator, size);
+    if (data) tt_memset(data, 0, size);
+    return data;
+}
+
+tt_pointer_t tt_allocator_nalloc0_(tt_allocator_ref_t allocator, tt_size_t item, tt_size_t size __tt_malloc_trace_decl__)
+{
+    // the native allocator
+    if (!allocator) return tt_allocator_native_nalloc0(item, size);
+
+    // overflow?
+    tt_check_return_val(!size || item <= (~(tt_size_t)0) / size, tt_null);
+    return tt_allocator_malloc0_(allocator, item * size __tt_malloc_trace_args__);
+}
+
+tt_pointer_t tt_allocator_ralloc_(tt_allocator_ref_t allocator, tt_pointer_t data, tt_size_t size __tt_malloc_trace_decl__)
+{
+    return allocator ? allocator->ralloc(allocator, data, size) : tt_allocator_native_ralloc(data, size);
+}
+
+tt_void_t tt_allocator_free(tt_allocator_ref_t allocator, tt_pointer_t data)
+{
+    tt_check_return(data);
+
+    if (allocator) allocator->free(allocator, data);
+    else tt_free(data);
+}
+
+tt_pointer_t tt_allocator_align_malloc_(tt_allocator_ref_t allocator, tt_size_t size, tt_size_t align __tt_malloc_trace_decl__)
+{
+    tt_assert_and_check_return_val(align && tt_ispow2(align), tt_null);
+
+    // the custom allocator, the align_malloc func is required for the aligned nodes
+    if (allocator)
+    {
+        tt_assert_and_check_return_val(allocator->align_malloc, tt_null);
+        return allocator->align_malloc(allocator, size, align);
+    }
+
+    // the native allocator
+    tt_pointer_t data = tt_null;
+    if (align < sizeof(tt_pointer_t)) align = sizeof(tt_pointer_t);
+#if defined(TT_CONFIG_MALLOC_TRACE)
+    data = tt_malloc_trace_align_malloc(size, align, file_, line_);
+#elif defined(TT_COMPILER_IS_MSVC)
+    data = _aligned_malloc(size, align);
+#else
+    if (posix_memalign(&data, align, size)) data = tt_null;
+#endif
+    return data;
+}
+
+tt_void_t tt_allocator_align_free(tt_allocator_ref_t allocator, tt_pointer_t data)
+{
+    tt_check_return(data);
+
+    if (allocator) allocator->free(allocator, data);
+    else
+    {
+        // @note not tt_free, the native aligned data is not allocated by tt_malloc
+#if defined(TT_CONFIG_MALLOC_TRACE)
+        tt_malloc_trace_free(data);
+#elif defined(TT_COMPILER_IS_MSVC)
+        _aligned_free(data);
+#else
+        free(data);
+#endif
+    }
+}
+
+tt_char_t* tt_allocator_strdup_(tt_allocator_ref_t allocator, tt_char_t const* str __tt_malloc_trace_decl__)
+{
+    tt_assert_and_check_return_val(str, tt_null);
+
+    tt_size_t  n = tt_strlen(str);
+    tt_char_t* p = (tt_char_t*)tt_allocator_malloc_(allocator, n + 1 __tt_malloc_trace_args__);
+    if (p)
+    {
+        tt_memcpy(p, str, n);
+        p[n] = '\0';
+    }
+    return p;
+}
@@ -0,0 +1,172 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       allocator.h
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-04
+ * @brief      allocator.h file
+ */
+
+#ifndef TT_MEMORY_ALLOCATOR_H
+#define TT_MEMORY_ALLOCATOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// pass the call site to the malloc trace, see memory/malloc_trace.h
+#define tt_allocator_malloc(allocator, size)                tt_allocator_malloc_(allocator, size __tt_malloc_trace_val__)
+#define tt_allocator_malloc0(allocator, size)               tt_allocator_malloc0_(allocator, size __tt_malloc_trace_val__)
+#define tt_allocator_nalloc0(allocator, item, size)         tt_allocator_nalloc0_(allocator, item, size __tt_malloc_trace_val__)
+#define tt_allocator_ralloc(allocator, data, size)          tt_allocator_ralloc_(allocator, data, size __tt_malloc_trace_val__)
+#define tt_allocator_align_malloc(allocator, size, align)   tt_allocator_align_malloc_(allocator, size, align __tt_malloc_trace_val__)
+#define tt_allocator_strdup(allocator, str)                 tt_allocator_strdup_(allocator, str __tt_malloc_trace_val__)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the allocator type
+ *
+ * the containers use the native allocator (tt_malloc, tt_ralloc and tt_free) if the allocator is tt_null
+ */
+typedef struct __tt_allocator_t
+{
+    /*! malloc data
+     *
+     * @param allocator     the allocator
+     * @param size          the size
+     *
+     * @return              the data
+     */
+    tt_pointer_t            (*malloc)(struct __tt_allocator_t* allocator, tt_size_t size);
+
+    /*! realloc data
+     *
+     * @param allocator     the allocator
+     * @param data          the data, malloc it if be tt_null
+     * @param size          the new size
+     *
+     * @return              the new data
+     */
+    tt_pointer_t            (*ralloc)(struct __tt_allocator_t* allocator, tt_pointer_t data, tt_size_t size);
+
+    /*! free data
+     *
+     * @param allocator     the allocator
+     * @param data          the data
+     */
+    tt_void_t               (*free)(struct __tt_allocator_t* allocator, tt_pointer_t data);
+
+    /*! malloc the aligned data, it is freed by the free func
+     *
+     * @param allocator     the allocator
+     * @param size          the size
+     * @param align         the alignment, pow2
+     *
+     * @return              the data
+     */
+    tt_pointer_t            (*align_malloc)(struct __tt_allocator_t* allocator, tt_size_t size, tt_size_t align);
+
+    /// the allocator private data
+    tt_cpointer_t           priv;
+
+}tt_allocator_t, *tt_allocator_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! malloc data
+ *
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ * @param size          the size
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_allocator_malloc_(tt_allocator_ref_t allocator, tt_size_t size __tt_malloc_trace_decl__);
+
+/*! malloc data and clear it
+ *
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ * @param size          the size
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_allocator_malloc0_(tt_allocator_ref_t allocator, tt_size_t size __tt_malloc_trace_decl__);
+
+/*! malloc the item array and clear it
+ *
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ * @param item          the item count
+ * @param size          the item size
+ *
+ * @return              the data, tt_null if the bytes overflow
+ */
+tt_pointer_t            tt_allocator_nalloc0_(tt_allocator_ref_t allocator, tt_size_t item, tt_size_t size __tt_malloc_trace_decl__);
+
+/*! realloc data
+ *
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ * @param data          the data, malloc it if be tt_null
+ * @param size          the new size
+ *
+ * @return              the new data, the old data is not freed if failed
+ */
+tt_pointer_t            tt_allocator_ralloc_(tt_allocator_ref_t allocator, tt_pointer_t data, tt_size_t size __tt_malloc_trace_decl__);
+
+/*! free data
+ *
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ * @param data          the data, may be tt_null
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_allocator_free(tt_allocator_ref_t allocator, tt_pointer_t data);
+
+/*! malloc the aligned data
+ *
+ * @param allocator     the allocator, using the native aligned allocation if be tt_null
+ * @param size          the size
+ * @param align         the alignment, pow2 and a multiple of sizeof(tt_pointer_t)
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_allocator_align_malloc_(tt_allocator_ref_t allocator, tt_size_t size, tt_size_t align __tt_malloc_trace_decl__);
+
+/*! free the aligned data
+ *
+ * @param allocator     the allocator, using the native aligned allocation if be tt_null
+ * @param data          the data, may be tt_null
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_allocator_align_free(tt_allocator_ref_t allocator, tt_pointer_t data);
+
+/*! duplicate string
+ *
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ * @param str           the string
+ *
+ * @return              the new string
+ */
+tt_char_t*              tt_allocator_strdup_(tt_allocator_ref_t allocator, tt_char_t const* str __tt_malloc_trace_decl__);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
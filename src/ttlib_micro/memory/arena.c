@@ -0,0 +1,392 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       arena.c
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-04
+ * @brief      arena.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_MEMORY_ARENA"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "arena.h"
+#include "../platform/port.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum chunk size
+#define TT_ARENA_CHUNK_SIZE_MIN             (256)
+
+// the chunk head size, the chunk data is aligned by TT_ARENA_ALIGN_DEFAULT
+#define TT_ARENA_CHUNK_HEAD                 tt_align(sizeof(tt_arena_chunk_t), TT_ARENA_ALIGN_DEFAULT)
+
+// the large data head size
+#define TT_ARENA_LARGE_HEAD                 tt_align(sizeof(tt_arena_large_t), TT_ARENA_ALIGN_DEFAULT)
+
+// the size head of the allocator data
+#define TT_ARENA_ALLOCATOR_HEAD             (TT_ARENA_ALIGN_DEFAULT)
+
+// the chunk data
+#define tt_arena_chunk_data(chunk)          ((tt_byte_t*)(chunk) + TT_ARENA_CHUNK_HEAD)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the chunk type
+typedef struct __tt_arena_chunk_t
+{
+    // the next chunk
+    struct __tt_arena_chunk_t*  next;
+
+    // the data bytes of the previous chunks
+    tt_size_t                   base;
+
+}tt_arena_chunk_t;
+
+// the large data type
+typedef struct __tt_arena_large_t
+{
+    // the next large data
+    struct __tt_arena_large_t*  next;
+
+    // the bytes
+    tt_size_t                   size;
+
+}tt_arena_large_t;
+
+typedef struct __tt_arena_t
+{
+    // the allocator
+    tt_allocator_t              allocator;
+
+    // the chunks
+    tt_arena_chunk_t*           head;
+
+    // the current chunk
+    tt_arena_chunk_t*           current;
+
+    // the bump position of the current chunk
+    tt_size_t                   pos;
+
+    // the chunk data size
+    tt_size_t                   chunk_size;
+
+    // the large data, the last one is the head
+    tt_arena_large_t*           large;
+
+    // the large data bytes
+    tt_size_t                   large_size;
+
+    // the last data of the allocator, it can be resized in place
+    tt_byte_t*                  last;
+
+}tt_arena_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tt_pointer_t tt_arena_large_malloc(tt_arena_t* arena, tt_size_t size, tt_size_t align)
+{
+    // overflow?
+    tt_size_t need = TT_ARENA_LARGE_HEAD + size + align;
+    tt_check_return_val(need > size, tt_null);
+
+    tt_arena_large_t* large = (tt_arena_large_t*)tt_malloc(need);
+    tt_assert_and_check_return_val(large, tt_null);
+
+    // push it
+    large->size         = need;
+    large->next         = arena->large;
+    arena->large        = large;
+    arena->large_size  += need;
+
+    return (tt_pointer_t)tt_align((tt_byte_t*)large + TT_ARENA_LARGE_HEAD, align);
+}
+
+static tt_void_t tt_arena_large_free(tt_arena_t* arena, tt_arena_large_t* tail)
+{
+    while (arena->large != tail)
+    {
+        tt_arena_large_t* large = arena->large;
+        arena->large        = large->next;
+        arena->large_size  -= large->size;
+        tt_free(large);
+    }
+}
+
+static tt_bool_t tt_arena_chunk_next(tt_arena_t* arena)
+{
+    // reuse the next chunk
+    tt_arena_chunk_t* next = arena->current ? arena->current->next : arena->head;
+    if (!next)
+    {
+        // make a new chunk
+        next = (tt_arena_chunk_t*)tt_malloc(TT_ARENA_CHUNK_HEAD + arena->chunk_size);
+        tt_assert_and_check_return_val(next, tt_false);
+
+        next->next = tt_null;
+        next->base = arena->current ? arena->current->base + arena->chunk_size : 0;
+        if (arena->current) arena->current->next = next;
+        else arena->head = next;
+    }
+
+    arena->current = next;
+    arena->pos     = 0;
+    return tt_true;
+}
+
+// the allocator data is in the current chunk?
+static __tt_inline__ tt_bool_t tt_arena_allocator_is_last(tt_arena_t* arena, tt_byte_t* data)
+{
+    return arena->last == data && arena->current
+        && data > tt_arena_chunk_data(arena->current)
+        && data <= tt_arena_chunk_data(arena->current) + arena->pos;
+}
+
+static tt_pointer_t tt_arena_allocator_malloc(tt_allocator_ref_t allocator, tt_size_t size)
+{
+    tt_arena_t* arena = (tt_arena_t*)allocator->priv;
+    tt_assert_and_check_return_val(arena && size + TT_ARENA_ALLOCATOR_HEAD > size, tt_null);
+
+    // store the size before the data for realloc
+    tt_byte_t* data = (tt_byte_t*)tt_arena_malloc((tt_arena_ref_t)arena, TT_ARENA_ALLOCATOR_HEAD + size);
+    tt_check_return_val(data, tt_null);
+    *((tt_size_t*)data) = size;
+
+    arena->last = data + TT_ARENA_ALLOCATOR_HEAD;
+    return arena->last;
+}
+
+static tt_pointer_t tt_arena_allocator_ralloc(tt_allocator_ref_t allocator, tt_pointer_t data, tt_size_t size)
+{
+    tt_arena_t* arena = (tt_arena_t*)allocator->priv;
+    tt_assert_and_check_return_val(arena, tt_null);
+
+    // malloc it
+    if (!data) return tt_arena_allocator_malloc(allocator, size);
+
+    // resize the last data in place
+    tt_byte_t* p     = (tt_byte_t*)data;
+    tt_size_t  osize = *((tt_size_t*)(p - TT_ARENA_ALLOCATOR_HEAD));
+    if (tt_arena_allocator_is_last(arena, p))
+    {
+        tt_size_t offset = p - tt_arena_chunk_data(arena->current);
+        if (size <= arena->chunk_size - offset)
+        {
+            *((tt_size_t*)(p - TT_ARENA_ALLOCATOR_HEAD)) = size;
+            arena->pos = offset + size;
+            return data;
+        }
+    }
+
+    // malloc the new data and copy it, the old data is freed after reseting
+    tt_pointer_t ndata = tt_arena_allocator_malloc(allocator, size);
+    tt_check_return_val(ndata, tt_null);
+    tt_memcpy(ndata, data, tt_min(osize, size));
+    return ndata;
+}
+
+static tt_void_t tt_arena_allocator_free(tt_allocator_ref_t allocator, tt_pointer_t data)
+{
+    tt_arena_t* arena = (tt_arena_t*)allocator->priv;
+    tt_assert_and_check_return(arena && data);
+
+    // only the last data can be freed at once
+    tt_byte_t* p = (tt_byte_t*)data;
+    if (tt_arena_allocator_is_last(arena, p))
+    {
+        arena->pos  = (p - TT_ARENA_ALLOCATOR_HEAD) - tt_arena_chunk_data(arena->current);
+        arena->last = tt_null;
+    }
+}
+
+static tt_pointer_t tt_arena_allocator_align_malloc(tt_allocator_ref_t allocator, tt_size_t size, tt_size_t align)
+{
+    tt_arena_t* arena = (tt_arena_t*)allocator->priv;
+    tt_assert_and_check_return_val(arena, tt_null);
+
+    // no size head, it can not be realloced
+    return tt_arena_align_malloc((tt_arena_ref_t)arena, size, align);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_arena_ref_t tt_arena_init(tt_size_t chunk_size)
+{
+    // done
+    tt_bool_t   ok = tt_false;
+    tt_arena_t* arena = tt_null;
+    do
+    {
+        arena = tt_malloc0(sizeof(tt_arena_t));
+        tt_assert_and_check_break(arena);
+
+        // init arena, the chunks are made lazily
+        if (!chunk_size) chunk_size = TT_ARENA_CHUNK_SIZE_DEFAULT;
+        arena->chunk_size = tt_align(tt_max(chunk_size, TT_ARENA_CHUNK_SIZE_MIN), TT_ARENA_ALIGN_DEFAULT);
+
+        // init allocator
+        arena->allocator.malloc         = tt_arena_allocator_malloc;
+        arena->allocator.ralloc         = tt_arena_allocator_ralloc;
+        arena->allocator.free           = tt_arena_allocator_free;
+        arena->allocator.align_malloc   = tt_arena_allocator_align_malloc;
+        arena->allocator.priv           = arena;
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && arena)
+    {
+        tt_free(arena);
+        arena = tt_null;
+    }
+
+    return (tt_arena_ref_t)arena;
+}
+
+tt_void_t tt_arena_exit(tt_arena_ref_t self)
+{
+    tt_arena_t* arena = (tt_arena_t*)self;
+    tt_assert_and_check_return(arena);
+
+    // free large data
+    tt_arena_large_free(arena, tt_null);
+
+    // free chunks
+    while (arena->head)
+    {
+        tt_arena_chunk_t* chunk = arena->head;
+        arena->head = chunk->next;
+        tt_free(chunk);
+    }
+
+    tt_free(arena);
+}
+
+tt_void_t tt_arena_reset(tt_arena_ref_t self)
+{
+    tt_arena_t* arena = (tt_arena_t*)self;
+    tt_assert_and_check_return(arena);
+
+    // free large data
+    tt_arena_large_free(arena, tt_null);
+
+    // reuse the chunks from the head
+    arena->current = arena->head;
+    arena->pos     = 0;
+    arena->last    = tt_null;
+}
+
+tt_pointer_t tt_arena_malloc(tt_arena_ref_t self, tt_size_t size)
+{
+    return tt_arena_align_malloc(self, size, TT_ARENA_ALIGN_DEFAULT);
+}
+
+tt_pointer_t tt_arena_malloc0(tt_arena_ref_t self, tt_size_t size)
+{
+    tt_pointer_t data = tt_arena_align_malloc(self, size, TT_ARENA_ALIGN_DEFAULT);
+    if (data) tt_memset(data, 0, size);
+    return data;
+}
+
+tt_pointer_t tt_arena_align_malloc(tt_arena_ref_t self, tt_size_t size, tt_size_t align)
+{
+    tt_arena_t* arena = (tt_arena_t*)self;
+    tt_assert_and_check_return_val(arena && align && tt_ispow2(align), tt_null);
+
+    // the last data of the allocator can not be resized now
+    arena->last = tt_null;
+
+    // bump it in the current chunk
+    if (arena->current)
+    {
+        tt_byte_t* data = tt_arena_chunk_data(arena->current);
+        tt_size_t  pos  = (tt_byte_t*)tt_align(data + arena->pos, align) - data;
+        if (pos <= arena->chunk_size && size <= arena->chunk_size - pos)
+        {
+            arena->pos = pos + size;
+            return data + pos;
+        }
+    }
+
+    // too large for one chunk?
+    if (size > arena->chunk_size || align > arena->chunk_size - size) return tt_arena_large_malloc(arena, size, align);
+
+    // bump it in the next chunk
+    if (!tt_arena_chunk_next(arena)) return tt_null;
+
+    tt_byte_t* data = tt_arena_chunk_data(arena->current);
+    tt_size_t  pos  = (tt_byte_t*)tt_align(data, align) - data;
+    arena->pos = pos + size;
+    return data + pos;
+}
+
+tt_char_t* tt_arena_strdup(tt_arena_ref_t self, tt_char_t const* str)
+{
+    tt_assert_and_check_return_val(str, tt_null);
+
+    tt_size_t  n = tt_strlen(str);
+    tt_char_t* p = (tt_char_t*)tt_arena_align_malloc(self, n + 1, 1);
+    if (p)
+    {
+        tt_memcpy(p, str, n);
+        p[n] = '\0';
+    }
+    return p;
+}
+
+tt_arena_savepoint_t tt_arena_save(tt_arena_ref_t self)
+{
+    tt_arena_t*          arena = (tt_arena_t*)self;
+    tt_arena_savepoint_t savepoint = {0};
+    tt_assert_and_check_return_val(arena, savepoint);
+
+    savepoint.chunk = arena->current;
+    savepoint.pos   = arena->pos;
+    savepoint.large = arena->large;
+    return savepoint;
+}
+
+tt_void_t tt_arena_restore(tt_arena_ref_t self, tt_arena_savepoint_t const* savepoint)
+{
+    tt_arena_t* arena = (tt_arena_t*)self;
+    tt_assert_and_check_return(arena && savepoint);
+
+    // free the later large data
+    tt_arena_large_free(arena, (tt_arena_large_t*)savepoint->large);
+
+    // restore the bump position, the later chunks are reused
+    arena->current = (tt_arena_chunk_t*)savepoint->chunk;
+    arena->pos     = savepoint->pos;
+    arena->last    = tt_null;
+}
+
+tt_allocator_ref_t tt_arena_allocator(tt_arena_ref_t self)
+{
+    tt_arena_t* arena = (tt_arena_t*)self;
+    tt_assert_and_check_return_val(arena, tt_null);
+
+    return &arena->allocator;
+}
+
+tt_size_t tt_arena_size(tt_arena_ref_t self)
+{
+    tt_arena_t* arena = (tt_arena_t*)self;
+    tt_assert_and_check_return_val(arena, 0);
+
+    return (arena->current ? arena->current->base + arena->pos : 0) + arena->large_size;
+}
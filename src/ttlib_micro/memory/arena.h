@@ -0,0 +1,192 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       arena.h
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-04
+ * @brief      arena.h file
+ */
+
+#ifndef TT_MEMORY_ARENA_H
+#define TT_MEMORY_ARENA_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the default chunk size
+#define TT_ARENA_CHUNK_SIZE_DEFAULT         (16384)
+
+/// the default alignment of tt_arena_malloc
+#define TT_ARENA_ALIGN_DEFAULT              (TT_CPU_BITBYTE << 1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the arena ref type
+ *
+ * <pre>
+ * chunks: |chunk0: data data data| -> |chunk1: data data ....| -> |chunk2: ......|
+ *                                                        |
+ *                                                       pos, the bump pointer
+ * large:  |data| -> |data| -> ...                        the data larger than one chunk
+ * </pre>
+ *
+ * the data is not freed one by one, the arena is reset or restored to the savepoint
+ * at once, and the chunks are reused after reseting.
+ *
+ * performance:
+ *
+ * malloc:  O(1), bump pointer
+ * reset:   O(1), the chunks are reused, the large data are freed
+ * restore: O(1), the large data after the savepoint are freed
+ */
+typedef __tt_typeref__(arena);
+
+/// the arena savepoint type
+typedef struct __tt_arena_savepoint_t
+{
+    /// the current chunk
+    tt_pointer_t            chunk;
+
+    /// the bump position of the current chunk
+    tt_size_t               pos;
+
+    /// the large data head
+    tt_pointer_t            large;
+
+}tt_arena_savepoint_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init arena
+ *
+ * @param chunk_size    the chunk size, using TT_ARENA_CHUNK_SIZE_DEFAULT if be zero
+ *
+ * @return              the arena
+ */
+tt_arena_ref_t          tt_arena_init(tt_size_t chunk_size);
+
+/*! exit arena, free all chunks
+ *
+ * @param arena         the arena
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_arena_exit(tt_arena_ref_t arena);
+
+/*! reset arena, all data are freed and the chunks are kept for reusing
+ *
+ * @param arena         the arena
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_arena_reset(tt_arena_ref_t arena);
+
+/*! malloc data which is aligned by TT_ARENA_ALIGN_DEFAULT
+ *
+ * @param arena         the arena
+ * @param size          the size
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_arena_malloc(tt_arena_ref_t arena, tt_size_t size);
+
+/*! malloc data and clear it
+ *
+ * @param arena         the arena
+ * @param size          the size
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_arena_malloc0(tt_arena_ref_t arena, tt_size_t size);
+
+/*! malloc the aligned data
+ *
+ * @param arena         the arena
+ * @param size          the size
+ * @param align         the alignment, pow2
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_arena_align_malloc(tt_arena_ref_t arena, tt_size_t size, tt_size_t align);
+
+/*! duplicate string
+ *
+ * @param arena         the arena
+ * @param str           the string
+ *
+ * @return              the new string
+ */
+tt_char_t*              tt_arena_strdup(tt_arena_ref_t arena, tt_char_t const* str);
+
+/*! save the current position
+ *
+ * @code
+ *
+ * tt_arena_savepoint_t savepoint = tt_arena_save(arena);
+ *
+ * // the temporary data
+ * tt_pointer_t data = tt_arena_malloc(arena, 1024);
+ *
+ * // free all data after the savepoint
+ * tt_arena_restore(arena, &savepoint);
+ *
+ * @endcode
+ *
+ * @param arena         the arena
+ *
+ * @return              the savepoint
+ */
+tt_arena_savepoint_t    tt_arena_save(tt_arena_ref_t arena);
+
+/*! restore to the savepoint, all data after it are freed
+ *
+ * @param arena         the arena
+ * @param savepoint     the savepoint, the later savepoints are invalid after restoring
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_arena_restore(tt_arena_ref_t arena, tt_arena_savepoint_t const* savepoint);
+
+/*! the arena allocator for the containers and elements, .e.g tt_vector_init_with_allocator
+ *
+ * the size of data is stored before it for realloc, the last data is resized in place,
+ * and tt_allocator_free only frees the last data, others are freed after reseting.
+ *
+ * @param arena         the arena
+ *
+ * @return              the allocator
+ */
+tt_allocator_ref_t      tt_arena_allocator(tt_arena_ref_t arena);
+
+/*! the used bytes, include the alignment padding
+ *
+ * @param arena         the arena
+ *
+ * @return              the used bytes
+ */
+tt_size_t               tt_arena_size(tt_arena_ref_t arena);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
@@ -0,0 +1,375 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       fixed_pool.c
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-03
+ * @brief      fixed_pool.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_MEMORY_FIXED_POOL"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "fixed_pool.h"
+#include "../container/list_entry.h"
+#include "../platform/port.h"
+#include "../utils/bits.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum item count of one slab, the slab size is enlarged for the large item
+#define TT_FIXED_POOL_SLAB_ITEMS_MIN        (8)
+
+// the maximum slab size
+#define TT_FIXED_POOL_SLAB_SIZE_MAX         (1 << 30)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the slab type
+typedef struct __tt_fixed_pool_slab_t
+{
+    // the list entry of the partial or full slabs
+    tt_list_entry_t     entry;
+
+    // the free items
+    tt_pointer_t        free;
+
+    // the used item count
+    tt_size_t           used;
+
+    // the count of the items which have been used once, the rest items are not in the free list
+    tt_size_t           bump;
+
+    // the used bits, be followed by the items
+    tt_size_t           bits[1];
+
+}tt_fixed_pool_slab_t;
+
+typedef struct __tt_fixed_pool_t
+{
+    // the partial slabs, the head slab is used for malloc
+    tt_list_entry_head_t            partial;
+
+    // the full slabs
+    tt_list_entry_head_t            full;
+
+    // the slab size
+    tt_size_t                       slab_size;
+
+    // the item offset of the slab
+    tt_size_t                       item_offset;
+
+    // the item count of one slab
+    tt_size_t                       item_maxn;
+
+    // the item size
+    tt_size_t                       item_size;
+
+    // the live item count
+    tt_size_t                       size;
+
+    // the item exit func
+    tt_fixed_pool_item_exit_func_t  item_exit;
+
+    // the user private data
+    tt_cpointer_t                   priv;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
+
+}tt_fixed_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tt_inline__ tt_size_t tt_fixed_pool_item_offset(tt_size_t item_maxn)
+{
+    // the slab head and the used bits
+    tt_size_t words = (item_maxn + TT_CPU_BITSIZE - 1) >> TT_CPU_SHIFT;
+    return tt_align_cpu(tt_offsetof(tt_fixed_pool_slab_t, bits) + tt_max(words, 1) * sizeof(tt_size_t));
+}
+
+static __tt_inline__ tt_byte_t* tt_fixed_pool_slab_item(tt_fixed_pool_t* pool, tt_fixed_pool_slab_t* slab, tt_size_t index)
+{
+    return (tt_byte_t*)slab + pool->item_offset + index * pool->item_size;
+}
+
+static tt_fixed_pool_slab_t* tt_fixed_pool_slab_make(tt_fixed_pool_t* pool)
+{
+    // make slab aligned by the slab size, then the slab of the item can be found by the address
+    tt_pointer_t slab = tt_allocator_align_malloc(pool->allocator, pool->slab_size, pool->slab_size);
+    tt_assert_and_check_return_val(slab, tt_null);
+
+    // only the head and the used bits need to be cleared, the items are bumped lazily
+    tt_memset(slab, 0, pool->item_offset);
+    return (tt_fixed_pool_slab_t*)slab;
+}
+
+static tt_void_t tt_fixed_pool_slab_free(tt_fixed_pool_t* pool, tt_fixed_pool_slab_t* slab)
+{
+    tt_allocator_align_free(pool->allocator, slab);
+}
+
+static tt_bool_t tt_fixed_pool_slab_walk(tt_fixed_pool_t* pool, tt_fixed_pool_slab_t* slab, tt_fixed_pool_item_walk_func_t func, tt_cpointer_t priv)
+{
+    tt_size_t i = 0;
+    tt_size_t n = (slab->bump + TT_CPU_BITSIZE - 1) >> TT_CPU_SHIFT;
+    for (i = 0; i < n; i++)
+    {
+        // walk the set bits of this word
+        tt_size_t bits = slab->bits[i];
+        while (bits)
+        {
+            tt_size_t b = tt_bits_cl0_u64_le((tt_uint64_t)bits);
+            bits &= bits - 1;
+            if (!func(tt_fixed_pool_slab_item(pool, slab, (i << TT_CPU_SHIFT) + b), priv)) return tt_false;
+        }
+    }
+    return tt_true;
+}
+
+static tt_bool_t tt_fixed_pool_item_exit(tt_pointer_t data, tt_cpointer_t priv)
+{
+    tt_fixed_pool_t* pool = (tt_fixed_pool_t*)priv;
+    pool->item_exit(data, pool->priv);
+    return tt_true;
+}
+
+static tt_void_t tt_fixed_pool_slabs_exit(tt_fixed_pool_t* pool, tt_list_entry_head_ref_t slabs)
+{
+    while (!tt_list_entry_is_null(slabs))
+    {
+        tt_fixed_pool_slab_t* slab = (tt_fixed_pool_slab_t*)tt_list_entry_head(slabs);
+        tt_list_entry_remove(slabs, &slab->entry);
+
+        // exit the live items
+        if (pool->item_exit && slab->used) tt_fixed_pool_slab_walk(pool, slab, tt_fixed_pool_item_exit, pool);
+        tt_fixed_pool_slab_free(pool, slab);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_fixed_pool_ref_t tt_fixed_pool_init(tt_size_t slab_size, tt_size_t item_size, tt_fixed_pool_item_exit_func_t item_exit, tt_cpointer_t priv)
+{
+    return tt_fixed_pool_init_with_allocator(slab_size, item_size, item_exit, priv, tt_null);
+}
+
+tt_fixed_pool_ref_t tt_fixed_pool_init_with_allocator(tt_size_t slab_size, tt_size_t item_size, tt_fixed_pool_item_exit_func_t item_exit, tt_cpointer_t priv, tt_allocator_ref_t allocator)
+{
+    // check
+    tt_assert_and_check_return_val(item_size && (!slab_size || tt_ispow2(slab_size)), tt_null);
+
+    // done
+    tt_bool_t           ok = tt_false;
+    tt_fixed_pool_t*    pool = tt_null;
+    do
+    {
+        pool = tt_allocator_malloc0(allocator, sizeof(tt_fixed_pool_t));
+        tt_assert_and_check_break(pool);
+        pool->allocator = allocator;
+
+        // the free item stores the next free item
+        item_size = tt_align_cpu(tt_max(item_size, sizeof(tt_pointer_t)));
+
+        // enlarge the slab size until it can contain enough items
+        if (!slab_size) slab_size = TT_FIXED_POOL_SLAB_SIZE_DEFAULT;
+        tt_size_t item_maxn = 0;
+        while (1)
+        {
+            // the item count which fits the head, the used bits and the items
+            item_maxn = slab_size / item_size;
+            while (item_maxn && tt_fixed_pool_item_offset(item_maxn) + item_maxn * item_size > slab_size) item_maxn--;
+            if (item_maxn >= TT_FIXED_POOL_SLAB_ITEMS_MIN || slab_size >= TT_FIXED_POOL_SLAB_SIZE_MAX) break;
+            slab_size <<= 1;
+        }
+        tt_assert_and_check_break(item_maxn);
+
+        // init pool
+        pool->slab_size     = slab_size;
+        pool->item_size     = item_size;
+        pool->item_maxn     = item_maxn;
+        pool->item_offset   = tt_fixed_pool_item_offset(item_maxn);
+        pool->item_exit     = item_exit;
+        pool->priv          = priv;
+        tt_list_entry_init(&pool->partial, tt_fixed_pool_slab_t, entry, tt_null);
+        tt_list_entry_init(&pool->full, tt_fixed_pool_slab_t, entry, tt_null);
+
+        ok = tt_true;
+
+    } while (0);
+
+    if (!ok && pool)
+    {
+        tt_allocator_free(allocator, pool);
+        pool = tt_null;
+    }
+
+    return (tt_fixed_pool_ref_t)pool;
+}
+
+tt_void_t tt_fixed_pool_exit(tt_fixed_pool_ref_t self)
+{
+    tt_fixed_pool_t* pool = (tt_fixed_pool_t*)self;
+    tt_assert_and_check_return(pool);
+
+    // clear all slabs
+    tt_fixed_pool_clear(self);
+
+    // exit lists
+    tt_list_entry_exit(&pool->partial);
+    tt_list_entry_exit(&pool->full);
+
+    tt_allocator_free(pool->allocator, pool);
+}
+
+tt_void_t tt_fixed_pool_clear(tt_fixed_pool_ref_t self)
+{
+    tt_fixed_pool_t* pool = (tt_fixed_pool_t*)self;
+    tt_assert_and_check_return(pool);
+
+    // free all slabs
+    tt_fixed_pool_slabs_exit(pool, &pool->partial);
+    tt_fixed_pool_slabs_exit(pool, &pool->full);
+
+    pool->size = 0;
+}
+
+tt_pointer_t tt_fixed_pool_malloc(tt_fixed_pool_ref_t self)
+{
+    tt_fixed_pool_t* pool = (tt_fixed_pool_t*)self;
+    tt_assert_and_check_return_val(pool, tt_null);
+
+    // make a new slab if no partial slabs
+    tt_fixed_pool_slab_t* slab = tt_null;
+    if (tt_list_entry_is_null(&pool->partial))
+    {
+        slab = tt_fixed_pool_slab_make(pool);
+        tt_check_return_val(slab, tt_null);
+        tt_list_entry_insert_head(&pool->partial, &slab->entry);
+    }
+    else slab = (tt_fixed_pool_slab_t*)tt_list_entry_head(&pool->partial);
+
+    // pop the free item, or bump the unused item
+    tt_byte_t* data = tt_null;
+    if (slab->free)
+    {
+        data = (tt_byte_t*)slab->free;
+        slab->free = *((tt_pointer_t*)data);
+    }
+    else
+    {
+        tt_assert(slab->bump < pool->item_maxn);
+        data = tt_fixed_pool_slab_item(pool, slab, slab->bump++);
+    }
+
+    // mark it used
+    tt_size_t index = (data - tt_fixed_pool_slab_item(pool, slab, 0)) / pool->item_size;
+    slab->bits[index >> TT_CPU_SHIFT] |= (tt_size_t)1 << (index & (TT_CPU_BITSIZE - 1));
+
+    // the slab is full now?
+    if (++slab->used == pool->item_maxn)
+    {
+        tt_list_entry_remove(&pool->partial, &slab->entry);
+        tt_list_entry_insert_head(&pool->full, &slab->entry);
+    }
+
+    pool->size++;
+    return (tt_pointer_t)data;
+}
+
+tt_pointer_t tt_fixed_pool_malloc0(tt_fixed_pool_ref_t self)
+{
+    tt_fixed_pool_t* pool = (tt_fixed_pool_t*)self;
+    tt_assert_and_check_return_val(pool, tt_null);
+
+    tt_pointer_t data = tt_fixed_pool_malloc(self);
+    if (data) tt_memset(data, 0, pool->item_size);
+    return data;
+}
+
+tt_bool_t tt_fixed_pool_free(tt_fixed_pool_ref_t self, tt_pointer_t data)
+{
+    tt_fixed_pool_t* pool = (tt_fixed_pool_t*)self;
+    tt_assert_and_check_return_val(pool && data, tt_false);
+
+    // the slab of this item
+    tt_fixed_pool_slab_t* slab = (tt_fixed_pool_slab_t*)((tt_size_t)data & ~(pool->slab_size - 1));
+
+    // check the item
+    tt_size_t offset = (tt_byte_t*)data - tt_fixed_pool_slab_item(pool, slab, 0);
+    tt_size_t index  = offset / pool->item_size;
+    tt_size_t mask   = (tt_size_t)1 << (index & (TT_CPU_BITSIZE - 1));
+    tt_assert_and_check_return_val((tt_byte_t*)data >= tt_fixed_pool_slab_item(pool, slab, 0) && index < slab->bump && !(offset % pool->item_size), tt_false);
+
+    // double free?
+    tt_assert_and_check_return_val(slab->bits[index >> TT_CPU_SHIFT] & mask, tt_false);
+    slab->bits[index >> TT_CPU_SHIFT] &= ~mask;
+
+    // push it to the free list
+    *((tt_pointer_t*)data) = slab->free;
+    slab->free = data;
+    pool->size--;
+
+    // the full slab becomes partial
+    if (slab->used-- == pool->item_maxn)
+    {
+        tt_list_entry_remove(&pool->full, &slab->entry);
+        tt_list_entry_insert_tail(&pool->partial, &slab->entry);
+    }
+    // free the empty slab if it is not the last partial slab
+    else if (!slab->used && tt_list_entry_size(&pool->partial) > 1)
+    {
+        tt_list_entry_remove(&pool->partial, &slab->entry);
+        tt_fixed_pool_slab_free(pool, slab);
+    }
+    return tt_true;
+}
+
+tt_void_t tt_fixed_pool_walk(tt_fixed_pool_ref_t self, tt_fixed_pool_item_walk_func_t func, tt_cpointer_t priv)
+{
+    tt_fixed_pool_t* pool = (tt_fixed_pool_t*)self;
+    tt_assert_and_check_return(pool && func);
+
+    tt_list_entry_head_ref_t lists[] = {&pool->full, &pool->partial};
+    tt_size_t i = 0;
+    for (i = 0; i < tt_arrayn(lists); i++)
+    {
+        tt_list_entry_ref_t entry = tt_list_entry_head(lists[i]);
+        tt_list_entry_ref_t tail  = tt_list_entry_tail(lists[i]);
+        for (; entry != tail; entry = tt_list_entry_next(entry))
+        {
+            tt_fixed_pool_slab_t* slab = (tt_fixed_pool_slab_t*)entry;
+            if (slab->used && !tt_fixed_pool_slab_walk(pool, slab, func, priv)) return;
+        }
+    }
+}
+
+tt_size_t tt_fixed_pool_size(tt_fixed_pool_ref_t self)
+{
+    tt_fixed_pool_t* pool = (tt_fixed_pool_t*)self;
+    tt_assert_and_check_return_val(pool, 0);
+
+    return pool->size;
+}
+
+tt_size_t tt_fixed_pool_item_size(tt_fixed_pool_ref_t self)
+{
+    tt_fixed_pool_t* pool = (tt_fixed_pool_t*)self;
+    tt_assert_and_check_return_val(pool, 0);
+
+    return pool->item_size;
+}
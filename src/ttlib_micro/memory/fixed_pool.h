@@ -0,0 +1,177 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       fixed_pool.h
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-03
+ * @brief      fixed_pool.h file
+ */
+
+#ifndef TT_MEMORY_FIXED_POOL_H
+#define TT_MEMORY_FIXED_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the default slab size of one page
+#define TT_FIXED_POOL_SLAB_SIZE_DEFAULT     (4096)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the fixed pool ref type
+ *
+ * <pre>
+ * partial: slab <-> slab <-> ...           the slabs which have free items
+ * full:    slab <-> slab <-> ...
+ *
+ * slab: |head|used bits|item|item|item| ... |   aligned by the slab size
+ *                         |        |
+ *                       free ----->           the intrusive free list
+ * </pre>
+ *
+ * the slab is aligned by the slab size, so the slab of the item is found
+ * by masking the item address, and the empty slab is freed if it is not
+ * the last partial slab.
+ *
+ * performance:
+ *
+ * malloc: O(1)
+ * free:   O(1)
+ * clear:  O(slabs)
+ */
+typedef __tt_typeref__(fixed_pool);
+
+/*! the item exit func type, be called when clearing or exiting the pool
+ *
+ * @param data          the item data
+ * @param priv          the user private data
+ */
+typedef tt_void_t       (*tt_fixed_pool_item_exit_func_t)(tt_pointer_t data, tt_cpointer_t priv);
+
+/*! the item walk func type
+ *
+ * @param data          the item data
+ * @param priv          the user private data
+ *
+ * @return              tt_true: continue, tt_false: break
+ */
+typedef tt_bool_t       (*tt_fixed_pool_item_walk_func_t)(tt_pointer_t data, tt_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init fixed pool
+ *
+ * @param slab_size     the slab bytes, pow2, using TT_FIXED_POOL_SLAB_SIZE_DEFAULT if be zero,
+ *                      it will be enlarged if the slab is too small for the item
+ * @param item_size     the item size
+ * @param item_exit     the item exit func, may be tt_null
+ * @param priv          the user private data of the item exit func
+ *
+ * @return              the fixed pool
+ */
+tt_fixed_pool_ref_t     tt_fixed_pool_init(tt_size_t slab_size, tt_size_t item_size, tt_fixed_pool_item_exit_func_t item_exit, tt_cpointer_t priv);
+
+/*! init fixed pool with the allocator
+ *
+ * @param slab_size     the slab bytes, pow2, using TT_FIXED_POOL_SLAB_SIZE_DEFAULT if be zero,
+ *                      it will be enlarged if the slab is too small for the item
+ * @param item_size     the item size
+ * @param item_exit     the item exit func, may be tt_null
+ * @param priv          the user private data of the item exit func
+ * @param allocator     the allocator, using the native allocator if be tt_null
+ *
+ * @return              the fixed pool
+ */
+tt_fixed_pool_ref_t     tt_fixed_pool_init_with_allocator(tt_size_t slab_size, tt_size_t item_size, tt_fixed_pool_item_exit_func_t item_exit, tt_cpointer_t priv, tt_allocator_ref_t allocator);
+
+/*! exit fixed pool, the item exit func is called for all live items
+ *
+ * @param pool          the fixed pool
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_fixed_pool_exit(tt_fixed_pool_ref_t pool);
+
+/*! clear fixed pool, the item exit func is called for all live items
+ *
+ * @param pool          the fixed pool
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_fixed_pool_clear(tt_fixed_pool_ref_t pool);
+
+/*! malloc one item
+ *
+ * @param pool          the fixed pool
+ *
+ * @return              the item data
+ */
+tt_pointer_t            tt_fixed_pool_malloc(tt_fixed_pool_ref_t pool);
+
+/*! malloc one item and clear it
+ *
+ * @param pool          the fixed pool
+ *
+ * @return              the item data
+ */
+tt_pointer_t            tt_fixed_pool_malloc0(tt_fixed_pool_ref_t pool);
+
+/*! free the item, the item exit func is not called
+ *
+ * @param pool          the fixed pool
+ * @param data          the item data
+ *
+ * @return              tt_true or tt_false if the item is not in the pool
+ */
+tt_bool_t               tt_fixed_pool_free(tt_fixed_pool_ref_t pool, tt_pointer_t data);
+
+/*! walk all live items, the items must not be freed in the walk func
+ *
+ * @param pool          the fixed pool
+ * @param func          the walk func
+ * @param priv          the user private data
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_fixed_pool_walk(tt_fixed_pool_ref_t pool, tt_fixed_pool_item_walk_func_t func, tt_cpointer_t priv);
+
+/*! the live item count
+ *
+ * @param pool          the fixed pool
+ *
+ * @return              the item count
+ */
+tt_size_t               tt_fixed_pool_size(tt_fixed_pool_ref_t pool);
+
+/*! the item size
+ *
+ * @param pool          the fixed pool
+ *
+ * @return              the item size
+ */
+tt_size_t               tt_fixed_pool_item_size(tt_fixed_pool_ref_t pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
@@ -0,0 +1,349 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       malloc_trace.c
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-06
+ * @brief      malloc_trace.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_MEMORY_MALLOC_TRACE"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "malloc_trace.h"
+#include "small_allocator.h"
+#include "../container/list_entry.h"
+#include "../platform/mutex.h"
+#include "../platform/port.h"
+
+#ifdef TT_CONFIG_MALLOC_TRACE
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum site count, pow2
+#define TT_MALLOC_TRACE_SITE_MAXN           (1024)
+
+// the maximum leak count of dumping
+#define TT_MALLOC_TRACE_LEAK_MAXN           (64)
+
+// the head magic for checking the invalid data
+#define TT_MALLOC_TRACE_MAGIC               (0x7474ab1e)
+
+// the head size before the data, the data is aligned by 16 bytes
+#define TT_MALLOC_TRACE_HEAD_SIZE           tt_align(sizeof(tt_malloc_trace_head_t), 16)
+
+// the head of the data
+#define tt_malloc_trace_head(data)          ((tt_malloc_trace_head_t*)((tt_byte_t*)(data) - sizeof(tt_malloc_trace_head_t)))
+
+// the native allocations, @note not tt_malloc, it is this trace
+#ifdef TT_CONFIG_SMALL_ALLOCATOR
+#   define tt_malloc_trace_native_malloc(size)  tt_small_allocator_malloc(size)
+#   define tt_malloc_trace_native_free(data)    tt_small_allocator_free(data)
+#else
+#   define tt_malloc_trace_native_malloc(size)  malloc(size)
+#   define tt_malloc_trace_native_free(data)    free(data)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the site type
+typedef struct __tt_malloc_trace_site_t
+{
+    // the file, it is tt_null if the site is unused
+    tt_char_t const*        file;
+
+    // the line
+    tt_size_t               line;
+
+    // the malloc count
+    tt_size_t               count;
+
+    // the free count
+    tt_size_t               freed;
+
+    // the total bytes
+    tt_hize_t               bytes;
+
+    // the live bytes
+    tt_size_t               live;
+
+    // the peak of the live bytes
+    tt_size_t               peak;
+
+}tt_malloc_trace_site_t;
+
+// the data head type, it is placed before the data
+typedef struct __tt_malloc_trace_head_t
+{
+    // the list entry of the live data
+    tt_list_entry_t         entry;
+
+    // the site
+    tt_malloc_trace_site_t* site;
+
+    // the native data
+    tt_pointer_t            base;
+
+    // the data size
+    tt_size_t               size;
+
+    // the magic
+    tt_size_t               magic;
+
+}tt_malloc_trace_head_t;
+
+// the malloc trace type
+typedef struct __tt_malloc_trace_t
+{
+    // the lock
+    tt_mutex_t              lock;
+
+    // the live data
+    tt_list_entry_head_t    live;
+
+    // is the live list inited?
+    tt_bool_t               inited;
+
+    // the live bytes
+    tt_size_t               size;
+
+    // the peak of the live bytes
+    tt_size_t               peak;
+
+    // the sites
+    tt_malloc_trace_site_t  sites[TT_MALLOC_TRACE_SITE_MAXN];
+
+    // the site of the rest call sites if the sites are full
+    tt_malloc_trace_site_t  other;
+
+}tt_malloc_trace_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the malloc trace
+static tt_malloc_trace_t g_malloc_trace = {TT_PTHREAD_MUTEX_INITIALIZER};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tt_malloc_trace_site_t* tt_malloc_trace_site(tt_char_t const* file, tt_size_t line)
+{
+    tt_malloc_trace_t* trace = &g_malloc_trace;
+
+    // find the site by the line, the same file may have the different string addresses
+    tt_size_t i = 0;
+    tt_size_t h = (line * 2654435761u) & (TT_MALLOC_TRACE_SITE_MAXN - 1);
+    for (i = 0; i < TT_MALLOC_TRACE_SITE_MAXN; i++, h = (h + 1) & (TT_MALLOC_TRACE_SITE_MAXN - 1))
+    {
+        tt_malloc_trace_site_t* site = &trace->sites[h];
+        if (!site->file)
+        {
+            site->file = file;
+            site->line = line;
+            return site;
+        }
+        if (site->line == line && (site->file == file || !tt_strcmp(site->file, file))) return site;
+    }
+
+    // the sites are full
+    trace->other.file = "other";
+    return &trace->other;
+}
+
+static tt_pointer_t tt_malloc_trace_done(tt_pointer_t base, tt_byte_t* data, tt_size_t size, tt_char_t const* file, tt_size_t line)
+{
+    tt_malloc_trace_t*      trace = &g_malloc_trace;
+    tt_malloc_trace_head_t* head = tt_malloc_trace_head(data);
+    head->base  = base;
+    head->size  = size;
+    head->magic = TT_MALLOC_TRACE_MAGIC;
+
+    // record it
+    tt_mutex_entry(&trace->lock);
+    if (!trace->inited)
+    {
+        tt_list_entry_init(&trace->live, tt_malloc_trace_head_t, entry, tt_null);
+        trace->inited = tt_true;
+    }
+    tt_list_entry_insert_tail(&trace->live, &head->entry);
+
+    tt_malloc_trace_site_t* site = tt_malloc_trace_site(file, line);
+    site->count++;
+    site->bytes += size;
+    site->live  += size;
+    if (site->live > site->peak) site->peak = site->live;
+    head->site = site;
+
+    trace->size += size;
+    if (trace->size > trace->peak) trace->peak = trace->size;
+    tt_mutex_leave(&trace->lock);
+
+    return data;
+}
+
+static tt_void_t tt_malloc_trace_sort(tt_malloc_trace_site_t** sites, tt_size_t size)
+{
+    // insertion sort by the bytes, the site count is small
+    tt_size_t i = 0;
+    tt_size_t j = 0;
+    for (i = 1; i < size; i++)
+    {
+        tt_malloc_trace_site_t* site = sites[i];
+        for (j = i; j > 0 && sites[j - 1]->bytes < site->bytes; j--) sites[j] = sites[j - 1];
+        sites[j] = site;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_pointer_t tt_malloc_trace_malloc(tt_size_t size, tt_char_t const* file, tt_size_t line)
+{
+    // overflow?
+    tt_check_return_val(size <= (~(tt_size_t)0) - TT_MALLOC_TRACE_HEAD_SIZE, tt_null);
+
+    tt_byte_t* base = (tt_byte_t*)tt_malloc_trace_native_malloc(size + TT_MALLOC_TRACE_HEAD_SIZE);
+    tt_check_return_val(base, tt_null);
+
+    return tt_malloc_trace_done(base, base + TT_MALLOC_TRACE_HEAD_SIZE, size, file, line);
+}
+
+tt_pointer_t tt_malloc_trace_malloc0(tt_size_t size, tt_char_t const* file, tt_size_t line)
+{
+    tt_pointer_t data = tt_malloc_trace_malloc(size, file, line);
+    if (data) tt_memset(data, 0, size);
+    return data;
+}
+
+tt_pointer_t tt_malloc_trace_nalloc0(tt_size_t item, tt_size_t size, tt_char_t const* file, tt_size_t line)
+{
+    tt_check_return_val(!size || item <= (~(tt_size_t)0) / size, tt_null);
+    return tt_malloc_trace_malloc0(item * size, file, line);
+}
+
+tt_pointer_t tt_malloc_trace_ralloc(tt_pointer_t data, tt_size_t size, tt_char_t const* file, tt_size_t line)
+{
+    // malloc it
+    tt_check_return_val(data, tt_malloc_trace_malloc(size, file, line));
+
+    // free it
+    if (!size)
+    {
+        tt_malloc_trace_free(data);
+        return tt_null;
+    }
+
+    // move it to the new data of this site
+    tt_pointer_t ndata = tt_malloc_trace_malloc(size, file, line);
+    if (ndata)
+    {
+        tt_size_t osize = tt_malloc_trace_head(data)->size;
+        tt_memcpy(ndata, data, tt_min(osize, size));
+        tt_malloc_trace_free(data);
+    }
+    return ndata;
+}
+
+tt_pointer_t tt_malloc_trace_align_malloc(tt_size_t size, tt_size_t align, tt_char_t const* file, tt_size_t line)
+{
+    tt_assert_and_check_return_val(align && tt_ispow2(align), tt_null);
+
+    // overflow?
+    if (align < 16) align = 16;
+    tt_check_return_val(size <= (~(tt_size_t)0) - TT_MALLOC_TRACE_HEAD_SIZE - align, tt_null);
+
+    // the data is aligned after the head
+    tt_byte_t* base = (tt_byte_t*)tt_malloc_trace_native_malloc(size + TT_MALLOC_TRACE_HEAD_SIZE + align);
+    tt_check_return_val(base, tt_null);
+
+    return tt_malloc_trace_done(base, (tt_byte_t*)tt_align(base + sizeof(tt_malloc_trace_head_t), align), size, file, line);
+}
+
+tt_void_t tt_malloc_trace_free(tt_pointer_t data)
+{
+    tt_check_return(data);
+
+    tt_malloc_trace_t*      trace = &g_malloc_trace;
+    tt_malloc_trace_head_t* head = tt_malloc_trace_head(data);
+    tt_assertf(head->magic == TT_MALLOC_TRACE_MAGIC, "free the invalid data: %p", data);
+
+    // remove it
+    tt_mutex_entry(&trace->lock);
+    tt_list_entry_remove(&trace->live, &head->entry);
+    head->site->freed++;
+    head->site->live -= head->size;
+    trace->size -= head->size;
+    tt_mutex_leave(&trace->lock);
+
+    // clear the magic for checking the double free
+    head->magic = 0;
+    tt_malloc_trace_native_free(head->base);
+}
+
+tt_size_t tt_malloc_trace_size(tt_void_t)
+{
+    return g_malloc_trace.size;
+}
+
+tt_size_t tt_malloc_trace_peak(tt_void_t)
+{
+    return g_malloc_trace.peak;
+}
+
+tt_void_t tt_malloc_trace_dump(tt_void_t)
+{
+    tt_malloc_trace_t*      trace = &g_malloc_trace;
+    tt_malloc_trace_site_t* sites[TT_MALLOC_TRACE_SITE_MAXN + 1];
+    tt_size_t               size = 0;
+    tt_size_t               i = 0;
+
+    tt_mutex_entry(&trace->lock);
+
+    // dump the sites by the bytes
+    for (i = 0; i < TT_MALLOC_TRACE_SITE_MAXN; i++)
+    {
+        if (trace->sites[i].file) sites[size++] = &trace->sites[i];
+    }
+    if (trace->other.file) sites[size++] = &trace->other;
+    tt_malloc_trace_sort(sites, size);
+
+    tt_trace_i("live: %lu bytes, peak: %lu bytes, sites: %lu", trace->size, trace->peak, size);
+    for (i = 0; i < size; i++)
+    {
+        tt_malloc_trace_site_t* site = sites[i];
+        tt_trace_i("%s:%lu, count: %lu, freed: %lu, bytes: %llu, live: %lu, peak: %lu"
+                    , site->file, site->line, site->count, site->freed, site->bytes, site->live, site->peak);
+    }
+
+    // dump the leaks
+    if (trace->inited && !tt_list_entry_is_null(&trace->live))
+    {
+        tt_size_t           n = 0;
+        tt_list_entry_ref_t entry = tt_list_entry_head(&trace->live);
+        tt_list_entry_ref_t tail  = tt_list_entry_tail(&trace->live);
+        for (; entry != tail && n < TT_MALLOC_TRACE_LEAK_MAXN; entry = tt_list_entry_next(entry), n++)
+        {
+            tt_malloc_trace_head_t* head = (tt_malloc_trace_head_t*)entry;
+            tt_trace_w("leak: %p, %lu bytes, at %s:%lu", (tt_byte_t*)head + sizeof(tt_malloc_trace_head_t), head->size, head->site->file, head->site->line);
+        }
+        if (tt_list_entry_size(&trace->live) > n) tt_trace_w("leak: %lu more ...", tt_list_entry_size(&trace->live) - n);
+    }
+
+    tt_mutex_leave(&trace->lock);
+}
+
+#endif
@@ -0,0 +1,139 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       malloc_trace.h
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-06
+ * @brief      malloc_trace.h file
+ */
+
+#ifndef TT_MEMORY_MALLOC_TRACE_H
+#define TT_MEMORY_MALLOC_TRACE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the malloc trace, it is compiled only if TT_CONFIG_MALLOC_TRACE is enabled in prefix/config.h
+ *
+ * <pre>
+ * data: |head|data...|     head: the call site, size and the live list entry
+ *          |
+ * site:  file:line -> count, bytes, live bytes, peak bytes
+ * </pre>
+ *
+ * tt_malloc, tt_ralloc and tt_allocator_malloc with the native allocator
+ * record the __tt_file__ and __tt_line__ of the caller, then the sites are
+ * dumped by the bytes and the live data are reported as the leaks at tt_lib_exit.
+ *
+ * the data of the custom allocators are not traced, but the chunks which
+ * are allocated by them from tt_malloc are traced, .e.g the arena chunks.
+ *
+ * it adds nothing if it is disabled, tt_malloc is expanded to the libc or
+ * the small allocator directly.
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+#ifdef TT_CONFIG_MALLOC_TRACE
+
+/*! malloc data
+ *
+ * @param size          the size
+ * @param file          the file of the call site
+ * @param line          the line of the call site
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_malloc_trace_malloc(tt_size_t size, tt_char_t const* file, tt_size_t line);
+
+/*! malloc data and fill zero
+ *
+ * @param size          the size
+ * @param file          the file of the call site
+ * @param line          the line of the call site
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_malloc_trace_malloc0(tt_size_t size, tt_char_t const* file, tt_size_t line);
+
+/*! malloc data of the given item count and fill zero
+ *
+ * @param item          the item count
+ * @param size          the item size
+ * @param file          the file of the call site
+ * @param line          the line of the call site
+ *
+ * @return              the data, tt_null if the bytes overflow
+ */
+tt_pointer_t            tt_malloc_trace_nalloc0(tt_size_t item, tt_size_t size, tt_char_t const* file, tt_size_t line);
+
+/*! realloc data, the new data is recorded at the call site
+ *
+ * @param data          the data, malloc it if be tt_null
+ * @param size          the new size, free the data if be zero
+ * @param file          the file of the call site
+ * @param line          the line of the call site
+ *
+ * @return              the new data, the old data is not freed if failed
+ */
+tt_pointer_t            tt_malloc_trace_ralloc(tt_pointer_t data, tt_size_t size, tt_char_t const* file, tt_size_t line);
+
+/*! malloc the aligned data, it is freed by tt_malloc_trace_free
+ *
+ * @param size          the size
+ * @param align         the alignment, pow2
+ * @param file          the file of the call site
+ * @param line          the line of the call site
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_malloc_trace_align_malloc(tt_size_t size, tt_size_t align, tt_char_t const* file, tt_size_t line);
+
+/*! free data
+ *
+ * @param data          the data, may be tt_null
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_malloc_trace_free(tt_pointer_t data);
+
+/*! the live bytes
+ *
+ * @return              the live bytes
+ */
+tt_size_t               tt_malloc_trace_size(tt_void_t);
+
+/*! the peak of the live bytes
+ *
+ * @return              the peak bytes
+ */
+tt_size_t               tt_malloc_trace_peak(tt_void_t);
+
+/*! dump the sites by the bytes and the live data, it is called at tt_lib_exit for reporting the leaks
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_malloc_trace_dump(tt_void_t);
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
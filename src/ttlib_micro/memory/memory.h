@@ -0,0 +1,23 @@
+/*
+ * @Copyright (C) 2019-2021, TTLIB
+ * @file       memory.h
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-03
+ * @brief      memory.h file
+ */
+
+#ifndef TT_MEMORY_MEMORY_H
+#define TT_MEMORY_MEMORY_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "allocator.h"
+#include "fixed_pool.h"
+#include "arena.h"
+#include "small_allocator.h"
+#include "malloc_trace.h"
+#include "vmem.h"
+
+#endif
@@ -0,0 +1,18 @@
+/*
+ * @Copyright (C) 2019-2021, TTLIB
+ * @file       prefix.h
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-03
+ * @brief      prefix.h file
+ */
+
+#ifndef TT_MEMORY_PREFIX_H
+#define TT_MEMORY_PREFIX_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+
+#endif
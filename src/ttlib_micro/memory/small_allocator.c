@@ -0,0 +1,540 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       small_allocator.c
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-05
+ * @brief      small_allocator.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_MEMORY_SMALL_ALLOCATOR"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+// for mmap and MAP_ANONYMOUS
+#define _DEFAULT_SOURCE
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "small_allocator.h"
+#include "../container/list_entry.h"
+#include "../platform/mutex.h"
+#include "../platform/port.h"
+#include <pthread.h>
+#include <sys/mman.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the slab size, the slab is aligned by it
+#define TT_SMALL_ALLOCATOR_SLAB_SIZE        (65536)
+
+// the slab head size, the items are aligned by 16 bytes after it
+#define TT_SMALL_ALLOCATOR_SLAB_HEAD        (64)
+
+// the data alignment of the classes larger than 8 bytes
+#define TT_SMALL_ALLOCATOR_DATA_ALIGN       (16)
+
+// the reserved region size, only the touched pages are committed
+#ifdef TT_CPU_BIT_64
+#   define TT_SMALL_ALLOCATOR_REGION_MAXN   ((tt_size_t)1 << 32)
+#else
+#   define TT_SMALL_ALLOCATOR_REGION_MAXN   ((tt_size_t)1 << 28)
+#endif
+
+// the minimum region size, the region is halved until it is reserved
+#define TT_SMALL_ALLOCATOR_REGION_MINN      ((tt_size_t)1 << 24)
+
+// the bytes of one refill or flush batch
+#define TT_SMALL_ALLOCATOR_BATCH_SIZE       (16384)
+
+// the item count range of one batch
+#define TT_SMALL_ALLOCATOR_BATCH_MINN       (4)
+#define TT_SMALL_ALLOCATOR_BATCH_MAXN       (64)
+
+// the class count
+#define TT_SMALL_ALLOCATOR_CLASS_MAXN       (29)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the slab type
+typedef struct __tt_small_allocator_slab_t
+{
+    // the list entry of the partial slabs
+    tt_list_entry_t         entry;
+
+    // the free items
+    tt_pointer_t            free;
+
+    // the used item count, include the items in the thread caches
+    tt_size_t               used;
+
+    // the offset of the items which have not been used once
+    tt_size_t               bump;
+
+    // the class index
+    tt_size_t               index;
+
+    // is full? it is not in the partial slabs if be full
+    tt_bool_t               full;
+
+}tt_small_allocator_slab_t;
+
+// the central class type
+typedef struct __tt_small_allocator_class_t
+{
+    // the lock
+    tt_mutex_t              lock;
+
+    // the partial slabs
+    tt_list_entry_head_t    partial;
+
+    // the item size
+    tt_size_t               size;
+
+    // the item count of one batch
+    tt_size_t               batch;
+
+}tt_small_allocator_class_t;
+
+// the thread cache bin type
+typedef struct __tt_small_allocator_bin_t
+{
+    // the free items
+    tt_pointer_t            head;
+
+    // the item count
+    tt_size_t               count;
+
+}tt_small_allocator_bin_t;
+
+// the thread cache type
+typedef struct __tt_small_allocator_cache_t
+{
+    // the bins of all classes
+    tt_small_allocator_bin_t bins[TT_SMALL_ALLOCATOR_CLASS_MAXN];
+
+    // is registered for flushing it at the thread exit?
+    tt_bool_t               registered;
+
+}tt_small_allocator_cache_t;
+
+// the small allocator type
+typedef struct __tt_small_allocator_t
+{
+    // the region base, it is tt_null if the region has not been reserved
+    tt_byte_t*              base;
+
+    // the region tail
+    tt_byte_t*              tail;
+
+    // the region data which have not been used once
+    tt_byte_t*              bump;
+
+    // the free slabs
+    tt_pointer_t            slabs;
+
+    // the region lock
+    tt_mutex_t              lock;
+
+    // the thread cache key
+    pthread_key_t           key;
+
+    // the classes
+    tt_small_allocator_class_t classes[TT_SMALL_ALLOCATOR_CLASS_MAXN];
+
+    // the class index of the size: (size + 15) >> 4
+    tt_uint8_t              indices[(TT_SMALL_ALLOCATOR_DATA_MAXN >> 4) + 1];
+
+}tt_small_allocator_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the class sizes, 4 classes for each pow2 above 128 bytes, the waste is < 25%
+static tt_uint16_t const g_small_allocator_sizes[] =
+{
+    8,    16,   32,   48,   64,   80,   96,   112,  128
+,   160,  192,  224,  256,  320,  384,  448,  512
+,   640,  768,  896,  1024, 1280, 1536, 1792, 2048
+,   2560, 3072, 3584, 4096
+};
+
+// the small allocator
+static tt_small_allocator_t                         g_small_allocator;
+
+// the small allocator once
+static pthread_once_t                               g_small_allocator_once = PTHREAD_ONCE_INIT;
+
+// the thread cache
+static __tt_thread_local__ tt_small_allocator_cache_t g_small_allocator_cache;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tt_inline__ tt_bool_t tt_small_allocator_is_small(tt_cpointer_t data)
+{
+    return (tt_byte_t const*)data >= g_small_allocator.base && (tt_byte_t const*)data < g_small_allocator.tail;
+}
+
+static __tt_inline__ tt_small_allocator_slab_t* tt_small_allocator_slab(tt_cpointer_t data)
+{
+    return (tt_small_allocator_slab_t*)((tt_size_t)data & ~(tt_size_t)(TT_SMALL_ALLOCATOR_SLAB_SIZE - 1));
+}
+
+static tt_small_allocator_slab_t* tt_small_allocator_slab_make(tt_size_t index)
+{
+    tt_small_allocator_t*       allocator = &g_small_allocator;
+    tt_small_allocator_slab_t*  slab = tt_null;
+
+    // get a free slab or carve a new slab from the region
+    tt_mutex_entry(&allocator->lock);
+    if (allocator->slabs)
+    {
+        slab = (tt_small_allocator_slab_t*)allocator->slabs;
+        allocator->slabs = *((tt_pointer_t*)slab);
+    }
+    else if (allocator->bump < allocator->tail)
+    {
+        slab = (tt_small_allocator_slab_t*)allocator->bump;
+        allocator->bump += TT_SMALL_ALLOCATOR_SLAB_SIZE;
+    }
+    tt_mutex_leave(&allocator->lock);
+    tt_check_return_val(slab, tt_null);
+
+    // init slab
+    slab->free  = tt_null;
+    slab->used  = 0;
+    slab->bump  = TT_SMALL_ALLOCATOR_SLAB_HEAD;
+    slab->index = index;
+    slab->full  = tt_false;
+    return slab;
+}
+
+static tt_void_t tt_small_allocator_slab_free(tt_small_allocator_slab_t* slab)
+{
+    tt_small_allocator_t* allocator = &g_small_allocator;
+
+    // the slab may be reused by other classes
+    tt_mutex_entry(&allocator->lock);
+    *((tt_pointer_t*)slab) = allocator->slabs;
+    allocator->slabs = slab;
+    tt_mutex_leave(&allocator->lock);
+}
+
+static tt_bool_t tt_small_allocator_bin_refill(tt_small_allocator_bin_t* bin, tt_size_t index)
+{
+    tt_small_allocator_class_t* klass = &g_small_allocator.classes[index];
+    tt_pointer_t                head = tt_null;
+    tt_size_t                   size = klass->size;
+    tt_size_t                   n = 0;
+
+    // take one batch from the partial slabs
+    tt_mutex_entry(&klass->lock);
+    while (n < klass->batch)
+    {
+        tt_small_allocator_slab_t* slab = tt_null;
+        if (tt_list_entry_is_null(&klass->partial))
+        {
+            slab = tt_small_allocator_slab_make(index);
+            tt_check_break(slab);
+
+            tt_list_entry_insert_head(&klass->partial, &slab->entry);
+        }
+        else slab = (tt_small_allocator_slab_t*)tt_list_entry_head(&klass->partial);
+
+        // take the freed items first, and then the items which have not been used once
+        while (n < klass->batch)
+        {
+            tt_pointer_t item = tt_null;
+            if (slab->free)
+            {
+                item = slab->free;
+                slab->free = *((tt_pointer_t*)item);
+            }
+            else if (slab->bump + size <= TT_SMALL_ALLOCATOR_SLAB_SIZE)
+            {
+                item = (tt_byte_t*)slab + slab->bump;
+                slab->bump += size;
+            }
+            else break;
+
+            *((tt_pointer_t*)item) = head;
+            head = item;
+            slab->used++;
+            n++;
+        }
+
+        // remove the full slab from the partial slabs
+        if (!slab->free && slab->bump + size > TT_SMALL_ALLOCATOR_SLAB_SIZE)
+        {
+            tt_list_entry_remove(&klass->partial, &slab->entry);
+            slab->full = tt_true;
+        }
+    }
+    tt_mutex_leave(&klass->lock);
+
+    // the bin is empty before refilling
+    bin->head  = head;
+    bin->count = n;
+    return n ? tt_true : tt_false;
+}
+
+static tt_void_t tt_small_allocator_bin_flush(tt_small_allocator_bin_t* bin, tt_size_t index, tt_size_t count)
+{
+    tt_small_allocator_class_t* klass = &g_small_allocator.classes[index];
+
+    // return the items to their slabs
+    tt_mutex_entry(&klass->lock);
+    while (count-- && bin->head)
+    {
+        tt_pointer_t item = bin->head;
+        bin->head = *((tt_pointer_t*)item);
+        bin->count--;
+
+        tt_small_allocator_slab_t* slab = tt_small_allocator_slab(item);
+        *((tt_pointer_t*)item) = slab->free;
+        slab->free = item;
+        slab->used--;
+
+        if (slab->full)
+        {
+            tt_list_entry_insert_tail(&klass->partial, &slab->entry);
+            slab->full = tt_false;
+        }
+        // free the empty slab if it is not the last partial slab
+        else if (!slab->used && tt_list_entry_size(&klass->partial) > 1)
+        {
+            tt_list_entry_remove(&klass->partial, &slab->entry);
+            tt_small_allocator_slab_free(slab);
+        }
+    }
+    tt_mutex_leave(&klass->lock);
+}
+
+static tt_void_t tt_small_allocator_cache_exit(tt_pointer_t priv)
+{
+    tt_small_allocator_cache_t* cache = (tt_small_allocator_cache_t*)priv;
+    tt_assert_and_check_return(cache);
+
+    // flush all bins, it will be registered again if the data is freed after exiting
+    tt_size_t i = 0;
+    for (i = 0; i < TT_SMALL_ALLOCATOR_CLASS_MAXN; i++)
+    {
+        if (cache->bins[i].count) tt_small_allocator_bin_flush(&cache->bins[i], i, cache->bins[i].count);
+    }
+    cache->registered = tt_false;
+}
+
+static tt_void_t tt_small_allocator_instance_init(tt_void_t)
+{
+    tt_small_allocator_t* allocator = &g_small_allocator;
+    tt_assert_static(tt_arrayn(g_small_allocator_sizes) == TT_SMALL_ALLOCATOR_CLASS_MAXN);
+    tt_assert_static(sizeof(tt_small_allocator_slab_t) <= TT_SMALL_ALLOCATOR_SLAB_HEAD);
+
+    // init classes
+    tt_size_t i = 0;
+    tt_size_t k = 0;
+    for (i = 0; i < TT_SMALL_ALLOCATOR_CLASS_MAXN; i++)
+    {
+        tt_small_allocator_class_t* klass = &allocator->classes[i];
+        klass->size  = g_small_allocator_sizes[i];
+        klass->batch = TT_SMALL_ALLOCATOR_BATCH_SIZE / klass->size;
+        klass->batch = tt_max(klass->batch, TT_SMALL_ALLOCATOR_BATCH_MINN);
+        klass->batch = tt_min(klass->batch, TT_SMALL_ALLOCATOR_BATCH_MAXN);
+        tt_mutex_init_impl(&klass->lock);
+        tt_list_entry_init(&klass->partial, tt_small_allocator_slab_t, entry, tt_null);
+    }
+
+    // init the class indices, the data <= 8 bytes is in the first class
+    for (i = 1, k = 1; i < tt_arrayn(allocator->indices); i++)
+    {
+        while (g_small_allocator_sizes[k] < (i << 4)) k++;
+        allocator->indices[i] = (tt_uint8_t)k;
+    }
+
+    // flush the thread cache at the thread exit
+    tt_mutex_init_impl(&allocator->lock);
+    if (pthread_key_create(&allocator->key, tt_small_allocator_cache_exit))
+    {
+        tt_trace_e("create the thread cache key failed, using the libc");
+        return ;
+    }
+
+    // reserve the region, it is halved if the address space is not enough
+    tt_pointer_t data = MAP_FAILED;
+    tt_size_t    size = TT_SMALL_ALLOCATOR_REGION_MAXN;
+    for (; size >= TT_SMALL_ALLOCATOR_REGION_MINN; size >>= 1)
+    {
+        data = mmap(tt_null, size + TT_SMALL_ALLOCATOR_SLAB_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (data != MAP_FAILED) break;
+    }
+    if (data == MAP_FAILED)
+    {
+        tt_trace_e("reserve the region failed, using the libc");
+        return ;
+    }
+
+    // the region is never unmapped, the data may be freed after exiting
+    allocator->base = (tt_byte_t*)tt_align(data, TT_SMALL_ALLOCATOR_SLAB_SIZE);
+    allocator->tail = allocator->base + size;
+    allocator->bump = allocator->base;
+}
+
+static __tt_inline__ tt_small_allocator_cache_t* tt_small_allocator_cache(tt_void_t)
+{
+    tt_small_allocator_cache_t* cache = &g_small_allocator_cache;
+    if (!cache->registered)
+    {
+        pthread_once(&g_small_allocator_once, tt_small_allocator_instance_init);
+        if (g_small_allocator.base) pthread_setspecific(g_small_allocator.key, cache);
+        cache->registered = tt_true;
+    }
+    return cache;
+}
+
+static tt_pointer_t tt_small_allocator_adapter_malloc(tt_allocator_ref_t allocator, tt_size_t size)
+{
+    return tt_small_allocator_malloc(size);
+}
+
+static tt_pointer_t tt_small_allocator_adapter_ralloc(tt_allocator_ref_t allocator, tt_pointer_t data, tt_size_t size)
+{
+    return tt_small_allocator_ralloc(data, size);
+}
+
+static tt_void_t tt_small_allocator_adapter_free(tt_allocator_ref_t allocator, tt_pointer_t data)
+{
+    tt_small_allocator_free(data);
+}
+
+static tt_pointer_t tt_small_allocator_adapter_align_malloc(tt_allocator_ref_t allocator, tt_size_t size, tt_size_t align)
+{
+    // the small classes are aligned by 16 bytes
+    if (align <= TT_SMALL_ALLOCATOR_DATA_ALIGN) return tt_small_allocator_malloc(tt_max(size, align));
+
+    // the larger alignment is allocated by the libc and freed by tt_small_allocator_free
+    // @note not tt_allocator_align_malloc, it may be the malloc trace which is not freed by the libc
+    tt_pointer_t data = tt_null;
+    if (posix_memalign(&data, align, size)) data = tt_null;
+    return data;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_pointer_t tt_small_allocator_malloc(tt_size_t size)
+{
+    // the large data, @note not tt_malloc, it may be this allocator
+    if (!size || size > TT_SMALL_ALLOCATOR_DATA_MAXN) return malloc(size);
+
+    // the libc is used if the region has not been reserved
+    tt_small_allocator_cache_t* cache = tt_small_allocator_cache();
+    tt_check_return_val(g_small_allocator.base, malloc(size));
+
+    // get the bin of the size class
+    tt_size_t index = size <= 8? 0 : g_small_allocator.indices[(size + 15) >> 4];
+    tt_small_allocator_bin_t* bin = &cache->bins[index];
+
+    // refill one batch if the bin is empty, the libc is used if the region is full
+    if (!bin->head && !tt_small_allocator_bin_refill(bin, index)) return malloc(size);
+
+    // pop item
+    tt_pointer_t item = bin->head;
+    bin->head = *((tt_pointer_t*)item);
+    bin->count--;
+    return item;
+}
+
+tt_pointer_t tt_small_allocator_malloc0(tt_size_t size)
+{
+    tt_pointer_t data = tt_small_allocator_malloc(size);
+    if (data) tt_memset(data, 0, size);
+    return data;
+}
+
+tt_pointer_t tt_small_allocator_nalloc0(tt_size_t item, tt_size_t size)
+{
+    tt_check_return_val(!size || item <= (~(tt_size_t)0) / size, tt_null);
+    return tt_small_allocator_malloc0(item * size);
+}
+
+tt_pointer_t tt_small_allocator_ralloc(tt_pointer_t data, tt_size_t size)
+{
+    // malloc it
+    tt_check_return_val(data, tt_small_allocator_malloc(size));
+
+    // free it
+    if (!size)
+    {
+        tt_small_allocator_free(data);
+        return tt_null;
+    }
+
+    // the libc data
+    tt_check_return_val(tt_small_allocator_is_small(data), realloc(data, size));
+
+    // the class is large enough?
+    tt_size_t osize = g_small_allocator.classes[tt_small_allocator_slab(data)->index].size;
+    tt_check_return_val(size > osize, data);
+
+    // move it to the larger class or the libc
+    tt_pointer_t ndata = tt_small_allocator_malloc(size);
+    if (ndata)
+    {
+        tt_memcpy(ndata, data, osize);
+        tt_small_allocator_free(data);
+    }
+    return ndata;
+}
+
+tt_void_t tt_small_allocator_free(tt_pointer_t data)
+{
+    tt_check_return(data);
+
+    // the libc data
+    if (!tt_small_allocator_is_small(data))
+    {
+        free(data);
+        return ;
+    }
+
+    // push it to the bin of the current thread, even if it is allocated by other threads
+    tt_size_t                   index = tt_small_allocator_slab(data)->index;
+    tt_small_allocator_bin_t*   bin = &tt_small_allocator_cache()->bins[index];
+    *((tt_pointer_t*)data) = bin->head;
+    bin->head = data;
+    bin->count++;
+
+    // flush one batch to the central slabs if the bin is too large
+    tt_size_t batch = g_small_allocator.classes[index].batch;
+    if (bin->count > (batch << 1)) tt_small_allocator_bin_flush(bin, index, batch);
+}
+
+tt_void_t tt_small_allocator_flush(tt_void_t)
+{
+    tt_small_allocator_cache_t* cache = &g_small_allocator_cache;
+    if (cache->registered && g_small_allocator.base) tt_small_allocator_cache_exit(cache);
+}
+
+tt_allocator_ref_t tt_small_allocator(tt_void_t)
+{
+    static tt_allocator_t s_allocator =
+    {
+        tt_small_allocator_adapter_malloc
+    ,   tt_small_allocator_adapter_ralloc
+    ,   tt_small_allocator_adapter_free
+    ,   tt_small_allocator_adapter_align_malloc
+    ,   tt_null
+    };
+    return &s_allocator;
+}
@@ -0,0 +1,132 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       small_allocator.h
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-05
+ * @brief      small_allocator.h file
+ */
+
+#ifndef TT_MEMORY_SMALL_ALLOCATOR_H
+#define TT_MEMORY_SMALL_ALLOCATOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the maximum size of the small data, the larger data is allocated by the libc
+#define TT_SMALL_ALLOCATOR_DATA_MAXN        (4096)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the small allocator, a global size-class allocator for 1 ~ 4096 bytes
+ *
+ * <pre>
+ * thread:  cache: |8|16|32|48| ... |4096|       the free items of each class, no lock
+ *                          |    ^
+ *                   refill |    | flush           one batch under the class lock
+ *                          v    |
+ * central: class: partial slab <-> slab <-> ...  the slabs which have free items
+ *
+ * region:  |slab|slab|slab| ... |               the reserved virtual memory, 64k slabs
+ * </pre>
+ *
+ * the slabs are carved from one reserved region, so the slab and class of
+ * the data are found by masking the address, and the data out of the region
+ * is passed to the libc, .e.g the large data or the data allocated by the libc.
+ *
+ * the data is always freed to the cache of the current thread, so freeing
+ * the data of other threads is as cheap as freeing the local data, and
+ * the cache is flushed to the central slabs if it is too large or the
+ * thread is exited.
+ *
+ * enable TT_CONFIG_SMALL_ALLOCATOR in prefix/config.h to make it be the
+ * backend of tt_malloc, tt_ralloc and tt_free.
+ *
+ * performance:
+ *
+ * malloc: O(1), lock-free if the cache is not empty
+ * free:   O(1), lock-free if the cache is not full
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! malloc data
+ *
+ * @param size          the size
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_small_allocator_malloc(tt_size_t size);
+
+/*! malloc data and fill zero
+ *
+ * @param size          the size
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_small_allocator_malloc0(tt_size_t size);
+
+/*! malloc data of the given item count and fill zero
+ *
+ * @param item          the item count
+ * @param size          the item size
+ *
+ * @return              the data
+ */
+tt_pointer_t            tt_small_allocator_nalloc0(tt_size_t item, tt_size_t size);
+
+/*! realloc data
+ *
+ * @param data          the data, malloc it if be tt_null
+ * @param size          the new size, free the data if be zero
+ *
+ * @return              the new data
+ */
+tt_pointer_t            tt_small_allocator_ralloc(tt_pointer_t data, tt_size_t size);
+
+/*! free data, the data may be allocated by other threads or the libc
+ *
+ * @param data          the data
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_small_allocator_free(tt_pointer_t data);
+
+/*! flush the cache of the current thread to the central slabs
+ *
+ * the cache is flushed automatically when the thread is exited
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_small_allocator_flush(tt_void_t);
+
+/*! the small allocator for the containers, .e.g tt_hash_map_init_with_allocator
+ *
+ * @return              the allocator
+ */
+tt_allocator_ref_t      tt_small_allocator(tt_void_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
@@ -0,0 +1,287 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       vmem.c
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-07
+ * @brief      vmem.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_MEMORY_VMEM"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+// for mmap, madvise and MAP_ANONYMOUS
+#define _DEFAULT_SOURCE
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "vmem.h"
+#include "../platform/port.h"
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the block head size, the data is aligned by 16 bytes
+#define TT_VMEM_BLOCK_HEAD_SIZE             tt_align(sizeof(tt_vmem_block_t), 16)
+
+// the block of the data
+#define tt_vmem_block(data)                 ((tt_vmem_block_t*)((tt_byte_t*)(data) - TT_VMEM_BLOCK_HEAD_SIZE))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the block head type, it is placed before the data
+typedef struct __tt_vmem_block_t
+{
+    // the native data or the reserved range
+    tt_pointer_t        base;
+
+    // the data size
+    tt_size_t           size;
+
+    // the reserved bytes, it is zero if the block is allocated by tt_malloc
+    tt_size_t           reserve;
+
+}tt_vmem_block_t;
+
+// the vmem allocator type
+typedef struct __tt_vmem_allocator_t
+{
+    // the allocator, @note must be the first field
+    tt_allocator_t      allocator;
+
+    // the reserved bytes of one large block
+    tt_size_t           reserve;
+
+}tt_vmem_allocator_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+// the committed bytes of the large block, the huge pages are committed as a whole
+static tt_size_t tt_vmem_allocator_commit_size(tt_size_t reserve, tt_size_t size)
+{
+    size += TT_VMEM_BLOCK_HEAD_SIZE;
+    size = size >= TT_VMEM_HUGE_PAGE_SIZE? tt_align(size, TT_VMEM_HUGE_PAGE_SIZE) : tt_align(size, tt_vmem_page_size());
+    return tt_min(size, reserve);
+}
+
+static tt_pointer_t tt_vmem_allocator_malloc(tt_allocator_ref_t allocator, tt_size_t size)
+{
+    tt_vmem_allocator_t* vmem = (tt_vmem_allocator_t*)allocator;
+    tt_assert_and_check_return_val(vmem, tt_null);
+
+    // the small block
+    tt_byte_t* base = tt_null;
+    if (size < TT_VMEM_ALLOCATOR_LARGE)
+    {
+        base = (tt_byte_t*)tt_malloc(TT_VMEM_BLOCK_HEAD_SIZE + size);
+        tt_check_return_val(base, tt_null);
+
+        tt_vmem_block_t* block = (tt_vmem_block_t*)base;
+        block->base    = base;
+        block->size    = size;
+        block->reserve = 0;
+        return base + TT_VMEM_BLOCK_HEAD_SIZE;
+    }
+
+    // the large block, reserve the whole range and commit the used pages
+    tt_check_return_val(size <= vmem->reserve - TT_VMEM_BLOCK_HEAD_SIZE, tt_null);
+    base = (tt_byte_t*)tt_vmem_reserve(vmem->reserve);
+    tt_check_return_val(base, tt_null);
+    if (!tt_vmem_commit(base, tt_vmem_allocator_commit_size(vmem->reserve, size)))
+    {
+        tt_vmem_release(base, vmem->reserve);
+        return tt_null;
+    }
+
+    tt_vmem_block_t* block = (tt_vmem_block_t*)base;
+    block->base    = base;
+    block->size    = size;
+    block->reserve = vmem->reserve;
+    return base + TT_VMEM_BLOCK_HEAD_SIZE;
+}
+
+static tt_void_t tt_vmem_allocator_free(tt_allocator_ref_t allocator, tt_pointer_t data)
+{
+    tt_check_return(data);
+
+    tt_vmem_block_t* block = tt_vmem_block(data);
+    if (block->reserve) tt_vmem_release(block->base, block->reserve);
+    else tt_free(block->base);
+}
+
+static tt_pointer_t tt_vmem_allocator_ralloc(tt_allocator_ref_t allocator, tt_pointer_t data, tt_size_t size)
+{
+    // malloc it
+    tt_check_return_val(data, tt_vmem_allocator_malloc(allocator, size));
+
+    // free it
+    if (!size)
+    {
+        tt_vmem_allocator_free(allocator, data);
+        return tt_null;
+    }
+
+    // the large block, commit or decommit the pages in place
+    tt_vmem_block_t* block = tt_vmem_block(data);
+    if (block->reserve)
+    {
+        tt_check_return_val(size <= block->reserve - TT_VMEM_BLOCK_HEAD_SIZE, tt_null);
+
+        tt_byte_t* base = (tt_byte_t*)block->base;
+        tt_size_t  ocommit = tt_vmem_allocator_commit_size(block->reserve, block->size);
+        tt_size_t  ncommit = tt_vmem_allocator_commit_size(block->reserve, size);
+        if (ncommit > ocommit && !tt_vmem_commit(base + ocommit, ncommit - ocommit)) return tt_null;
+        else if (ncommit < ocommit) tt_vmem_decommit(base + ncommit, ocommit - ncommit);
+
+        block->size = size;
+        return data;
+    }
+
+    // the small block
+    if (size < TT_VMEM_ALLOCATOR_LARGE && (tt_byte_t*)data == (tt_byte_t*)block->base + TT_VMEM_BLOCK_HEAD_SIZE)
+    {
+        tt_byte_t* base = (tt_byte_t*)tt_ralloc(block->base, TT_VMEM_BLOCK_HEAD_SIZE + size);
+        tt_check_return_val(base, tt_null);
+
+        block = (tt_vmem_block_t*)base;
+        block->base = base;
+        block->size = size;
+        return base + TT_VMEM_BLOCK_HEAD_SIZE;
+    }
+
+    // move it to the large block or the unaligned small block, it is copied only once
+    tt_pointer_t ndata = tt_vmem_allocator_malloc(allocator, size);
+    if (ndata)
+    {
+        tt_memcpy(ndata, data, tt_min(block->size, size));
+        tt_vmem_allocator_free(allocator, data);
+    }
+    return ndata;
+}
+
+static tt_pointer_t tt_vmem_allocator_align_malloc(tt_allocator_ref_t allocator, tt_size_t size, tt_size_t align)
+{
+    // the data is aligned by 16 bytes
+    if (align <= 16) return tt_vmem_allocator_malloc(allocator, size);
+
+    // the aligned block is always allocated by tt_malloc, the head is placed before the aligned data
+    tt_check_return_val(size <= (~(tt_size_t)0) - TT_VMEM_BLOCK_HEAD_SIZE - align, tt_null);
+    tt_byte_t* base = (tt_byte_t*)tt_malloc(TT_VMEM_BLOCK_HEAD_SIZE + size + align);
+    tt_check_return_val(base, tt_null);
+
+    tt_byte_t*       data  = (tt_byte_t*)tt_align(base + TT_VMEM_BLOCK_HEAD_SIZE, align);
+    tt_vmem_block_t* block = tt_vmem_block(data);
+    block->base    = base;
+    block->size    = size;
+    block->reserve = 0;
+    return data;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tt_size_t tt_vmem_page_size(tt_void_t)
+{
+    static tt_size_t s_page_size = 0;
+    if (!s_page_size)
+    {
+        tt_long_t page_size = sysconf(_SC_PAGESIZE);
+        s_page_size = page_size > 0? (tt_size_t)page_size : 4096;
+    }
+    return s_page_size;
+}
+
+tt_pointer_t tt_vmem_reserve(tt_size_t size)
+{
+    tt_size_t page_size = tt_vmem_page_size();
+    tt_assert_and_check_return_val(size && !(size & (page_size - 1)), tt_null);
+
+    // reserve more for aligning it by the huge page
+    tt_size_t align = size >= TT_VMEM_HUGE_PAGE_SIZE? TT_VMEM_HUGE_PAGE_SIZE : page_size;
+    tt_size_t maxn = size + align - page_size;
+    tt_check_return_val(maxn >= size, tt_null);
+
+    tt_byte_t* base = (tt_byte_t*)mmap(tt_null, maxn, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    tt_check_return_val(base != (tt_byte_t*)MAP_FAILED, tt_null);
+
+    // unmap the unaligned head and tail
+    tt_byte_t* data = (tt_byte_t*)tt_align(base, align);
+    if (data > base) munmap(base, data - base);
+    if (base + maxn > data + size) munmap(data + size, (base + maxn) - (data + size));
+
+#ifdef MADV_HUGEPAGE
+    // the transparent huge pages are used for the committed pages, it is only a hint
+    if (align == TT_VMEM_HUGE_PAGE_SIZE) madvise(data, size, MADV_HUGEPAGE);
+#endif
+    return data;
+}
+
+tt_bool_t tt_vmem_commit(tt_pointer_t data, tt_size_t size)
+{
+    tt_assert_and_check_return_val(data, tt_false);
+    return !mprotect(data, size, PROT_READ | PROT_WRITE);
+}
+
+tt_void_t tt_vmem_decommit(tt_pointer_t data, tt_size_t size)
+{
+    tt_assert_and_check_return(data);
+
+    // free the physical pages, they are zero if they are committed again
+    madvise(data, size, MADV_DONTNEED);
+    mprotect(data, size, PROT_NONE);
+}
+
+tt_void_t tt_vmem_release(tt_pointer_t data, tt_size_t size)
+{
+    tt_check_return(data && size);
+    munmap(data, size);
+}
+
+tt_vmem_allocator_ref_t tt_vmem_allocator_init(tt_size_t reserve)
+{
+    // the large block is aligned by the huge page if it is large enough
+    tt_size_t page_size = tt_vmem_page_size();
+    reserve = tt_max(reserve, TT_VMEM_ALLOCATOR_LARGE + TT_VMEM_BLOCK_HEAD_SIZE);
+    reserve = reserve >= TT_VMEM_HUGE_PAGE_SIZE? tt_align(reserve, TT_VMEM_HUGE_PAGE_SIZE) : tt_align(reserve, page_size);
+    tt_assert_and_check_return_val(reserve, tt_null);
+
+    tt_vmem_allocator_t* vmem = (tt_vmem_allocator_t*)tt_malloc0(sizeof(tt_vmem_allocator_t));
+    tt_assert_and_check_return_val(vmem, tt_null);
+
+    vmem->reserve                   = reserve;
+    vmem->allocator.malloc          = tt_vmem_allocator_malloc;
+    vmem->allocator.ralloc          = tt_vmem_allocator_ralloc;
+    vmem->allocator.free            = tt_vmem_allocator_free;
+    vmem->allocator.align_malloc    = tt_vmem_allocator_align_malloc;
+    vmem->allocator.priv            = vmem;
+    return (tt_vmem_allocator_ref_t)vmem;
+}
+
+tt_void_t tt_vmem_allocator_exit(tt_vmem_allocator_ref_t self)
+{
+    tt_vmem_allocator_t* vmem = (tt_vmem_allocator_t*)self;
+    tt_assert_and_check_return(vmem);
+
+    tt_free(vmem);
+}
+
+tt_allocator_ref_t tt_vmem_allocator(tt_vmem_allocator_ref_t self)
+{
+    tt_vmem_allocator_t* vmem = (tt_vmem_allocator_t*)self;
+    tt_assert_and_check_return_val(vmem, tt_null);
+
+    return &vmem->allocator;
+}
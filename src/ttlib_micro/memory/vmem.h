@@ -0,0 +1,155 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       vmem.h
+ * @ingroup    memory
+ * @author     tango
+ * @date       2021-08-07
+ * @brief      vmem.h file
+ */
+
+#ifndef TT_MEMORY_VMEM_H
+#define TT_MEMORY_VMEM_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the transparent huge page size, the reserved range is aligned by it if it is large enough
+#define TT_VMEM_HUGE_PAGE_SIZE              (2 << 20)
+
+/// the minimum block size of the vmem allocator, the smaller blocks are allocated by tt_malloc
+#define TT_VMEM_ALLOCATOR_LARGE             (65536)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the vmem allocator ref type
+ *
+ * <pre>
+ * block: |head|data ......... committed|       reserved, PROT_NONE        |
+ *                                      |-> commit when growing
+ *                                      |<- decommit when shrinking
+ * </pre>
+ *
+ * the large block reserves the whole virtual range at once and commits the
+ * pages as it grows, so ralloc never moves or copies it, .e.g the data of
+ * the large vector, and the range is advised for the transparent huge pages.
+ *
+ * @code
+ *
+ * tt_vmem_allocator_ref_t vmem = tt_vmem_allocator_init((tt_size_t)1 << 32);
+ * tt_vector_ref_t vector = tt_vector_init_with_allocator(0, tt_element_uint8(), tt_vmem_allocator(vmem));
+ *
+ * // ...
+ *
+ * tt_vector_exit(vector);
+ * tt_vmem_allocator_exit(vmem);
+ *
+ * @endcode
+ */
+typedef __tt_typeref__(vmem_allocator);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the page size
+ *
+ * @return              the page size
+ */
+tt_size_t               tt_vmem_page_size(tt_void_t);
+
+/*! reserve the virtual range without committing the pages
+ *
+ * the range is aligned by TT_VMEM_HUGE_PAGE_SIZE and advised by MADV_HUGEPAGE if the size >= TT_VMEM_HUGE_PAGE_SIZE
+ *
+ * @param size          the size, aligned by the page size
+ *
+ * @return              the range, tt_null if failed
+ */
+tt_pointer_t            tt_vmem_reserve(tt_size_t size);
+
+/*! commit the pages of the reserved range for reading and writing, the new pages are zero
+ *
+ * @code
+ *
+ * // the large data of the circular buffer
+ * tt_byte_t* data = (tt_byte_t*)tt_vmem_reserve(size);
+ * if (data && tt_vmem_commit(data, size)) tt_circular_buffer_init(&buffer, data, size);
+ *
+ * // ...
+ *
+ * tt_circular_buffer_exit(&buffer);
+ * tt_vmem_release(data, size);
+ *
+ * @endcode
+ *
+ * @param data          the data, aligned by the page size
+ * @param size          the size, aligned by the page size
+ *
+ * @return              tt_true or tt_false
+ */
+tt_bool_t               tt_vmem_commit(tt_pointer_t data, tt_size_t size);
+
+/*! decommit the pages, the range is still reserved
+ *
+ * @param data          the data, aligned by the page size
+ * @param size          the size, aligned by the page size
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vmem_decommit(tt_pointer_t data, tt_size_t size);
+
+/*! release the reserved range
+ *
+ * @param data          the range
+ * @param size          the reserved size
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vmem_release(tt_pointer_t data, tt_size_t size);
+
+/*! init the vmem allocator
+ *
+ * @param reserve       the reserved bytes of one large block, it limits the maximum block size
+ *
+ * @return              the vmem allocator
+ */
+tt_vmem_allocator_ref_t tt_vmem_allocator_init(tt_size_t reserve);
+
+/*! exit the vmem allocator, the blocks must be freed before exiting
+ *
+ * @param vmem          the vmem allocator
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_vmem_allocator_exit(tt_vmem_allocator_ref_t vmem);
+
+/*! the allocator for the containers, .e.g tt_vector_init_with_allocator
+ *
+ * @param vmem          the vmem allocator
+ *
+ * @return              the allocator
+ */
+tt_allocator_ref_t      tt_vmem_allocator(tt_vmem_allocator_ref_t vmem);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
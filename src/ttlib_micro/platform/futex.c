@@ -0,0 +1,83 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       futex.c
+ * @ingroup    platform
+ * @author     tango
+ * @date       2021-08-08
+ * @brief      futex.c file
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TT_TRACE_MODULE_NAME          "TTLIB_PLATFORM_FUTEX"
+#define TT_TRACE_MODULE_DEBUG         (1)
+
+// for syscall
+#define _DEFAULT_SOURCE
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "futex.h"
+#include "time.h"
+#include <errno.h>
+#include <limits.h>
+#ifdef __linux__
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#   include <time.h>
+#   include <unistd.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#if defined(__linux__) && defined(SYS_futex)
+tt_long_t tt_futex_wait(_Atomic tt_uint32_t* futex, tt_uint32_t value, tt_long_t timeout)
+{
+    tt_assert_and_check_return_val(futex, -1);
+
+    // the relative timeout
+    struct timespec t = {0};
+    if (timeout >= 0)
+    {
+        t.tv_sec  = timeout / 1000;
+        t.tv_nsec = timeout % 1000 * 1000000;
+    }
+
+    // wait
+    if (!syscall(SYS_futex, (tt_uint32_t*)futex, FUTEX_WAIT_PRIVATE, value, timeout >= 0? &t : tt_null, tt_null, 0)) return 1;
+
+    // the value is changed
+    if (errno == EAGAIN) return 1;
+
+    // timeout
+    if (errno == EINTR || errno == ETIMEDOUT) return 0;
+
+    // failed
+    return -1;
+}
+
+tt_void_t tt_futex_wake(_Atomic tt_uint32_t* futex, tt_size_t count)
+{
+    tt_assert_and_check_return(futex);
+
+    syscall(SYS_futex, (tt_uint32_t*)futex, FUTEX_WAKE_PRIVATE, (tt_int_t)tt_min(count, INT_MAX), tt_null, tt_null, 0);
+}
+#else
+tt_long_t tt_futex_wait(_Atomic tt_uint32_t* futex, tt_uint32_t value, tt_long_t timeout)
+{
+    tt_assert_and_check_return_val(futex, -1);
+
+    // poll it
+    if (timeout) tt_msleep(1);
+    return 1;
+}
+
+tt_void_t tt_futex_wake(_Atomic tt_uint32_t* futex, tt_size_t count)
+{
+}
+#endif
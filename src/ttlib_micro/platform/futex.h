@@ -0,0 +1,56 @@
+/*!The TT Library
+ *
+ * @Copyright (C) 2019-2021, TTLIB
+ *
+ * @file       futex.h
+ * @ingroup    platform
+ * @author     tango
+ * @date       2021-08-08
+ * @brief      futex.h file
+ */
+
+#ifndef TT_PLATFORM_FUTEX_H
+#define TT_PLATFORM_FUTEX_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! wait on the futex word while it is equal to the given value, it is process private
+ *
+ * it falls back to sleeping 1ms if the futex is not supported, so the caller
+ * must check its condition again after returning.
+ *
+ * @param futex         the futex word
+ * @param value         the expected value
+ * @param timeout       the timeout (ms), -1: infinity
+ *
+ * @return              woken or the value is changed: 1; timeout or interrupted: 0, failed: -1
+ */
+tt_long_t               tt_futex_wait(_Atomic tt_uint32_t* futex, tt_uint32_t value, tt_long_t timeout);
+
+/*! wake the waiters of the futex word
+ *
+ * @param futex         the futex word
+ * @param count         the maximum waiter count
+ *
+ * @return              tt_void_t
+ */
+tt_void_t               tt_futex_wake(_Atomic tt_uint32_t* futex, tt_size_t count);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tt_extern_c_leave__
+
+#endif
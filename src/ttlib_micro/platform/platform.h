@@ -16,6 +16,7 @@
 #include "mutex.h"
 #include "spinlock.h"
 #include "semaphore.h"
+#include "futex.h"
 #include "thread.h"
 #include "time.h"
 #include "port.h"
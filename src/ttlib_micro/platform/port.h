@@ -30,6 +30,7 @@
 #define tt_memcpy(dst, src, size)           memcpy(dst, src, size)
 #define tt_memset(dst, data, size)          memset(dst, data, size)
 #define tt_memmov(dst, data, size)          memmove(dst, data, size)
+#define tt_memcmp(dst, data, size)          memcmp(dst, data, size)
 
 // string interface
 #define tt_stricmp(dst_str, src_str)        strcasecmp(dst_str, src_str)
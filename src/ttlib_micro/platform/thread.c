@@ -33,6 +33,9 @@ typedef struct __tt_thread_t
 
     // is joined?
     tt_bool_t   is_joined;
+
+    // the allocator
+    tt_allocator_ref_t  allocator;
 }tt_thread_t;
 
 // the return val type of thread 
@@ -61,7 +64,7 @@ static tt_thread_retval_t tt_thread_func(tt_pointer_t priv)
         tt_cpointer_t priv = (tt_cpointer_t)args[1].ptr;
 
         // free the args before call func
-        if(args) tt_free(args);
+        if(args) tt_allocator_free((tt_allocator_ref_t)args[2].ptr, args);
         args = tt_null;
 
         // call the thread function
@@ -81,6 +84,11 @@ static tt_thread_retval_t tt_thread_func(tt_pointer_t priv)
  * implementation
  */
 tt_thread_ref_t tt_thread_init(tt_char_t const* name, tt_thread_func_t func, tt_cpointer_t priv, tt_size_t stack) 
+{
+    return tt_thread_init_with_allocator(name, func, priv, stack, tt_null);
+}
+
+tt_thread_ref_t tt_thread_init_with_allocator(tt_char_t const* name, tt_thread_func_t func, tt_cpointer_t priv, tt_size_t stack, tt_allocator_ref_t allocator)
 {
     // check 
     tt_assert_and_check_return_val(func, tt_null);
@@ -93,8 +101,9 @@ tt_thread_ref_t tt_thread_init(tt_char_t const* name, tt_thread_func_t func, tt_
     do
     {
         // init thread
-        thread = (tt_thread_t *)tt_malloc0(sizeof(tt_thread_t));
+        thread = (tt_thread_t *)tt_allocator_malloc0(allocator, sizeof(tt_thread_t));
         tt_assert_and_check_break(thread);
+        thread->allocator = allocator;
 
         // init attr
         if(stack)
@@ -104,12 +113,13 @@ tt_thread_ref_t tt_thread_init(tt_char_t const* name, tt_thread_func_t func, tt_
         }
 
         // init arguments
-        args = (tt_value_ref_t)tt_malloc0(2 * sizeof(tt_value_t));
+        args = (tt_value_ref_t)tt_allocator_malloc0(allocator, 3 * sizeof(tt_value_t));
         tt_assert_and_check_break(args);
 
-        // save function and private data
+        // save function, private data and allocator
         args[0].ptr = (tt_pointer_t)func;
         args[1].ptr = (tt_pointer_t)priv;
+        args[2].ptr = (tt_pointer_t)allocator;
 
         // init pthread
         if (pthread_create(&thread->pthread, stack? &attr : tt_null, tt_thread_func, args)) break;
@@ -127,11 +137,11 @@ tt_thread_ref_t tt_thread_init(tt_char_t const* name, tt_thread_func_t func, tt_
     {
         tt_trace_d("thread init failed");
         // exit arguments
-        if(args) tt_free(args);
+        if(args) tt_allocator_free(allocator, args);
         args = tt_null;
 
         // exit thread
-        if(thread) tt_free(thread);
+        if(thread) tt_allocator_free(allocator, thread);
         thread = tt_null;
     }
 
@@ -150,7 +160,7 @@ tt_void_t tt_thread_exit(tt_thread_ref_t self)
     if(!thread->is_joined) pthread_detach(thread->pthread);
 
     //free thread 
-    tt_free(thread);
+    tt_allocator_free(thread->allocator, thread);
 }
 
 tt_long_t tt_thread_wait(tt_thread_ref_t self, tt_long_t timeout, tt_int_t* retval)
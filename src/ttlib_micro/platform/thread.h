@@ -13,6 +13,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../memory/allocator.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -46,6 +47,18 @@ typedef tt_int_t        (*tt_thread_func_t)(tt_cpointer_t priv);
  */
 tt_thread_ref_t         tt_thread_init(tt_char_t const* name, tt_thread_func_t func, tt_cpointer_t priv, tt_size_t stack);
 
+/*! init thread with the allocator
+ *
+ * @param name          thread name, may be null
+ * @param func          thread function
+ * @param priv          thread priv data
+ * @param stack         thread priv stack, using the fault size if be zero
+ * @param allocator     the allocator of the thread handle and arguments, using the native allocator if be tt_null
+ *
+ * @return              the thread handle
+ */
+tt_thread_ref_t         tt_thread_init_with_allocator(tt_char_t const* name, tt_thread_func_t func, tt_cpointer_t priv, tt_size_t stack, tt_allocator_ref_t allocator);
+
 /*! exit thread
  *
  * @param thread        the thread handle
@@ -32,5 +32,11 @@
 //#define TT_WORD_BIGENDIAN
 #define TT_WORD_LITTLEENDIAN
 
+/// use the small allocator as the tt_malloc backend, see memory/small_allocator.h
+//#define TT_CONFIG_SMALL_ALLOCATOR
+
+/// trace the call sites of tt_malloc and report the leaks at tt_lib_exit, see memory/malloc_trace.h
+//#define TT_CONFIG_MALLOC_TRACE
+
 
 #endif
\ No newline at end of file
@@ -44,5 +44,8 @@
 #   define TT_CPU_BITBYTE      4
 #endif
 
+// the cache line size
+#define TT_CPU_CACHELINE        (64)
+
 #endif
 
@@ -51,9 +51,11 @@
 #if defined(TT_COMPILER_IS_GCC)
 #   define __tt_inline__                        __inline__
 #   define __tt_aligned__(a)                    __attribute__((aligned(a)))
+#   define __tt_thread_local__                  __thread
 #elif defined(TT_COMPILER_IS_MSVC)
 #   define __tt_inline__                        __inline
 #   define __tt_aligned__(a)                    __declspec(align(a))
+#   define __tt_thread_local__                  __declspec(thread)
 #endif
 
 /// dummy typdef
@@ -20,11 +20,67 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#define tt_malloc(size)                         malloc(size)
-#define tt_malloc0(size)                        calloc(1, size)
-#define tt_nalloc(item, size)                   calloc(item, size)
-#define tt_nalloc0(item, size)                  calloc(item, size)
-#define tt_ralloc(data, size)                   realloc(data, size)
-#define tt_free(data)                           free(data) 
+#if defined(TT_CONFIG_MALLOC_TRACE)
+#   define tt_malloc(size)                      tt_malloc_trace_malloc(size, __tt_file__, __tt_line__)
+#   define tt_malloc0(size)                     tt_malloc_trace_malloc0(size, __tt_file__, __tt_line__)
+#   define tt_nalloc(item, size)                tt_malloc_trace_nalloc0(item, size, __tt_file__, __tt_line__)
+#   define tt_nalloc0(item, size)               tt_malloc_trace_nalloc0(item, size, __tt_file__, __tt_line__)
+#   define tt_ralloc(data, size)                tt_malloc_trace_ralloc(data, size, __tt_file__, __tt_line__)
+#   define tt_free(data)                        tt_malloc_trace_free(data)
+#elif defined(TT_CONFIG_SMALL_ALLOCATOR)
+#   define tt_malloc(size)                      tt_small_allocator_malloc(size)
+#   define tt_malloc0(size)                     tt_small_allocator_malloc0(size)
+#   define tt_nalloc(item, size)                tt_small_allocator_nalloc0(item, size)
+#   define tt_nalloc0(item, size)               tt_small_allocator_nalloc0(item, size)
+#   define tt_ralloc(data, size)                tt_small_allocator_ralloc(data, size)
+#   define tt_free(data)                        tt_small_allocator_free(data)
+#else
+#   define tt_malloc(size)                      malloc(size)
+#   define tt_malloc0(size)                     calloc(1, size)
+#   define tt_nalloc(item, size)                calloc(item, size)
+#   define tt_nalloc0(item, size)               calloc(item, size)
+#   define tt_ralloc(data, size)                realloc(data, size)
+#   define tt_free(data)                        free(data) 
+#endif
+
+/// the call site arguments of the wrapped allocation functions, be empty if the malloc trace is disabled
+#ifdef TT_CONFIG_MALLOC_TRACE
+#   define __tt_malloc_trace_decl__             , tt_char_t const* file_, tt_size_t line_
+#   define __tt_malloc_trace_args__             , file_, line_
+#   define __tt_malloc_trace_val__              , __tt_file__, __tt_line__
+#else
+#   define __tt_malloc_trace_decl__
+#   define __tt_malloc_trace_args__
+#   define __tt_malloc_trace_val__
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+#ifdef TT_CONFIG_SMALL_ALLOCATOR
+__tt_extern_c_enter__
+
+// the small allocator backend, see memory/small_allocator.h
+tt_pointer_t            tt_small_allocator_malloc(tt_size_t size);
+tt_pointer_t            tt_small_allocator_malloc0(tt_size_t size);
+tt_pointer_t            tt_small_allocator_nalloc0(tt_size_t item, tt_size_t size);
+tt_pointer_t            tt_small_allocator_ralloc(tt_pointer_t data, tt_size_t size);
+tt_void_t               tt_small_allocator_free(tt_pointer_t data);
+
+__tt_extern_c_leave__
+#endif
+
+#ifdef TT_CONFIG_MALLOC_TRACE
+__tt_extern_c_enter__
+
+// the malloc trace, see memory/malloc_trace.h
+tt_pointer_t            tt_malloc_trace_malloc(tt_size_t size, tt_char_t const* file, tt_size_t line);
+tt_pointer_t            tt_malloc_trace_malloc0(tt_size_t size, tt_char_t const* file, tt_size_t line);
+tt_pointer_t            tt_malloc_trace_nalloc0(tt_size_t item, tt_size_t size, tt_char_t const* file, tt_size_t line);
+tt_pointer_t            tt_malloc_trace_ralloc(tt_pointer_t data, tt_size_t size, tt_char_t const* file, tt_size_t line);
+tt_void_t               tt_malloc_trace_free(tt_pointer_t data);
+
+__tt_extern_c_leave__
+#endif
 
 #endif
\ No newline at end of file
@@ -68,6 +68,11 @@ tt_bool_t tt_lib_init(tt_handle_t priv)
 
 tt_void_t tt_lib_exit(tt_void_t)
 {
+#ifdef TT_CONFIG_MALLOC_TRACE
+	/// report the allocation sites and the leaks
+	tt_malloc_trace_dump();
+#endif
+
 	/// trace
 	tt_trace_exit();
 }
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include "buffer/buffer.h"
 #include "container/container.h"
 #include "container/iterator.h"
+#include "memory/memory.h"
 #include "algorithm/algorithm.h"
 #include "utils/utils.h"
 #include "platform/platform.h"
@@ -95,6 +95,44 @@ static __tt_inline__ tt_size_t tt_bits_cl0_u64_le_inline(tt_uint64_t x)
 #   define tt_bits_fb0_le(x)   tt_bits_cl0_u64_le_inline(x)
 #endif
 
+// the count of the trailing zero bits, using the bsf/tzcnt instruction if be supported
+static __tt_inline__ tt_size_t tt_bits_cl0_u64_le(tt_uint64_t x)
+{
+#ifdef TT_COMPILER_IS_GCC
+    tt_check_return_val(x, 64);
+    return (tt_size_t)__builtin_ctzll(x);
+#else
+    return tt_bits_cl0_u64_le_inline(x);
+#endif
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * cb1
+ */
+static __tt_inline__ tt_size_t tt_bits_cb1_u32_inline(tt_uint32_t x)
+{
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    x = (x + (x >> 4)) & 0x0f0f0f0f;
+    return (tt_size_t)((x * 0x01010101) >> 24);
+}
+static __tt_inline__ tt_size_t tt_bits_cb1_u64_inline(tt_uint64_t x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (tt_size_t)((x * 0x0101010101010101ULL) >> 56);
+}
+
+// the count of the one bits, using the popcnt instruction if be supported
+#ifdef TT_COMPILER_IS_GCC
+#   define tt_bits_cb1_u32(x)   ((tt_size_t)__builtin_popcount((tt_uint32_t)(x)))
+#   define tt_bits_cb1_u64(x)   ((tt_size_t)__builtin_popcountll((tt_uint64_t)(x)))
+#else
+#   define tt_bits_cb1_u32(x)   tt_bits_cb1_u32_inline((tt_uint32_t)(x))
+#   define tt_bits_cb1_u64(x)   tt_bits_cb1_u64_inline((tt_uint64_t)(x))
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * swap
  */